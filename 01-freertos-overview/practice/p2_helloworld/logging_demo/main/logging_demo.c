@@ -7,6 +7,15 @@
 #include "nvs_flash.h"
 #include "esp_chip_info.h"         // ESP-IDF v5+
 #include "esp_flash.h"             // esp_flash_get_size()
+#include "esp_cpu.h"               // esp_cpu_get_cycle_count()
+
+// Compile-time level of this file for the MLOGx macros: DEBUG is built in
+// (and still follows esp_log_level_set), VERBOSE is removed entirely
+#define LOG_MODULE_LEVEL ESP_LOG_DEBUG
+#include "log_limit.h"
+
+#define LOG_BENCH_CALLS     1000
+#define LOG_BENCH_TAG       "BENCH"
 
 // Define tag for logging
 static const char *TAG = "LOGGING_DEMO";
@@ -37,6 +46,79 @@ void demonstrate_formatted_logging(void)
     ESP_LOG_BUFFER_HEX(TAG, data, sizeof(data));
 }
 
+// ---------- Module level and rate limiting ----------
+void demonstrate_module_logging(void)
+{
+    MLOGI(TAG, "MLOGI: compiled in (module level %d)", LOG_MODULE_LEVEL);
+    MLOGD(TAG, "MLOGD: compiled in, shown because the tag is at DEBUG");
+    MLOGV(TAG, "MLOGV: removed at compile time, never reaches esp_log");
+}
+
+void demonstrate_rate_limiting(void)
+{
+    // A noisy loop: 50 samples in about a second, at most 5/s with a burst of
+    // 3, then one more after a pause that reports what was suppressed
+    for (int i = 0; i <= 50; i++) {
+        vTaskDelay(pdMS_TO_TICKS(i < 50 ? 20 : 1000));
+        MLOGI_RATE(TAG, 5, 3, "Heartbeat sample %d", i);
+    }
+    ESP_LOGI(TAG, "Suppressed so far: %lu", (unsigned long)log_limit_total_suppressed());
+}
+
+// Cycles per call that prints nothing. The argument stands for real work
+// (a heap walk) that a filtered ESP_LOGx still evaluates.
+static uint32_t bench_cycles(void (*body)(void))
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    body();
+    return (esp_cpu_get_cycle_count() - start) / LOG_BENCH_CALLS;
+}
+
+static void bench_empty(void)
+{
+    for (int i = 0; i < LOG_BENCH_CALLS; i++) {
+        __asm__ volatile("" ::: "memory");
+    }
+}
+
+static void bench_runtime_filtered(void)
+{
+    for (int i = 0; i < LOG_BENCH_CALLS; i++) {
+        ESP_LOGI(LOG_BENCH_TAG, "heap %" PRIu32, (uint32_t)esp_get_free_heap_size());
+    }
+}
+
+static void bench_compile_filtered(void)
+{
+    for (int i = 0; i < LOG_BENCH_CALLS; i++) {
+        MLOGV(LOG_BENCH_TAG, "heap %" PRIu32, (uint32_t)esp_get_free_heap_size());
+    }
+}
+
+static void bench_rate_limited(void)
+{
+    for (int i = 0; i < LOG_BENCH_CALLS; i++) {
+        // The first call passes but the tag is silenced; the rest are suppressed
+        MLOGI_RATE(LOG_BENCH_TAG, 1, 1, "heap %" PRIu32, (uint32_t)esp_get_free_heap_size());
+    }
+}
+
+void benchmark_filtered_logging(void)
+{
+    esp_log_level_set(LOG_BENCH_TAG, ESP_LOG_WARN);
+
+    uint32_t loop = bench_cycles(bench_empty);
+    uint32_t runtime = bench_cycles(bench_runtime_filtered);
+    uint32_t compiled = bench_cycles(bench_compile_filtered);
+    uint32_t limited = bench_cycles(bench_rate_limited);
+
+    ESP_LOGI(TAG, "Cycles per filtered call (%d calls, loop overhead %" PRIu32 " removed):",
+             LOG_BENCH_CALLS, loop);
+    ESP_LOGI(TAG, "  ESP_LOGI, tag level WARN:    %" PRIu32, runtime - loop);
+    ESP_LOGI(TAG, "  MLOGV, below module level:   %" PRIu32, compiled - loop);
+    ESP_LOGI(TAG, "  MLOGI_RATE, bucket empty:    %" PRIu32, limited - loop);
+}
+
 void demonstrate_conditional_logging(void)
 {
     int error_code = 0;
@@ -105,6 +187,12 @@ void app_main(void)
     ESP_LOGI(TAG, "\n--- Conditional Logging Demo ---");
     demonstrate_conditional_logging();
 
+    // Compile-time module level and per-call-site rate limiting
+    ESP_LOGI(TAG, "\n--- Module Level / Rate Limit Demo ---");
+    demonstrate_module_logging();
+    demonstrate_rate_limiting();
+    benchmark_filtered_logging();
+
     // Main loop with counter
     int counter = 0;
     while (1) {
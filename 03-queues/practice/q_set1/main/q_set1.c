@@ -1,16 +1,107 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "spsc_ring.h"
+#include "mpmc_queue.h"
+#include "telemetry_queue.h"
+#include "msg_ring.h"
+#include "deferred_log.h"
 
 static const char *TAG = "QUEUE_SETS";
 
+// Zero-copy network path: network_task fills a block taken from network_pool
+// and enqueues only its pointer; processor_task handles it in place and
+// returns the block. 0 = copy the whole network_message_t through the queue
+#define NETWORK_ZERO_COPY       1
+#define NETWORK_QUEUE_LEN       8
+#define NETWORK_POOL_BLOCKS     (NETWORK_QUEUE_LEN + 2)   // + one in flight at each end
+
+// Variable-length network records: with NETWORK_ZERO_COPY, blocks come from a
+// length-prefixed byte ring instead of network_pool, and each holds only the
+// strings it needs rather than a full network_message_t
+#define NETWORK_VARLEN          1
+#define NETWORK_RING_BYTES      512     // power of two
+
+#if NETWORK_VARLEN && !NETWORK_ZERO_COPY
+#error "NETWORK_VARLEN carves the zero-copy blocks, enable NETWORK_ZERO_COPY"
+#endif
+
+// Copy vs zero-copy throughput benchmark, run once before the demo starts
+#define RUN_QUEUE_BENCHMARK     1
+#define BENCH_DURATION_MS       2000
+#define BENCH_QUEUE_LEN         NETWORK_QUEUE_LEN
+#define BENCH_MUX_EVENTS        4000
+
+// Multiplexed event channel: one queue of tagged events (type + length +
+// payload) replaces the three queues, the semaphore and the queue set.
+// 0 = classic xQueueSelectFromSet processor
+#define USE_EVENT_CHANNEL       1
+#define EVENT_CHANNEL_LEN       (5 + 3 + NETWORK_QUEUE_LEN + 1)
+
+// Event channel as a lock-free MPMC queue (per-slot sequence numbers) so the
+// four producers do not serialise on the queue's critical section. With
+// USE_PRIORITY_DISPATCH the queue-backed lanes become MPMC queues instead,
+// each rounded up to a power-of-two depth. 0 = FreeRTOS queues
+#define EVENT_CHANNEL_MPMC      1
+#define EVENT_CHANNEL_MPMC_LEN  32      // power of two >= EVENT_CHANNEL_LEN
+#define LANE_MPMC_MAX_LEN       8       // power of two >= the deepest lane
+
+// Priority-aware dispatch (needs USE_EVENT_CHANNEL): one lane per priority
+// class, served in dispatch_lanes[] order. Network messages at or above
+// NETWORK_URGENT_PRIORITY ride the urgent lane, the rest the network lane.
+// A non-empty lane passed over DISPATCH_STARVATION_LIMIT times is served next.
+#define USE_PRIORITY_DISPATCH       1
+#define NETWORK_URGENT_PRIORITY     4
+#define DISPATCH_STARVATION_LIMIT   8
+#define LATENCY_BUCKETS             96      // 4 sub-buckets per power of two, up to ~8 s
+
+// Batch processing: each wakeup drains up to BATCH_MAX_PER_MEMBER items from
+// every ready member (per lane in priority mode) and stops early once
+// BATCH_BUDGET_US is spent. 0 = one event per wakeup plus the 200 ms delay
+#define PROCESSOR_BATCH_MODE        1
+#define BATCH_MAX_PER_MEMBER        8
+#define BATCH_BUDGET_US             20000
+#define BATCH_HIST_BUCKETS          6
+
+// Sensor lane as a lock-free SPSC ring (sensor_task → processor_task only):
+// no critical section per event, and the processor is notified only when the
+// ring goes from empty to non-empty. Sends never block; a full ring drops.
+#define SENSOR_SPSC_RING            1
+#define SENSOR_RING_LEN             8       // power of two
+
+// Deferred logging in the event handlers: they store raw records that a
+// low-priority task formats and prints later. 0 = format in place (ESP_LOGx)
+#define USE_DEFERRED_LOG            1
+#define DEFERRED_LOG_PRIORITY       1
+
+#if USE_DEFERRED_LOG
+#define HOT_LOGI DLOGI
+#define HOT_LOGW DLOGW
+#else
+#define HOT_LOGI ESP_LOGI
+#define HOT_LOGW ESP_LOGW
+#endif
+
+#if USE_PRIORITY_DISPATCH && !USE_EVENT_CHANNEL
+#error "USE_PRIORITY_DISPATCH carries event_t items and needs USE_EVENT_CHANNEL"
+#endif
+#if USE_PRIORITY_DISPATCH && EVENT_CHANNEL_MPMC && NETWORK_QUEUE_LEN > LANE_MPMC_MAX_LEN
+#error "LANE_MPMC_MAX_LEN must cover NETWORK_QUEUE_LEN"
+#endif
+#if SENSOR_SPSC_RING && !USE_PRIORITY_DISPATCH
+#error "SENSOR_SPSC_RING replaces a dispatch lane and needs USE_PRIORITY_DISPATCH"
+#endif
+
 // LED indicators
 #define LED_SENSOR GPIO_NUM_2
 #define LED_USER GPIO_NUM_4
@@ -27,6 +118,12 @@ SemaphoreHandle_t xTimerSemaphore;
 // Queue Set handle
 QueueSetHandle_t xQueueSet;
 
+// Multiplexed event channel handle
+#if !EVENT_CHANNEL_MPMC
+QueueHandle_t xEventChannel;
+#endif
+TaskHandle_t processor_task_handle;
+
 // Data structures for different message types
 typedef struct {
     int sensor_id;
@@ -47,14 +144,98 @@ typedef struct {
     int priority;
 } network_message_t;
 
+// Variable-length network record: source and message back to back, each
+// NUL-terminated, sized to the text actually sent
+typedef struct {
+    uint8_t priority;
+    uint8_t source_len;         // without the NUL
+    uint16_t message_len;
+    char text[];                // source "\0" message "\0"
+} network_record_t;
+
+#if NETWORK_VARLEN
+typedef network_record_t network_block_t;
+#else
+typedef network_message_t network_block_t;
+#endif
+
+// Fixed-size block pool for network messages (free list of block pointers)
+typedef struct {
+    network_message_t blocks[NETWORK_POOL_BLOCKS];
+    network_message_t* free_list[NETWORK_POOL_BLOCKS];
+    uint32_t free_count;
+    uint32_t min_free;
+    uint32_t exhausted;
+    portMUX_TYPE lock;
+} message_pool_t;
+
 // Message type identifier
 typedef enum {
     MSG_SENSOR,
     MSG_USER,
     MSG_NETWORK,
-    MSG_TIMER
+    MSG_TIMER,
+    MSG_TYPE_COUNT
 } message_type_t;
 
+// Event channel item: small header followed by the payload of any type.
+// With NETWORK_ZERO_COPY the network payload is only the block pointer,
+// which keeps every item at the size of the largest small message.
+typedef struct {
+    uint8_t type;               // message_type_t
+    uint8_t reserved;
+    uint16_t length;            // payload bytes in use
+    uint32_t enqueued_us;       // low 32 bits of esp_timer at post time
+    union {
+        sensor_data_t sensor;
+        user_input_t user;
+#if NETWORK_ZERO_COPY
+        network_block_t* network_block;
+#else
+        network_message_t network;
+#endif
+    } payload;
+} event_t;
+
+typedef void (*event_handler_t)(const void* payload);
+
+// Dispatch lanes, listed in service order (first = highest class)
+typedef enum {
+    LANE_URGENT,                // network, priority >= NETWORK_URGENT_PRIORITY
+    LANE_USER,
+    LANE_NETWORK,
+    LANE_SENSOR,
+    LANE_TIMER,
+    LANE_COUNT
+} dispatch_lane_id_t;
+
+typedef struct {
+    const char* name;
+    uint8_t depth;
+#if EVENT_CHANNEL_MPMC
+    mpmc_queue_t* queue;
+#else
+    QueueHandle_t queue;
+#endif
+    spsc_ring_t* ring;          // used instead of queue when set
+    uint32_t passed_over;       // dispatch decisions skipped while non-empty
+    uint32_t dispatched;
+    uint32_t forced;            // served by starvation protection
+    uint32_t latency_hist[LATENCY_BUCKETS];   // post → dequeue, microseconds
+    // Posts, failures by cause, high-water mark and latency in the
+    // telemetry_queue format; read with dispatch_lane_snapshot()
+    telemetry_counters_t telemetry;
+} dispatch_lane_t;
+
+// Batch statistics (written by processor_task only)
+typedef struct {
+    uint32_t batches;
+    uint32_t events;
+    uint32_t budget_stops;      // batches cut short by BATCH_BUDGET_US
+    uint32_t empty_wakeups;     // woke up but found nothing to do
+    uint32_t size_hist[BATCH_HIST_BUCKETS];
+} batch_stats_t;
+
 // Statistics
 typedef struct {
     uint32_t sensor_count;
@@ -64,6 +245,294 @@ typedef struct {
 } message_stats_t;
 
 message_stats_t stats = {0, 0, 0, 0};
+batch_stats_t batch_stats = {0};
+
+#if NETWORK_VARLEN
+static msg_ring_t network_ring;
+static uint8_t network_ring_storage[NETWORK_RING_BYTES] __attribute__((aligned(4)));
+#define NETWORK_QUEUE_ITEM_SIZE sizeof(network_block_t*)
+#elif NETWORK_ZERO_COPY
+static message_pool_t network_pool;
+#define NETWORK_QUEUE_ITEM_SIZE sizeof(network_block_t*)
+#else
+#define NETWORK_QUEUE_ITEM_SIZE sizeof(network_message_t)
+#endif
+
+#if EVENT_CHANNEL_MPMC && !USE_PRIORITY_DISPATCH
+static mpmc_queue_t event_channel;
+static uint8_t event_channel_storage[MPMC_QUEUE_STORAGE_SIZE(EVENT_CHANNEL_MPMC_LEN, sizeof(event_t))]
+    __attribute__((aligned(4)));
+#elif !USE_PRIORITY_DISPATCH
+// Instrumented channel: depth high-water mark, failed posts by cause and
+// post → dequeue latency, stamped into event_t.enqueued_us
+static telemetry_queue_t event_tq;
+#endif
+
+// ================ MESSAGE POOL ================
+void message_pool_init(message_pool_t* pool) {
+    for (int i = 0; i < NETWORK_POOL_BLOCKS; i++) {
+        pool->free_list[i] = &pool->blocks[i];
+    }
+    pool->free_count = NETWORK_POOL_BLOCKS;
+    pool->min_free = NETWORK_POOL_BLOCKS;
+    pool->exhausted = 0;
+    portMUX_INITIALIZE(&pool->lock);
+}
+
+// Non-blocking: NULL means every block is queued or in flight
+network_message_t* message_pool_alloc(message_pool_t* pool) {
+    network_message_t* msg = NULL;
+
+    portENTER_CRITICAL(&pool->lock);
+    if (pool->free_count > 0) {
+        msg = pool->free_list[--pool->free_count];
+        if (pool->free_count < pool->min_free) {
+            pool->min_free = pool->free_count;
+        }
+    } else {
+        pool->exhausted++;
+    }
+    portEXIT_CRITICAL(&pool->lock);
+
+    return msg;
+}
+
+void message_pool_free(message_pool_t* pool, network_message_t* msg) {
+    portENTER_CRITICAL(&pool->lock);
+    pool->free_list[pool->free_count++] = msg;
+    portEXIT_CRITICAL(&pool->lock);
+}
+
+#if USE_PRIORITY_DISPATCH
+static dispatch_lane_t dispatch_lanes[LANE_COUNT] = {
+    [LANE_URGENT]  = { .name = "Urgent",  .depth = NETWORK_QUEUE_LEN },
+    [LANE_USER]    = { .name = "User",    .depth = 3 },
+    [LANE_NETWORK] = { .name = "Network", .depth = NETWORK_QUEUE_LEN },
+#if SENSOR_SPSC_RING
+    [LANE_SENSOR]  = { .name = "Sensor",  .depth = SENSOR_RING_LEN },
+#else
+    [LANE_SENSOR]  = { .name = "Sensor",  .depth = 5 },
+#endif
+    [LANE_TIMER]   = { .name = "Timer",   .depth = 1 },
+};
+
+// Message type → lane; network traffic is split by message priority below
+static const dispatch_lane_id_t lane_of_type[MSG_TYPE_COUNT] = {
+    [MSG_SENSOR]  = LANE_SENSOR,
+    [MSG_USER]    = LANE_USER,
+    [MSG_NETWORK] = LANE_NETWORK,
+    [MSG_TIMER]   = LANE_TIMER,
+};
+
+#if SENSOR_SPSC_RING
+static spsc_ring_t sensor_ring;
+static event_t sensor_ring_storage[SENSOR_RING_LEN];
+#endif
+
+#if EVENT_CHANNEL_MPMC
+static mpmc_queue_t lane_mpmc[LANE_COUNT];
+static uint8_t lane_mpmc_storage[LANE_COUNT][MPMC_QUEUE_STORAGE_SIZE(LANE_MPMC_MAX_LEN, sizeof(event_t))]
+    __attribute__((aligned(4)));
+#endif
+
+// Queue-backed lanes: FreeRTOS queue, or MPMC queue with EVENT_CHANNEL_MPMC
+static bool lane_queue_send(dispatch_lane_t* lane, const event_t* event, TickType_t wait) {
+#if EVENT_CHANNEL_MPMC
+    return mpmc_queue_send(lane->queue, event, wait);
+#else
+    return xQueueSend(lane->queue, event, wait) == pdPASS;
+#endif
+}
+
+static bool lane_queue_receive(dispatch_lane_t* lane, event_t* event) {
+#if EVENT_CHANNEL_MPMC
+    return mpmc_queue_try_receive(lane->queue, event);
+#else
+    return xQueueReceive(lane->queue, event, 0) == pdPASS;
+#endif
+}
+
+static UBaseType_t lane_waiting(dispatch_lane_t* lane) {
+    if (lane->ring != NULL) {
+        return spsc_ring_count(lane->ring);
+    }
+#if EVENT_CHANNEL_MPMC
+    return mpmc_queue_count(lane->queue);
+#else
+    return uxQueueMessagesWaiting(lane->queue);
+#endif
+}
+#endif
+
+// ================ EVENT CHANNEL ================
+// Copy the payload behind a header; one xQueueSend per event of any type
+BaseType_t post_event(message_type_t type, const void* payload, uint16_t length,
+                      TickType_t wait) {
+    event_t event;
+
+    event.type = (uint8_t)type;
+    event.reserved = 0;
+    event.length = length;
+    event.enqueued_us = (uint32_t)esp_timer_get_time();
+    if (length > 0) {
+        memcpy(&event.payload, payload, length);
+    }
+
+#if USE_PRIORITY_DISPATCH
+    dispatch_lane_id_t lane = lane_of_type[type];
+    if (type == MSG_NETWORK) {
+#if NETWORK_ZERO_COPY
+        int priority = event.payload.network_block->priority;
+#else
+        int priority = event.payload.network.priority;
+#endif
+        if (priority >= NETWORK_URGENT_PRIORITY) {
+            lane = LANE_URGENT;
+        }
+    }
+
+    if (dispatch_lanes[lane].ring != NULL) {
+        // Single producer; the ring wakes the processor itself, and only
+        // on the empty → non-empty edge
+        if (!spsc_ring_send(dispatch_lanes[lane].ring, &event)) {
+            telemetry_record_failed(&dispatch_lanes[lane].telemetry, TELEMETRY_FAIL_FULL);
+            return pdFAIL;
+        }
+        telemetry_record_sent(&dispatch_lanes[lane].telemetry,
+                              spsc_ring_count(dispatch_lanes[lane].ring));
+        return pdPASS;
+    }
+
+    if (!lane_queue_send(&dispatch_lanes[lane], &event, wait)) {
+        telemetry_record_failed(&dispatch_lanes[lane].telemetry,
+                                wait == 0 ? TELEMETRY_FAIL_FULL : TELEMETRY_FAIL_TIMEOUT);
+        return pdFAIL;
+    }
+    telemetry_record_sent(&dispatch_lanes[lane].telemetry, lane_waiting(&dispatch_lanes[lane]));
+    if (processor_task_handle != NULL) {
+        xTaskNotifyGive(processor_task_handle);
+    }
+    return pdPASS;
+#elif EVENT_CHANNEL_MPMC
+    return mpmc_queue_send(&event_channel, &event, wait) ? pdPASS : pdFAIL;
+#else
+    return telemetry_queue_send(&event_tq, &event, wait);
+#endif
+}
+
+#if USE_PRIORITY_DISPATCH
+// ================ PRIORITY DISPATCH ================
+// Log-linear histogram: values below 4 map 1:1, above that each power of two
+// is split into 4 sub-buckets (≤25 % bucket width)
+static uint32_t latency_bucket(uint32_t us) {
+    if (us < 4) {
+        return us;
+    }
+    uint32_t msb = 31 - __builtin_clz(us);
+    uint32_t index = (msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+    return index < LATENCY_BUCKETS ? index : LATENCY_BUCKETS - 1;
+}
+
+static uint32_t latency_bucket_upper_us(uint32_t index) {
+    if (index < 4) {
+        return index;
+    }
+    uint32_t msb = index / 4 + 1;
+    return ((4 + (index % 4) + 1) << (msb - 2)) - 1;
+}
+
+// Upper bound of the bucket holding the pct-th percentile
+static uint32_t latency_percentile_us(const uint32_t* hist, uint32_t total, uint32_t pct) {
+    uint32_t target = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= target && seen > 0) {
+            return latency_bucket_upper_us(i);
+        }
+    }
+    return 0;
+}
+
+// Highest non-empty lane wins unless a lower lane has been passed over
+// DISPATCH_STARVATION_LIMIT times; the most-starved such lane goes first.
+// Returns -1 when every lane is empty.
+static int dispatch_pick_lane(bool* forced) {
+    UBaseType_t waiting[LANE_COUNT];
+    int pick = -1;
+    int starved = -1;
+
+    for (int i = 0; i < LANE_COUNT; i++) {
+        waiting[i] = lane_waiting(&dispatch_lanes[i]);
+        if (waiting[i] == 0) {
+            dispatch_lanes[i].passed_over = 0;
+            continue;
+        }
+        if (pick < 0) {
+            pick = i;
+        }
+        if (dispatch_lanes[i].passed_over >= DISPATCH_STARVATION_LIMIT &&
+            (starved < 0 || dispatch_lanes[i].passed_over > dispatch_lanes[starved].passed_over)) {
+            starved = i;
+        }
+    }
+
+    *forced = (starved >= 0 && starved != pick);
+    if (*forced) {
+        pick = starved;
+    }
+    for (int i = 0; i < LANE_COUNT; i++) {
+        if (waiting[i] > 0 && i != pick) {
+            dispatch_lanes[i].passed_over++;
+        }
+    }
+    if (pick >= 0) {
+        dispatch_lanes[pick].passed_over = 0;
+    }
+    return pick;
+}
+
+// Same snapshot as telemetry_queue_snapshot(), for one dispatch lane
+void dispatch_lane_snapshot(dispatch_lane_id_t id, telemetry_snapshot_t* out, bool reset) {
+    dispatch_lane_t* lane = &dispatch_lanes[id];
+    telemetry_counters_snapshot(&lane->telemetry, lane->name, lane->depth,
+                                lane_waiting(lane), out, reset);
+}
+
+static void dispatch_report(void) {
+    ESP_LOGI(TAG, "Dispatch Lanes (queueing latency, ms):");
+    for (int i = 0; i < LANE_COUNT; i++) {
+        dispatch_lane_t* lane = &dispatch_lanes[i];
+        telemetry_snapshot_t snap;
+        dispatch_lane_snapshot(i, &snap, false);
+        ESP_LOGI(TAG, "  %-8s %lu/%lu hwm=%lu  n=%lu p50≤%.1f p90≤%.1f p99≤%.1f  forced=%lu fail full/timeout=%lu/%lu",
+                snap.name, snap.waiting, snap.length, snap.stats.high_water,
+                lane->dispatched,
+                latency_percentile_us(lane->latency_hist, lane->dispatched, 50) / 1000.0f,
+                latency_percentile_us(lane->latency_hist, lane->dispatched, 90) / 1000.0f,
+                latency_percentile_us(lane->latency_hist, lane->dispatched, 99) / 1000.0f,
+                lane->forced, snap.stats.failed[TELEMETRY_FAIL_FULL],
+                snap.stats.failed[TELEMETRY_FAIL_TIMEOUT]);
+    }
+#if EVENT_CHANNEL_MPMC
+    uint32_t full = 0, sleeps = 0, wakeups = 0;
+    for (int i = 0; i < LANE_COUNT; i++) {
+        if (dispatch_lanes[i].ring == NULL) {
+            full += dispatch_lanes[i].queue->full;
+            sleeps += dispatch_lanes[i].queue->sleeps;
+            wakeups += dispatch_lanes[i].queue->wakeups;
+        }
+    }
+    ESP_LOGI(TAG, "  MPMC lanes: full=%lu sender sleeps=%lu wakeups=%lu", full, sleeps, wakeups);
+#endif
+#if SENSOR_SPSC_RING
+    ESP_LOGI(TAG, "  Sensor ring: sent=%lu full=%lu wakeups=%lu high-water=%lu/%d",
+            sensor_ring.sent, sensor_ring.full, sensor_ring.notifies,
+            sensor_ring.high_water, SENSOR_RING_LEN);
+#endif
+}
+#endif
 
 // Sensor simulation task
 void sensor_task(void *pvParameters) {
@@ -79,7 +548,13 @@ void sensor_task(void *pvParameters) {
         sensor_data.humidity = 30.0 + (esp_random() % 400) / 10.0;    // 30-70%
         sensor_data.timestamp = xTaskGetTickCount();
 
-        if (xQueueSend(xSensorQueue, &sensor_data, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_SENSOR, &sensor_data, sizeof(sensor_data),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = xQueueSend(xSensorQueue, &sensor_data, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "📊 Sensor: T=%.1f°C, H=%.1f%%, ID=%d", 
                     sensor_data.temperature, sensor_data.humidity, sensor_id);
 
@@ -106,7 +581,13 @@ void user_input_task(void *pvParameters) {
         user_input.pressed = true;
         user_input.duration_ms = 100 + (esp_random() % 1000); // 100-1100ms
 
-        if (xQueueSend(xUserQueue, &user_input, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_USER, &user_input, sizeof(user_input),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = xQueueSend(xUserQueue, &user_input, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "🔘 User: Button %d pressed for %dms", 
                     user_input.button_id, user_input.duration_ms);
 
@@ -123,7 +604,9 @@ void user_input_task(void *pvParameters) {
 
 // Network simulation task
 void network_task(void *pvParameters) {
+#if !NETWORK_ZERO_COPY
     network_message_t network_msg;
+#endif
     const char* sources[] = {"WiFi", "Bluetooth", "LoRa", "Ethernet"};
     const char* messages[] = {
         "Status update received",
@@ -137,13 +620,73 @@ void network_task(void *pvParameters) {
 
     while (1) {
         // Simulate network message
-        strcpy(network_msg.source, sources[esp_random() % 4]);
-        strcpy(network_msg.message, messages[esp_random() % 5]);
-        network_msg.priority = 1 + (esp_random() % 5); // Priority 1-5
+        const char* source = sources[esp_random() % 4];
+        const char* text = messages[esp_random() % 5];
+        int priority = 1 + (esp_random() % 5); // Priority 1-5
+
+#if NETWORK_VARLEN
+        // Reserve exactly the bytes this message needs and write it in place;
+        // after a successful send the processor releases the record
+        size_t source_len = strlen(source);
+        size_t message_len = strlen(text);
+        size_t record_len = sizeof(network_record_t) + source_len + 1 + message_len + 1;
+        network_block_t* block = msg_ring_reserve(&network_ring, record_len);
+        if (block == NULL) {
+            ESP_LOGW(TAG, "Network ring full, message dropped");
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+        block->priority = priority;
+        block->source_len = source_len;
+        block->message_len = message_len;
+        memcpy(block->text, source, source_len + 1);
+        memcpy(block->text + source_len + 1, text, message_len + 1);
+        msg_ring_commit(&network_ring, block, record_len);
+
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &block, sizeof(block), pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = xQueueSend(xNetworkQueue, &block, pdMS_TO_TICKS(100));
+#endif
+        if (sent != pdPASS) {
+            msg_ring_release(block);
+        }
+#elif NETWORK_ZERO_COPY
+        // Fill the block in place; after a successful send it belongs to the processor
+        network_message_t* block = message_pool_alloc(&network_pool);
+        if (block == NULL) {
+            ESP_LOGW(TAG, "Network pool empty, message dropped");
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+        strcpy(block->source, source);
+        strcpy(block->message, text);
+        block->priority = priority;
+
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &block, sizeof(block), pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = xQueueSend(xNetworkQueue, &block, pdMS_TO_TICKS(100));
+#endif
+        if (sent != pdPASS) {
+            message_pool_free(&network_pool, block);
+        }
+#else
+        strcpy(network_msg.source, source);
+        strcpy(network_msg.message, text);
+        network_msg.priority = priority;
+
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &network_msg, sizeof(network_msg),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = xQueueSend(xNetworkQueue, &network_msg, pdMS_TO_TICKS(100));
+#endif
+#endif
 
-        if (xQueueSend(xNetworkQueue, &network_msg, pdMS_TO_TICKS(100)) == pdPASS) {
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "🌐 Network [%s]: %s (P:%d)", 
-                    network_msg.source, network_msg.message, network_msg.priority);
+                    source, text, priority);
 
             // Blink network LED
             gpio_set_level(LED_NETWORK, 1);
@@ -163,7 +706,12 @@ void timer_task(void *pvParameters) {
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(10000)); // Every 10 seconds
 
-        if (xSemaphoreGive(xTimerSemaphore) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_TIMER, NULL, 0, 0);
+#else
+        BaseType_t sent = xSemaphoreGive(xTimerSemaphore);
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "⏰ Timer: Periodic timer fired");
 
             // Blink timer LED
@@ -174,12 +722,306 @@ void timer_task(void *pvParameters) {
     }
 }
 
+// ================ EVENT HANDLERS ================
+// Shared by the queue-set processor and the event-channel dispatch table
+
+static void handle_sensor_event(const void* payload) {
+    const sensor_data_t* sensor_data = (const sensor_data_t*)payload;
+
+    stats.sensor_count++;
+    HOT_LOGI(TAG, "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%", 
+            sensor_data->temperature, sensor_data->humidity);
+
+    // Simulate sensor data processing
+    if (sensor_data->temperature > 35.0) {
+        HOT_LOGW(TAG, "⚠️  High temperature alert!");
+    }
+    if (sensor_data->humidity > 60.0) {
+        HOT_LOGW(TAG, "⚠️  High humidity alert!");
+    }
+}
+
+static void handle_user_event(const void* payload) {
+    const user_input_t* user_input = (const user_input_t*)payload;
+
+    stats.user_count++;
+    HOT_LOGI(TAG, "→ Processing USER input: Button %d (%dms)", 
+            user_input->button_id, user_input->duration_ms);
+
+    // Simulate user input processing
+    switch (user_input->button_id) {
+        case 1:
+            HOT_LOGI(TAG, "💡 Action: Toggle LED");
+            break;
+        case 2:
+            HOT_LOGI(TAG, "📊 Action: Show status");
+            break;
+        case 3:
+            HOT_LOGI(TAG, "⚙️  Action: Settings menu");
+            break;
+    }
+}
+
+#if !NETWORK_VARLEN
+// Network message handling, shared by the copy and zero-copy paths
+static void handle_network_event(const void* payload) {
+    const network_message_t* msg = (const network_message_t*)payload;
+
+    stats.network_count++;
+    HOT_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s", 
+            msg->source, msg->message);
+
+    // Simulate network message processing
+    if (msg->priority >= 4) {
+        HOT_LOGW(TAG, "🚨 High priority network message!");
+    }
+}
+#endif
+
+#if NETWORK_VARLEN
+// The payload is the record pointer: handle the message in place, then release the record
+static void handle_network_block_event(const void* payload) {
+    network_block_t* record = *(network_block_t* const*)payload;
+    const char* message = record->text + record->source_len + 1;
+
+    stats.network_count++;
+    HOT_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s", record->text, message);
+
+    // Simulate network message processing
+    if (record->priority >= 4) {
+        HOT_LOGW(TAG, "🚨 High priority network message!");
+    }
+    msg_ring_release(record);
+}
+#elif NETWORK_ZERO_COPY
+// The payload is the block pointer: handle the message in place, then return the block
+static void handle_network_block_event(const void* payload) {
+    network_message_t* block = *(network_message_t* const*)payload;
+
+    handle_network_event(block);
+    message_pool_free(&network_pool, block);
+}
+#endif
+
+static void handle_timer_event(const void* payload) {
+    stats.timer_count++;
+    HOT_LOGI(TAG, "→ Processing TIMER event: Periodic maintenance");
+
+    // Show system statistics
+    HOT_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu", 
+            stats.sensor_count, stats.user_count, 
+            stats.network_count, stats.timer_count);
+}
+
+static const event_handler_t event_handlers[MSG_TYPE_COUNT] = {
+    [MSG_SENSOR]  = handle_sensor_event,
+    [MSG_USER]    = handle_user_event,
+#if NETWORK_ZERO_COPY
+    [MSG_NETWORK] = handle_network_block_event,
+#else
+    [MSG_NETWORK] = handle_network_event,
+#endif
+    [MSG_TIMER]   = handle_timer_event,
+};
+
+#if PROCESSOR_BATCH_MODE
+// ================ BATCH PROCESSING ================
+// Bucket i counts batches of size (2^(i-1), 2^i]: 1, 2, 3-4, 5-8, 9-16, 17+
+static uint32_t batch_bucket(uint32_t size) {
+    uint32_t index = size <= 1 ? 0 : 32 - __builtin_clz(size - 1);
+    return index < BATCH_HIST_BUCKETS ? index : BATCH_HIST_BUCKETS - 1;
+}
+
+static bool batch_budget_left(int64_t batch_start_us) {
+    return esp_timer_get_time() - batch_start_us < BATCH_BUDGET_US;
+}
+
+static void batch_record(uint32_t size, int64_t batch_start_us) {
+    if (size == 0) {
+        batch_stats.empty_wakeups++;
+        return;
+    }
+    batch_stats.batches++;
+    batch_stats.events += size;
+    batch_stats.size_hist[batch_bucket(size)]++;
+    if (!batch_budget_left(batch_start_us)) {
+        batch_stats.budget_stops++;
+    }
+}
+
+static void batch_report(void) {
+    static const char* labels[BATCH_HIST_BUCKETS] = {"1", "2", "3-4", "5-8", "9-16", "17+"};
+    static uint32_t last_events = 0;
+    static TickType_t last_tick = 0;
+
+    TickType_t now = xTaskGetTickCount();
+    uint32_t events = batch_stats.events;
+    float seconds = (now - last_tick) * portTICK_PERIOD_MS / 1000.0f;
+
+    ESP_LOGI(TAG, "Batch Processing:");
+    ESP_LOGI(TAG, "  %.1f events/s, %lu batches (avg %.1f), %lu budget stops, %lu empty wakeups",
+            seconds > 0 ? (events - last_events) / seconds : 0.0f,
+            batch_stats.batches,
+            batch_stats.batches ? (float)batch_stats.events / batch_stats.batches : 0.0f,
+            batch_stats.budget_stops, batch_stats.empty_wakeups);
+    for (int i = 0; i < BATCH_HIST_BUCKETS; i++) {
+        ESP_LOGI(TAG, "  size %-5s %lu", labels[i], batch_stats.size_hist[i]);
+    }
+    last_events = events;
+    last_tick = now;
+}
+#endif
+
+#if USE_EVENT_CHANNEL
+static void dispatch_event(const event_t* event) {
+    if (event->type < MSG_TYPE_COUNT) {
+        event_handlers[event->type](&event->payload);
+    } else {
+        ESP_LOGW(TAG, "Unknown event type %d (%u bytes)", event->type, event->length);
+    }
+}
+
+#if USE_PRIORITY_DISPATCH
+// Receive the head of `lane` and run its handler; false if the lane was empty
+static bool dispatch_from_lane(int lane, bool forced) {
+    event_t event;
+
+    if (dispatch_lanes[lane].ring != NULL) {
+        if (!spsc_ring_receive(dispatch_lanes[lane].ring, &event, 0)) {
+            return false;
+        }
+    } else if (!lane_queue_receive(&dispatch_lanes[lane], &event)) {
+        return false;
+    }
+
+    uint32_t latency = (uint32_t)esp_timer_get_time() - event.enqueued_us;
+    telemetry_record_received(&dispatch_lanes[lane].telemetry, latency);
+    dispatch_lanes[lane].latency_hist[latency_bucket(latency)]++;
+    dispatch_lanes[lane].dispatched++;
+    if (forced) {
+        dispatch_lanes[lane].forced++;
+    }
+
+    dispatch_event(&event);
+    return true;
+}
+
+// Main processing task: serve lanes by priority class, sleep when all are empty
+void processor_task(void *pvParameters) {
+    bool forced;
+
+    ESP_LOGI(TAG, "Processor task started - priority dispatch over %d lanes", LANE_COUNT);
+
+    while (1) {
+        int lane = dispatch_pick_lane(&forced);
+        if (lane < 0) {
+            // Posts made after the scan above leave a pending notification
+#if SENSOR_SPSC_RING
+            // The ring notifies only while armed; a sensor event that
+            // slipped in after the scan makes arming fail instead
+            if (!spsc_ring_arm_wait(&sensor_ring)) {
+                continue;
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            spsc_ring_disarm_wait(&sensor_ring);
+#else
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+            continue;
+        }
+
+        // Turn on processor LED
+        gpio_set_level(LED_PROCESSOR, 1);
+
+#if PROCESSOR_BATCH_MODE
+        // Every pick re-ranks the lanes, so a batch never lets a lower class
+        // jump the queue; it only saves the wakeup between events
+        int64_t batch_start = esp_timer_get_time();
+        uint32_t batch = 0;
+        do {
+            if (dispatch_from_lane(lane, forced)) {
+                batch++;
+            }
+        } while (batch < BATCH_MAX_PER_MEMBER * LANE_COUNT &&
+                 batch_budget_left(batch_start) &&
+                 (lane = dispatch_pick_lane(&forced)) >= 0);
+        batch_record(batch, batch_start);
+#else
+        dispatch_from_lane(lane, forced);
+
+        // Simulate processing time
+        vTaskDelay(pdMS_TO_TICKS(200));
+#endif
+
+        // Turn off processor LED
+        gpio_set_level(LED_PROCESSOR, 0);
+    }
+}
+#else
+// Main processing task: one receive delivers one event of any type
+void processor_task(void *pvParameters) {
+    event_t event;
+
+    ESP_LOGI(TAG, "Processor task started - waiting for events...");
+
+    while (1) {
+#if EVENT_CHANNEL_MPMC
+        if (mpmc_queue_receive(&event_channel, &event, portMAX_DELAY)) {
+#else
+        if (telemetry_queue_receive(&event_tq, &event, portMAX_DELAY) == pdPASS) {
+#endif
+            // Turn on processor LED
+            gpio_set_level(LED_PROCESSOR, 1);
+
+#if PROCESSOR_BATCH_MODE
+            // Keep draining without blocking until empty, full batch or budget spent
+            int64_t batch_start = esp_timer_get_time();
+            uint32_t batch = 0;
+            do {
+                dispatch_event(&event);
+                batch++;
+            } while (batch < BATCH_MAX_PER_MEMBER &&
+                     batch_budget_left(batch_start) &&
+#if EVENT_CHANNEL_MPMC
+                     mpmc_queue_try_receive(&event_channel, &event));
+#else
+                     telemetry_queue_receive(&event_tq, &event, 0) == pdPASS);
+#endif
+            batch_record(batch, batch_start);
+#else
+            dispatch_event(&event);
+
+            // Simulate processing time
+            vTaskDelay(pdMS_TO_TICKS(200));
+#endif
+
+            // Turn off processor LED
+            gpio_set_level(LED_PROCESSOR, 0);
+        }
+    }
+}
+#endif
+#else
 // Main processing task using Queue Sets
 void processor_task(void *pvParameters) {
     QueueSetMemberHandle_t xActivatedMember;
+#if PROCESSOR_BATCH_MODE
+    QueueSetMemberHandle_t members[MSG_TYPE_COUNT] = {
+        [MSG_SENSOR]  = xSensorQueue,
+        [MSG_USER]    = xUserQueue,
+        [MSG_NETWORK] = xNetworkQueue,
+        [MSG_TIMER]   = xTimerSemaphore,
+    };
+    event_t event;
+#else
     sensor_data_t sensor_data;
     user_input_t user_input;
+#if NETWORK_ZERO_COPY
+    network_block_t* network_block;
+#else
     network_message_t network_msg;
+#endif
+#endif
 
     ESP_LOGI(TAG, "Processor task started - waiting for events...");
 
@@ -191,74 +1033,64 @@ void processor_task(void *pvParameters) {
             // Turn on processor LED
             gpio_set_level(LED_PROCESSOR, 1);
 
+#if PROCESSOR_BATCH_MODE
+            // Drain up to BATCH_MAX_PER_MEMBER items from every ready member, not
+            // only the one the set reported. Items taken here leave their handles
+            // in the set, so later selects may find the member already empty.
+            int64_t batch_start = esp_timer_get_time();
+            uint32_t batch = 0;
+            for (int type = 0; type < MSG_TYPE_COUNT; type++) {
+                for (int n = 0; n < BATCH_MAX_PER_MEMBER && batch_budget_left(batch_start); n++) {
+                    BaseType_t got = (type == MSG_TIMER)
+                        ? xSemaphoreTake(members[type], 0)
+                        : xQueueReceive(members[type], &event.payload, 0);
+                    if (got != pdPASS) {
+                        break;
+                    }
+                    event_handlers[type](&event.payload);
+                    batch++;
+                }
+            }
+            batch_record(batch, batch_start);
+#else
             // Determine which queue/semaphore was activated
             if (xActivatedMember == xSensorQueue) {
                 if (xQueueReceive(xSensorQueue, &sensor_data, 0) == pdPASS) {
-                    stats.sensor_count++;
-                    ESP_LOGI(TAG, "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%", 
-                            sensor_data.temperature, sensor_data.humidity);
-
-                    // Simulate sensor data processing
-                    if (sensor_data.temperature > 35.0) {
-                        ESP_LOGW(TAG, "⚠️  High temperature alert!");
-                    }
-                    if (sensor_data.humidity > 60.0) {
-                        ESP_LOGW(TAG, "⚠️  High humidity alert!");
-                    }
+                    handle_sensor_event(&sensor_data);
                 }
             }
             else if (xActivatedMember == xUserQueue) {
                 if (xQueueReceive(xUserQueue, &user_input, 0) == pdPASS) {
-                    stats.user_count++;
-                    ESP_LOGI(TAG, "→ Processing USER input: Button %d (%dms)", 
-                            user_input.button_id, user_input.duration_ms);
-
-                    // Simulate user input processing
-                    switch (user_input.button_id) {
-                        case 1:
-                            ESP_LOGI(TAG, "💡 Action: Toggle LED");
-                            break;
-                        case 2:
-                            ESP_LOGI(TAG, "📊 Action: Show status");
-                            break;
-                        case 3:
-                            ESP_LOGI(TAG, "⚙️  Action: Settings menu");
-                            break;
-                    }
+                    handle_user_event(&user_input);
                 }
             }
             else if (xActivatedMember == xNetworkQueue) {
+#if NETWORK_ZERO_COPY
+                if (xQueueReceive(xNetworkQueue, &network_block, 0) == pdPASS) {
+                    handle_network_block_event(&network_block);
+                }
+#else
                 if (xQueueReceive(xNetworkQueue, &network_msg, 0) == pdPASS) {
-                    stats.network_count++;
-                    ESP_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s", 
-                            network_msg.source, network_msg.message);
-
-                    // Simulate network message processing
-                    if (network_msg.priority >= 4) {
-                        ESP_LOGW(TAG, "🚨 High priority network message!");
-                    }
+                    handle_network_event(&network_msg);
                 }
+#endif
             }
             else if (xActivatedMember == xTimerSemaphore) {
                 if (xSemaphoreTake(xTimerSemaphore, 0) == pdPASS) {
-                    stats.timer_count++;
-                    ESP_LOGI(TAG, "→ Processing TIMER event: Periodic maintenance");
-
-                    // Show system statistics
-                    ESP_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu", 
-                            stats.sensor_count, stats.user_count, 
-                            stats.network_count, stats.timer_count);
+                    handle_timer_event(NULL);
                 }
             }
 
             // Simulate processing time
             vTaskDelay(pdMS_TO_TICKS(200));
+#endif
 
             // Turn off processor LED
             gpio_set_level(LED_PROCESSOR, 0);
         }
     }
 }
+#endif
 
 // System monitor task
 void monitor_task(void *pvParameters) {
@@ -269,22 +1101,392 @@ void monitor_task(void *pvParameters) {
 
         ESP_LOGI(TAG, "\n═══ SYSTEM MONITOR ═══");
         ESP_LOGI(TAG, "Queue States:");
+#if USE_PRIORITY_DISPATCH
+        dispatch_report();
+#elif USE_EVENT_CHANNEL && EVENT_CHANNEL_MPMC
+        ESP_LOGI(TAG, "  Event Channel: %lu/%d (%u B/event, MPMC: full %u, sleeps %u, wakeups %u)",
+                mpmc_queue_count(&event_channel), EVENT_CHANNEL_MPMC_LEN,
+                (unsigned)sizeof(event_t), (unsigned)event_channel.full,
+                (unsigned)event_channel.sleeps, (unsigned)event_channel.wakeups);
+#elif USE_EVENT_CHANNEL
+        telemetry_snapshot_t snap;
+        telemetry_queue_snapshot(&event_tq, &snap, false);
+        telemetry_snapshot_log(&snap, TAG);
+#else
         ESP_LOGI(TAG, "  Sensor Queue:  %d/%d", 
                 uxQueueMessagesWaiting(xSensorQueue), 5);
         ESP_LOGI(TAG, "  User Queue:    %d/%d", 
                 uxQueueMessagesWaiting(xUserQueue), 3);
         ESP_LOGI(TAG, "  Network Queue: %d/%d", 
-                uxQueueMessagesWaiting(xNetworkQueue), 8);
+                uxQueueMessagesWaiting(xNetworkQueue), NETWORK_QUEUE_LEN);
+#endif
+#if NETWORK_VARLEN
+        // Bytes the records actually took vs a fixed network_message_t slot each
+        ESP_LOGI(TAG, "  Network Ring:  %lu/%d B used (peak %lu, full %lu)",
+                msg_ring_used(&network_ring), NETWORK_RING_BYTES,
+                network_ring.high_water, network_ring.full);
+        if (network_ring.records > 0) {
+            ESP_LOGI(TAG, "    %lu records, %lu B payload, %lu B of ring: %.1f B/msg vs %u B fixed slot",
+                    network_ring.records, network_ring.payload_bytes, network_ring.ring_bytes,
+                    (float)network_ring.ring_bytes / network_ring.records,
+                    (unsigned)sizeof(network_message_t));
+        }
+        ESP_LOGI(TAG, "    Storage: ring %d B vs pool of %d fixed blocks %u B",
+                NETWORK_RING_BYTES, NETWORK_POOL_BLOCKS,
+                (unsigned)(NETWORK_POOL_BLOCKS * sizeof(network_message_t)));
+#elif NETWORK_ZERO_COPY
+        ESP_LOGI(TAG, "  Network Pool:  %lu/%d free (min %lu, exhausted %lu)",
+                network_pool.free_count, NETWORK_POOL_BLOCKS,
+                network_pool.min_free, network_pool.exhausted);
+#endif
 
         ESP_LOGI(TAG, "Message Statistics:");
         ESP_LOGI(TAG, "  Sensor:  %lu messages", stats.sensor_count);
         ESP_LOGI(TAG, "  User:    %lu messages", stats.user_count);
         ESP_LOGI(TAG, "  Network: %lu messages", stats.network_count);
         ESP_LOGI(TAG, "  Timer:   %lu events", stats.timer_count);
+#if PROCESSOR_BATCH_MODE
+        batch_report();
+#endif
+#if USE_DEFERRED_LOG
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            dlog_stats_t dlog;
+            deferred_log_get_stats(core, &dlog);
+            ESP_LOGI(TAG, "Deferred log core %d: %lu records, %lu dropped, peak %lu/%d queued",
+                    core, dlog.written, dlog.dropped, dlog.high_water, DLOG_RING_RECORDS);
+        }
+#endif
         ESP_LOGI(TAG, "═══════════════════════\n");
     }
 }
 
+// ================ COPY vs ZERO-COPY BENCHMARK ================
+#if RUN_QUEUE_BENCHMARK
+typedef struct {
+    QueueHandle_t queue;
+    message_pool_t* pool;       // NULL = copy path
+    volatile uint32_t received;
+    uint32_t checksum;
+} bench_ctx_t;
+
+static message_pool_t bench_pool;
+
+// Stand-in for real processing: touch every payload byte once
+static uint32_t message_checksum(const network_message_t* msg) {
+    uint32_t sum = (uint32_t)msg->priority;
+    for (size_t i = 0; i < sizeof(msg->source) && msg->source[i]; i++) sum += msg->source[i];
+    for (size_t i = 0; i < sizeof(msg->message) && msg->message[i]; i++) sum += msg->message[i];
+    return sum;
+}
+
+static void bench_consumer_task(void *pvParameters) {
+    bench_ctx_t* ctx = (bench_ctx_t*)pvParameters;
+    network_message_t msg;
+    network_message_t* block;
+
+    while (1) {
+        if (ctx->pool != NULL) {
+            if (xQueueReceive(ctx->queue, &block, portMAX_DELAY) == pdPASS) {
+                ctx->checksum += message_checksum(block);
+                message_pool_free(ctx->pool, block);
+                ctx->received++;
+            }
+        } else {
+            if (xQueueReceive(ctx->queue, &msg, portMAX_DELAY) == pdPASS) {
+                ctx->checksum += message_checksum(&msg);
+                ctx->received++;
+            }
+        }
+    }
+}
+
+// Offer `rate` messages/s for BENCH_DURATION_MS. The tick is the pacing
+// granularity, so each tick sends its share as a burst. The consumer runs
+// at higher priority on the same core, so the busy time of a burst covers
+// fill + send + context switch + receive + processing of every message.
+static void bench_run(bool zero_copy, uint32_t rate, float* us_per_msg) {
+    bench_ctx_t ctx = {0};
+    TaskHandle_t consumer;
+    network_message_t msg;
+    uint32_t sent = 0, dropped = 0, credit_milli = 0;
+    int64_t busy_us = 0;
+
+    ctx.queue = xQueueCreate(BENCH_QUEUE_LEN, zero_copy ? sizeof(network_message_t*)
+                                                        : sizeof(network_message_t));
+    if (ctx.queue == NULL) {
+        ESP_LOGE(TAG, "Benchmark queue allocation failed");
+        return;
+    }
+    if (zero_copy) {
+        message_pool_init(&bench_pool);
+        ctx.pool = &bench_pool;
+    }
+    xTaskCreatePinnedToCore(bench_consumer_task, "BenchRx", 2048, &ctx,
+                            uxTaskPriorityGet(NULL) + 1, &consumer, xPortGetCoreID());
+
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t end = last_wake + pdMS_TO_TICKS(BENCH_DURATION_MS);
+    while ((int32_t)(end - xTaskGetTickCount()) > 0) {
+        vTaskDelayUntil(&last_wake, 1);
+        credit_milli += rate * portTICK_PERIOD_MS;
+
+        int64_t start = esp_timer_get_time();
+        while (credit_milli >= 1000) {
+            credit_milli -= 1000;
+            if (zero_copy) {
+                network_message_t* block = message_pool_alloc(&bench_pool);
+                if (block == NULL) {
+                    dropped++;
+                    continue;
+                }
+                strcpy(block->source, "Bench");
+                strcpy(block->message, "Data synchronization");
+                block->priority = sent % 5 + 1;
+                if (xQueueSend(ctx.queue, &block, 0) != pdPASS) {
+                    message_pool_free(&bench_pool, block);
+                    dropped++;
+                    continue;
+                }
+            } else {
+                strcpy(msg.source, "Bench");
+                strcpy(msg.message, "Data synchronization");
+                msg.priority = sent % 5 + 1;
+                if (xQueueSend(ctx.queue, &msg, 0) != pdPASS) {
+                    dropped++;
+                    continue;
+                }
+            }
+            sent++;
+        }
+        busy_us += esp_timer_get_time() - start;
+    }
+
+    // Consumer preempts on every send, so it has already caught up
+    while (ctx.received < sent) {
+        vTaskDelay(1);
+    }
+    vTaskDelete(consumer);
+    vQueueDelete(ctx.queue);
+
+    *us_per_msg = sent ? (float)busy_us / sent : 0.0f;
+    ESP_LOGI(TAG, "  %-9s %5lu msg/s: delivered %lu, dropped %lu, %.2f us/msg, CPU %.1f%%",
+             zero_copy ? "zero-copy" : "copy", rate, ctx.received, dropped,
+             *us_per_msg, busy_us * 100.0f / (BENCH_DURATION_MS * 1000.0f));
+}
+
+void benchmark_network_paths(void) {
+    static const uint32_t rates[] = {100, 1000, 10000};
+
+    ESP_LOGI(TAG, "\n═══ NETWORK PATH BENCHMARK ═══");
+    ESP_LOGI(TAG, "Queue storage: copy %u B, zero-copy %u B + pool %u B",
+             (unsigned)(BENCH_QUEUE_LEN * sizeof(network_message_t)),
+             (unsigned)(BENCH_QUEUE_LEN * sizeof(network_message_t*)),
+             (unsigned)(NETWORK_POOL_BLOCKS * sizeof(network_message_t)));
+
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        float copy_us = 0.0f, zero_us = 0.0f;
+        bench_run(false, rates[i], &copy_us);
+        bench_run(true, rates[i], &zero_us);
+        if (zero_us > 0.0f) {
+            ESP_LOGI(TAG, "  → %lu msg/s: zero-copy %.2fx per message", rates[i], copy_us / zero_us);
+        }
+    }
+    ESP_LOGI(TAG, "══════════════════════════════\n");
+}
+
+// ================ QUEUE SET vs EVENT CHANNEL BENCHMARK ================
+// Same events through both mechanisms. The consumer runs at higher priority
+// on the producer's core, so every send wakes it immediately: wake latency is
+// send timestamp → handler entry, and events/s covers the full round trip.
+typedef struct {
+    QueueSetHandle_t set;
+    QueueHandle_t members[MSG_TYPE_COUNT];     // MSG_TIMER slot holds a binary semaphore
+    QueueHandle_t channel;
+    volatile uint32_t received;
+    volatile int64_t sent_us;
+    uint64_t latency_total_us;
+    uint32_t latency_max_us;
+    uint32_t per_type[MSG_TYPE_COUNT];
+} mux_bench_t;
+
+static mux_bench_t mux_bench;
+
+static void mux_bench_record(message_type_t type) {
+    uint32_t latency = (uint32_t)(esp_timer_get_time() - mux_bench.sent_us);
+
+    mux_bench.latency_total_us += latency;
+    if (latency > mux_bench.latency_max_us) {
+        mux_bench.latency_max_us = latency;
+    }
+    mux_bench.per_type[type]++;
+    mux_bench.received++;
+}
+
+static void mux_bench_sensor(const void* payload)  { mux_bench_record(MSG_SENSOR); }
+static void mux_bench_user(const void* payload)    { mux_bench_record(MSG_USER); }
+static void mux_bench_network(const void* payload) { mux_bench_record(MSG_NETWORK); }
+static void mux_bench_timer(const void* payload)   { mux_bench_record(MSG_TIMER); }
+
+static const event_handler_t mux_bench_handlers[MSG_TYPE_COUNT] = {
+    [MSG_SENSOR]  = mux_bench_sensor,
+    [MSG_USER]    = mux_bench_user,
+    [MSG_NETWORK] = mux_bench_network,
+    [MSG_TIMER]   = mux_bench_timer,
+};
+
+// Mirrors the queue-set processor: select, compare handles, then receive
+static void mux_set_consumer_task(void *pvParameters) {
+    event_t event;
+
+    while (1) {
+        QueueSetMemberHandle_t member = xQueueSelectFromSet(mux_bench.set, portMAX_DELAY);
+
+        if (member == mux_bench.members[MSG_SENSOR]) {
+            if (xQueueReceive(member, &event.payload, 0) == pdPASS) mux_bench_sensor(&event.payload);
+        } else if (member == mux_bench.members[MSG_USER]) {
+            if (xQueueReceive(member, &event.payload, 0) == pdPASS) mux_bench_user(&event.payload);
+        } else if (member == mux_bench.members[MSG_NETWORK]) {
+            if (xQueueReceive(member, &event.payload, 0) == pdPASS) mux_bench_network(&event.payload);
+        } else if (member == mux_bench.members[MSG_TIMER]) {
+            if (xSemaphoreTake(member, 0) == pdPASS) mux_bench_timer(NULL);
+        }
+    }
+}
+
+static void mux_channel_consumer_task(void *pvParameters) {
+    event_t event;
+
+    while (1) {
+        if (xQueueReceive(mux_bench.channel, &event, portMAX_DELAY) == pdPASS &&
+            event.type < MSG_TYPE_COUNT) {
+            mux_bench_handlers[event.type](&event.payload);
+        }
+    }
+}
+
+static void mux_bench_run(bool use_channel) {
+    static const size_t payload_size[MSG_TYPE_COUNT] = {
+        [MSG_SENSOR]  = sizeof(sensor_data_t),
+        [MSG_USER]    = sizeof(user_input_t),
+        [MSG_NETWORK] = NETWORK_QUEUE_ITEM_SIZE,
+        [MSG_TIMER]   = 0,
+    };
+    event_t event = {0};
+    TaskHandle_t consumer;
+    uint32_t sent = 0, dropped = 0;
+    bool ready;
+
+    memset(&mux_bench, 0, sizeof(mux_bench));
+    if (use_channel) {
+        mux_bench.channel = xQueueCreate(EVENT_CHANNEL_LEN, sizeof(event_t));
+        ready = (mux_bench.channel != NULL);
+    } else {
+        mux_bench.members[MSG_SENSOR] = xQueueCreate(5, payload_size[MSG_SENSOR]);
+        mux_bench.members[MSG_USER] = xQueueCreate(3, payload_size[MSG_USER]);
+        mux_bench.members[MSG_NETWORK] = xQueueCreate(NETWORK_QUEUE_LEN, payload_size[MSG_NETWORK]);
+        mux_bench.members[MSG_TIMER] = xSemaphoreCreateBinary();
+        mux_bench.set = xQueueCreateSet(EVENT_CHANNEL_LEN);
+        ready = (mux_bench.set != NULL);
+        for (int t = 0; t < MSG_TYPE_COUNT && ready; t++) {
+            ready = mux_bench.members[t] && xQueueAddToSet(mux_bench.members[t], mux_bench.set) == pdPASS;
+        }
+    }
+    if (!ready) {
+        ESP_LOGE(TAG, "Benchmark channel allocation failed");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(use_channel ? mux_channel_consumer_task : mux_set_consumer_task,
+                            "MuxRx", 2048, NULL, uxTaskPriorityGet(NULL) + 1,
+                            &consumer, xPortGetCoreID());
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_MUX_EVENTS; i++) {
+        message_type_t type = (message_type_t)(i % MSG_TYPE_COUNT);
+        BaseType_t ok;
+
+        mux_bench.sent_us = esp_timer_get_time();
+        if (use_channel) {
+            event.type = (uint8_t)type;
+            event.length = (uint16_t)payload_size[type];
+            ok = xQueueSend(mux_bench.channel, &event, 0);
+        } else if (type == MSG_TIMER) {
+            ok = xSemaphoreGive(mux_bench.members[MSG_TIMER]);
+        } else {
+            ok = xQueueSend(mux_bench.members[type], &event.payload, 0);
+        }
+        if (ok == pdPASS) sent++; else dropped++;
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+
+    while (mux_bench.received < sent) {
+        vTaskDelay(1);
+    }
+    vTaskDelete(consumer);
+    if (use_channel) {
+        vQueueDelete(mux_bench.channel);
+    } else {
+        for (int t = 0; t < MSG_TYPE_COUNT; t++) {
+            xQueueRemoveFromSet(mux_bench.members[t], mux_bench.set);
+            vQueueDelete(mux_bench.members[t]);
+        }
+        vQueueDelete(mux_bench.set);
+    }
+
+    ESP_LOGI(TAG, "  %-13s %7.0f events/s, wake latency avg %.1f us / max %lu us, dropped %lu",
+             use_channel ? "event channel" : "queue set",
+             elapsed_us > 0 ? sent * 1e6f / elapsed_us : 0.0f,
+             sent ? (float)mux_bench.latency_total_us / sent : 0.0f,
+             mux_bench.latency_max_us, dropped);
+}
+
+void benchmark_event_mux(void) {
+    ESP_LOGI(TAG, "\n═══ QUEUE SET vs EVENT CHANNEL (%d events) ═══", BENCH_MUX_EVENTS);
+    ESP_LOGI(TAG, "Item size: event channel %u B, largest set member %u B",
+             (unsigned)sizeof(event_t), (unsigned)sizeof(((event_t*)0)->payload));
+    mux_bench_run(false);
+    mux_bench_run(true);
+    ESP_LOGI(TAG, "══════════════════════════════════════════\n");
+}
+
+#if USE_DEFERRED_LOG
+// ================ DEFERRED LOG BENCHMARK ================
+// Cost of one handler log line at the call site: a deferred record vs only
+// formatting the same line (UART time comes on top for ESP_LOGx). Fewer
+// calls than ring slots, so none are dropped; the BENCH tag is silenced so
+// the formatter discards the records later.
+#define DLOG_BENCH_CALLS    (DLOG_RING_RECORDS / 2)
+
+void benchmark_deferred_log(void) {
+    static const char* BENCH_TAG = "BENCH";
+    char line[128];
+    float temperature = 23.5f, humidity = 45.2f;
+
+    esp_log_level_set(BENCH_TAG, ESP_LOG_NONE);
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < DLOG_BENCH_CALLS; i++) {
+        DLOGI(BENCH_TAG, "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%", temperature, humidity);
+    }
+    uint32_t deferred = (esp_cpu_get_cycle_count() - start) / DLOG_BENCH_CALLS;
+
+    start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < DLOG_BENCH_CALLS; i++) {
+        snprintf(line, sizeof(line), "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%",
+                 temperature, humidity);
+    }
+    uint32_t formatted = (esp_cpu_get_cycle_count() - start) / DLOG_BENCH_CALLS;
+
+    ESP_LOGI(TAG, "\n═══ DEFERRED LOG (%d calls) ═══", DLOG_BENCH_CALLS);
+    ESP_LOGI(TAG, "  DLOGI record:   %lu cycles/call (%.2f us)", deferred,
+             (float)deferred / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+    ESP_LOGI(TAG, "  snprintf only:  %lu cycles/call (%.2f us)", formatted,
+             (float)formatted / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+    ESP_LOGI(TAG, "══════════════════════════════\n");
+}
+#endif
+#endif
+
 void app_main(void) {
     ESP_LOGI(TAG, "Queue Sets Implementation Lab Starting...");
 
@@ -302,14 +1504,74 @@ void app_main(void) {
     gpio_set_level(LED_TIMER, 0);
     gpio_set_level(LED_PROCESSOR, 0);
 
+#if RUN_QUEUE_BENCHMARK
+    benchmark_network_paths();
+    benchmark_event_mux();
+#if USE_DEFERRED_LOG
+    benchmark_deferred_log();
+#endif
+#endif
+#if NETWORK_VARLEN
+    msg_ring_init(&network_ring, network_ring_storage, sizeof(network_ring_storage));
+#elif NETWORK_ZERO_COPY
+    message_pool_init(&network_pool);
+#endif
+
+#if USE_PRIORITY_DISPATCH
+    // One event_t lane per priority class
+    bool lanes_ok = true;
+#if SENSOR_SPSC_RING
+    spsc_ring_init(&sensor_ring, sensor_ring_storage, SENSOR_RING_LEN, sizeof(event_t));
+    dispatch_lanes[LANE_SENSOR].ring = &sensor_ring;
+#endif
+    for (int i = 0; i < LANE_COUNT; i++) {
+        telemetry_counters_init(&dispatch_lanes[i].telemetry);
+        if (dispatch_lanes[i].ring != NULL) {
+            continue;
+        }
+#if EVENT_CHANNEL_MPMC
+        uint32_t capacity = 2;
+        while (capacity < dispatch_lanes[i].depth) {
+            capacity <<= 1;
+        }
+        dispatch_lanes[i].depth = capacity;
+        if (mpmc_queue_init(&lane_mpmc[i], lane_mpmc_storage[i], capacity, sizeof(event_t))) {
+            dispatch_lanes[i].queue = &lane_mpmc[i];
+        }
+#else
+        dispatch_lanes[i].queue = xQueueCreate(dispatch_lanes[i].depth, sizeof(event_t));
+#endif
+        lanes_ok = lanes_ok && dispatch_lanes[i].queue != NULL;
+    }
+
+    if (lanes_ok) {
+        ESP_LOGI(TAG, "Dispatch lanes created: %d classes x %u bytes/event%s",
+                LANE_COUNT, (unsigned)sizeof(event_t), EVENT_CHANNEL_MPMC ? " (MPMC)" : "");
+#elif USE_EVENT_CHANNEL
+    // One multiplexed channel replaces the individual queues and the queue set
+#if EVENT_CHANNEL_MPMC
+    if (mpmc_queue_init(&event_channel, event_channel_storage,
+                        EVENT_CHANNEL_MPMC_LEN, sizeof(event_t))) {
+        ESP_LOGI(TAG, "Event channel created (MPMC): %d x %u bytes",
+                EVENT_CHANNEL_MPMC_LEN, (unsigned)MPMC_QUEUE_CELL_SIZE(sizeof(event_t)));
+#else
+    telemetry_queue_init(&event_tq, "Events", EVENT_CHANNEL_LEN, sizeof(event_t),
+                         offsetof(event_t, enqueued_us));
+    xEventChannel = event_tq.queue;
+
+    if (xEventChannel) {
+        ESP_LOGI(TAG, "Event channel created: %d x %u bytes",
+                EVENT_CHANNEL_LEN, (unsigned)sizeof(event_t));
+#endif
+#else
     // Create individual queues
     xSensorQueue = xQueueCreate(5, sizeof(sensor_data_t));
     xUserQueue = xQueueCreate(3, sizeof(user_input_t));
-    xNetworkQueue = xQueueCreate(8, sizeof(network_message_t));
+    xNetworkQueue = xQueueCreate(NETWORK_QUEUE_LEN, NETWORK_QUEUE_ITEM_SIZE);
     xTimerSemaphore = xSemaphoreCreateBinary();
 
     // Create queue set (can hold references to all queues + semaphore)
-    xQueueSet = xQueueCreateSet(5 + 3 + 8 + 1); // Total capacity
+    xQueueSet = xQueueCreateSet(5 + 3 + NETWORK_QUEUE_LEN + 1); // Total capacity
 
     if (xSensorQueue && xUserQueue && xNetworkQueue && 
         xTimerSemaphore && xQueueSet) {
@@ -325,6 +1587,7 @@ void app_main(void) {
         }
 
         ESP_LOGI(TAG, "Queue set created and configured successfully");
+#endif
 
         // Create producer tasks
         xTaskCreate(sensor_task, "Sensor", 2048, NULL, 3, NULL);
@@ -333,11 +1596,16 @@ void app_main(void) {
         xTaskCreate(timer_task, "Timer", 2048, NULL, 2, NULL);
 
         // Create main processor task
-        xTaskCreate(processor_task, "Processor", 3072, NULL, 4, NULL);
+        xTaskCreate(processor_task, "Processor", 3072, NULL, 4, &processor_task_handle);
 
         // Create monitor task
         xTaskCreate(monitor_task, "Monitor", 2048, NULL, 1, NULL);
 
+#if USE_DEFERRED_LOG
+        // Formats the handlers' records whenever nothing more urgent runs
+        deferred_log_start(DEFERRED_LOG_PRIORITY, tskNO_AFFINITY, false);
+#endif
+
         ESP_LOGI(TAG, "All tasks created. System operational.");
 
         // LED startup sequence
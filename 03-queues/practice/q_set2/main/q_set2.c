@@ -9,6 +9,8 @@
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "telemetry_queue.h"
+#include "msg_ring.h"
 
 static const char *TAG = "QUEUE_SETS";
 
@@ -19,6 +21,18 @@ static const char *TAG = "QUEUE_SETS";
 #define LED_TIMER      GPIO_NUM_18
 #define LED_PROCESSOR  GPIO_NUM_19
 
+// Multiplexed event channel: one queue of tagged events (type + length +
+// payload) replaces the three queues, the semaphore and the queue set.
+// 0 = classic xQueueSelectFromSet processor
+#define USE_EVENT_CHANNEL       1
+#define EVENT_CHANNEL_LEN       (5 + 3 + 8 + 1)
+
+// Variable-length network records: network_task writes each message in place
+// into a length-prefixed byte ring, sized to its text, and only the record
+// pointer is queued. 0 = copy the whole network_message_t through the queue
+#define NETWORK_VARLEN          1
+#define NETWORK_RING_BYTES      512     // power of two
+
 // Queue handles
 QueueHandle_t xSensorQueue;
 QueueHandle_t xUserQueue;
@@ -28,6 +42,17 @@ SemaphoreHandle_t xTimerSemaphore;
 // Queue Set handle
 QueueSetHandle_t xQueueSet;
 
+// Multiplexed event channel handle
+QueueHandle_t xEventChannel;
+
+// Instrumented wrappers: depth high-water mark, failed sends by cause and
+// enqueue → dequeue latency. The raw handles above stay valid for the set
+#if USE_EVENT_CHANNEL
+static telemetry_queue_t event_tq;
+#else
+static telemetry_queue_t sensor_tq, user_tq, network_tq;
+#endif
+
 // Data structures for different message types
 typedef struct {
     int sensor_id;
@@ -48,14 +73,50 @@ typedef struct {
     int priority;
 } network_message_t;
 
+// Variable-length network record: source and message back to back, each
+// NUL-terminated, sized to the text actually sent
+typedef struct {
+    uint8_t priority;
+    uint8_t source_len;         // without the NUL
+    uint16_t message_len;
+    char text[];                // source "\0" message "\0"
+} network_record_t;
+
+#if NETWORK_VARLEN
+static msg_ring_t network_ring;
+static uint8_t network_ring_storage[NETWORK_RING_BYTES] __attribute__((aligned(4)));
+#define NETWORK_ITEM_SIZE       sizeof(network_record_t*)
+#else
+#define NETWORK_ITEM_SIZE       sizeof(network_message_t)
+#endif
+
 // Message type identifier
 typedef enum {
     MSG_SENSOR,
     MSG_USER,
     MSG_NETWORK,
-    MSG_TIMER
+    MSG_TIMER,
+    MSG_TYPE_COUNT
 } message_type_t;
 
+// Event channel item: small header followed by the payload of any type
+typedef struct {
+    uint8_t type;               // message_type_t
+    uint8_t reserved;
+    uint16_t length;            // payload bytes in use
+    union {
+        sensor_data_t sensor;
+        user_input_t user;
+#if NETWORK_VARLEN
+        network_record_t* network;
+#else
+        network_message_t network;
+#endif
+    } payload;
+} event_t;
+
+typedef void (*event_handler_t)(const void* payload);
+
 // Statistics
 typedef struct {
     uint32_t sensor_count;
@@ -66,6 +127,23 @@ typedef struct {
 
 message_stats_t stats = {0, 0, 0, 0};
 
+#if USE_EVENT_CHANNEL
+// ================ EVENT CHANNEL ================
+// Copy the payload behind a header; one xQueueSend per event of any type
+BaseType_t post_event(message_type_t type, const void* payload, uint16_t length,
+                      TickType_t wait) {
+    event_t event;
+
+    event.type     = (uint8_t)type;
+    event.reserved = 0;
+    event.length   = length;
+    if (length > 0) {
+        memcpy(&event.payload, payload, length);
+    }
+    return telemetry_queue_send(&event_tq, &event, wait);
+}
+#endif
+
 // Sensor simulation task
 void sensor_task(void *pvParameters) {
     sensor_data_t sensor_data;
@@ -80,7 +158,13 @@ void sensor_task(void *pvParameters) {
         sensor_data.humidity = 30.0 + (esp_random() % 400) / 10.0;    // 30-70%
         sensor_data.timestamp = xTaskGetTickCount();
 
-        if (xQueueSend(xSensorQueue, &sensor_data, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_SENSOR, &sensor_data, sizeof(sensor_data),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&sensor_tq, &sensor_data, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "📊 Sensor: T=%.1f°C, H=%.1f%%, ID=%d",
                      sensor_data.temperature, sensor_data.humidity, sensor_id);
 
@@ -107,7 +191,13 @@ void user_input_task(void *pvParameters) {
         user_input.pressed = true;
         user_input.duration_ms = 100 + (esp_random() % 1000); // 100-1100ms
 
-        if (xQueueSend(xUserQueue, &user_input, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_USER, &user_input, sizeof(user_input),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&user_tq, &user_input, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "🔘 User: Button %d pressed for %dms",
                      user_input.button_id, user_input.duration_ms);
 
@@ -124,7 +214,9 @@ void user_input_task(void *pvParameters) {
 
 // Network simulation task
 void network_task(void *pvParameters) {
+#if !NETWORK_VARLEN
     network_message_t network_msg;
+#endif
     const char* sources[]  = {"WiFi", "Bluetooth", "LoRa", "Ethernet"};
     const char* messages[] = {
         "Status update received",
@@ -138,13 +230,51 @@ void network_task(void *pvParameters) {
 
     while (1) {
         // Simulate network message
-        strcpy(network_msg.source,  sources[esp_random() % 4]);
-        strcpy(network_msg.message, messages[esp_random() % 5]);
-        network_msg.priority = 1 + (esp_random() % 5); // Priority 1-5
-
-        if (xQueueSend(xNetworkQueue, &network_msg, pdMS_TO_TICKS(100)) == pdPASS) {
-            ESP_LOGI(TAG, "🌐 Network [%s]: %s (P:%d)",
-                     network_msg.source, network_msg.message, network_msg.priority);
+        const char* source = sources[esp_random() % 4];
+        const char* text   = messages[esp_random() % 5];
+        int priority       = 1 + (esp_random() % 5); // Priority 1-5
+
+#if NETWORK_VARLEN
+        // Reserve exactly the bytes this message needs and write it in place;
+        // after a successful send the processor releases the record
+        size_t source_len  = strlen(source);
+        size_t message_len = strlen(text);
+        size_t record_len  = sizeof(network_record_t) + source_len + 1 + message_len + 1;
+        network_record_t* record = msg_ring_reserve(&network_ring, record_len);
+        if (record == NULL) {
+            ESP_LOGW(TAG, "Network ring full, message dropped");
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+        record->priority    = priority;
+        record->source_len  = source_len;
+        record->message_len = message_len;
+        memcpy(record->text, source, source_len + 1);
+        memcpy(record->text + source_len + 1, text, message_len + 1);
+        msg_ring_commit(&network_ring, record, record_len);
+
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &record, sizeof(record), pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&network_tq, &record, pdMS_TO_TICKS(100));
+#endif
+        if (sent != pdPASS) {
+            msg_ring_release(record);
+        }
+#else
+        strcpy(network_msg.source,  source);
+        strcpy(network_msg.message, text);
+        network_msg.priority = priority;
+
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &network_msg, sizeof(network_msg),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&network_tq, &network_msg, pdMS_TO_TICKS(100));
+#endif
+#endif
+        if (sent == pdPASS) {
+            ESP_LOGI(TAG, "🌐 Network [%s]: %s (P:%d)", source, text, priority);
 
             // Blink network LED
             gpio_set_level(LED_NETWORK, 1);
@@ -164,7 +294,12 @@ void timer_task(void *pvParameters) {
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(10000)); // Every 10 seconds
 
-        if (xSemaphoreGive(xTimerSemaphore) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_TIMER, NULL, 0, 0);
+#else
+        BaseType_t sent = xSemaphoreGive(xTimerSemaphore);
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "⏰ Timer: Periodic timer fired");
 
             // Blink timer LED
@@ -175,12 +310,120 @@ void timer_task(void *pvParameters) {
     }
 }
 
+// ================ EVENT HANDLERS ================
+// Shared by the queue-set processor and the event-channel dispatch table
+
+static void handle_sensor_event(const void* payload) {
+    const sensor_data_t* sensor_data = (const sensor_data_t*)payload;
+
+    stats.sensor_count++;
+    ESP_LOGI(TAG, "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%",
+             sensor_data->temperature, sensor_data->humidity);
+
+    // Simulate sensor data processing
+    if (sensor_data->temperature > 35.0) {
+        ESP_LOGW(TAG, "⚠️  High temperature alert!");
+    }
+    if (sensor_data->humidity > 60.0) {
+        ESP_LOGW(TAG, "⚠️  High humidity alert!");
+    }
+}
+
+static void handle_user_event(const void* payload) {
+    const user_input_t* user_input = (const user_input_t*)payload;
+
+    stats.user_count++;
+    ESP_LOGI(TAG, "→ Processing USER input: Button %d (%dms)",
+             user_input->button_id, user_input->duration_ms);
+
+    // Simulate user input processing
+    switch (user_input->button_id) {
+        case 1: ESP_LOGI(TAG, "💡 Action: Toggle LED"); break;
+        case 2: ESP_LOGI(TAG, "📊 Action: Show status"); break;
+        case 3: ESP_LOGI(TAG, "⚙️  Action: Settings menu"); break;
+    }
+}
+
+#if NETWORK_VARLEN
+// The payload is the record pointer: handle the message in place, then release the record
+static void handle_network_event(const void* payload) {
+    network_record_t* record = *(network_record_t* const*)payload;
+
+    stats.network_count++;
+    ESP_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s",
+             record->text, record->text + record->source_len + 1);
+
+    // Simulate network message processing
+    if (record->priority >= 4) {
+        ESP_LOGW(TAG, "🚨 High priority network message!");
+    }
+    msg_ring_release(record);
+}
+#else
+static void handle_network_event(const void* payload) {
+    const network_message_t* network_msg = (const network_message_t*)payload;
+
+    stats.network_count++;
+    ESP_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s",
+             network_msg->source, network_msg->message);
+
+    // Simulate network message processing
+    if (network_msg->priority >= 4) {
+        ESP_LOGW(TAG, "🚨 High priority network message!");
+    }
+}
+#endif
+
+static void handle_timer_event(const void* payload) {
+    stats.timer_count++;
+    ESP_LOGI(TAG, "→ Processing TIMER event: Periodic maintenance");
+
+    // Show system statistics
+    ESP_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu",
+             stats.sensor_count, stats.user_count,
+             stats.network_count, stats.timer_count);
+}
+
+#if USE_EVENT_CHANNEL
+static const event_handler_t event_handlers[MSG_TYPE_COUNT] = {
+    [MSG_SENSOR]  = handle_sensor_event,
+    [MSG_USER]    = handle_user_event,
+    [MSG_NETWORK] = handle_network_event,
+    [MSG_TIMER]   = handle_timer_event,
+};
+
+// Main processing task: one receive delivers one event of any type
+void processor_task(void *pvParameters) {
+    event_t event;
+
+    ESP_LOGI(TAG, "Processor task started - waiting for events...");
+
+    while (1) {
+        if (telemetry_queue_receive(&event_tq, &event, portMAX_DELAY) == pdPASS) {
+            gpio_set_level(LED_PROCESSOR, 1);
+
+            if (event.type < MSG_TYPE_COUNT) {
+                event_handlers[event.type](&event.payload);
+            } else {
+                ESP_LOGW(TAG, "Unknown event type %d (%u bytes)", event.type, event.length);
+            }
+
+            vTaskDelay(pdMS_TO_TICKS(200));  // simulate processing
+            gpio_set_level(LED_PROCESSOR, 0);
+        }
+    }
+}
+#else
 // Main processing task using Queue Sets
 void processor_task(void *pvParameters) {
     QueueSetMemberHandle_t xActivatedMember;
     sensor_data_t   sensor_data;
     user_input_t    user_input;
+#if NETWORK_VARLEN
+    network_record_t* network_msg;
+#else
     network_message_t network_msg;
+#endif
 
     ESP_LOGI(TAG, "Processor task started - waiting for events...");
 
@@ -194,55 +437,23 @@ void processor_task(void *pvParameters) {
 
             // Determine which queue/semaphore was activated
             if (xActivatedMember == xSensorQueue) {
-                if (xQueueReceive(xSensorQueue, &sensor_data, 0) == pdPASS) {
-                    stats.sensor_count++;
-                    ESP_LOGI(TAG, "→ Processing SENSOR data: T=%.1f°C, H=%.1f%%",
-                             sensor_data.temperature, sensor_data.humidity);
-
-                    // Simulate sensor data processing
-                    if (sensor_data.temperature > 35.0) {
-                        ESP_LOGW(TAG, "⚠️  High temperature alert!");
-                    }
-                    if (sensor_data.humidity > 60.0) {
-                        ESP_LOGW(TAG, "⚠️  High humidity alert!");
-                    }
+                if (telemetry_queue_receive(&sensor_tq, &sensor_data, 0) == pdPASS) {
+                    handle_sensor_event(&sensor_data);
                 }
             }
             else if (xActivatedMember == xUserQueue) {
-                if (xQueueReceive(xUserQueue, &user_input, 0) == pdPASS) {
-                    stats.user_count++;
-                    ESP_LOGI(TAG, "→ Processing USER input: Button %d (%dms)",
-                             user_input.button_id, user_input.duration_ms);
-
-                    // Simulate user input processing
-                    switch (user_input.button_id) {
-                        case 1: ESP_LOGI(TAG, "💡 Action: Toggle LED"); break;
-                        case 2: ESP_LOGI(TAG, "📊 Action: Show status"); break;
-                        case 3: ESP_LOGI(TAG, "⚙️  Action: Settings menu"); break;
-                    }
+                if (telemetry_queue_receive(&user_tq, &user_input, 0) == pdPASS) {
+                    handle_user_event(&user_input);
                 }
             }
             else if (xActivatedMember == xNetworkQueue) {
-                if (xQueueReceive(xNetworkQueue, &network_msg, 0) == pdPASS) {
-                    stats.network_count++;
-                    ESP_LOGI(TAG, "→ Processing NETWORK msg: [%s] %s",
-                             network_msg.source, network_msg.message);
-
-                    // Simulate network message processing
-                    if (network_msg.priority >= 4) {
-                        ESP_LOGW(TAG, "🚨 High priority network message!");
-                    }
+                if (telemetry_queue_receive(&network_tq, &network_msg, 0) == pdPASS) {
+                    handle_network_event(&network_msg);
                 }
             }
             else if (xActivatedMember == xTimerSemaphore) {
                 if (xSemaphoreTake(xTimerSemaphore, 0) == pdPASS) {
-                    stats.timer_count++;
-                    ESP_LOGI(TAG, "→ Processing TIMER event: Periodic maintenance");
-
-                    // Show system statistics
-                    ESP_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu",
-                             stats.sensor_count, stats.user_count,
-                             stats.network_count, stats.timer_count);
+                    handle_timer_event(NULL);
                 }
             }
 
@@ -254,6 +465,7 @@ void processor_task(void *pvParameters) {
         }
     }
 }
+#endif
 
 // System monitor task
 void monitor_task(void *pvParameters) {
@@ -264,12 +476,28 @@ void monitor_task(void *pvParameters) {
 
         ESP_LOGI(TAG, "\n═══ SYSTEM MONITOR ═══");
         ESP_LOGI(TAG, "Queue States:");
-        ESP_LOGI(TAG, "  Sensor Queue:  %d/%d",
-                 uxQueueMessagesWaiting(xSensorQueue), 5);
-        ESP_LOGI(TAG, "  User Queue:    %d/%d",
-                 uxQueueMessagesWaiting(xUserQueue), 3);
-        ESP_LOGI(TAG, "  Network Queue: %d/%d",
-                 uxQueueMessagesWaiting(xNetworkQueue), 8);
+#if USE_EVENT_CHANNEL
+        telemetry_queue_t* queues[] = { &event_tq };
+#else
+        telemetry_queue_t* queues[] = { &sensor_tq, &user_tq, &network_tq };
+#endif
+        for (size_t i = 0; i < sizeof(queues) / sizeof(queues[0]); i++) {
+            telemetry_snapshot_t snap;
+            telemetry_queue_snapshot(queues[i], &snap, false);
+            telemetry_snapshot_log(&snap, TAG);
+        }
+#if NETWORK_VARLEN
+        // Bytes the records actually took vs a fixed network_message_t slot each
+        ESP_LOGI(TAG, "  Network Ring: %lu/%d B used (peak %lu, full %lu)",
+                 msg_ring_used(&network_ring), NETWORK_RING_BYTES,
+                 network_ring.high_water, network_ring.full);
+        if (network_ring.records > 0) {
+            ESP_LOGI(TAG, "    %lu records, %lu B payload, %lu B of ring: %.1f B/msg vs %u B fixed slot",
+                     network_ring.records, network_ring.payload_bytes, network_ring.ring_bytes,
+                     (float)network_ring.ring_bytes / network_ring.records,
+                     (unsigned)sizeof(network_message_t));
+        }
+#endif
 
         ESP_LOGI(TAG, "Message Statistics:");
         ESP_LOGI(TAG, "  Sensor:  %lu messages",  stats.sensor_count);
@@ -297,10 +525,32 @@ void app_main(void) {
     gpio_set_level(LED_TIMER, 0);
     gpio_set_level(LED_PROCESSOR, 0);
 
+#if NETWORK_VARLEN
+    msg_ring_init(&network_ring, network_ring_storage, sizeof(network_ring_storage));
+#endif
+
+#if USE_EVENT_CHANNEL
+    // One multiplexed channel replaces the individual queues and the queue set
+    telemetry_queue_init(&event_tq, "Events", EVENT_CHANNEL_LEN, sizeof(event_t),
+                         TELEMETRY_STAMP_TRAILER);
+    xEventChannel = event_tq.queue;
+
+    if (xEventChannel) {
+        ESP_LOGI(TAG, "Event channel created: %d x %u bytes",
+                 EVENT_CHANNEL_LEN, (unsigned)sizeof(event_t));
+#if NETWORK_VARLEN
+        ESP_LOGI(TAG, "Network ring: %d B (fixed network slots would add %u B to every event)",
+                 NETWORK_RING_BYTES,
+                 (unsigned)(sizeof(network_message_t) - sizeof(network_record_t*)));
+#endif
+#else
     // Create individual queues
-    xSensorQueue     = xQueueCreate(5, sizeof(sensor_data_t));
-    xUserQueue       = xQueueCreate(3, sizeof(user_input_t));
-    xNetworkQueue    = xQueueCreate(8, sizeof(network_message_t));
+    telemetry_queue_init(&sensor_tq, "Sensor", 5, sizeof(sensor_data_t), TELEMETRY_STAMP_TRAILER);
+    xSensorQueue     = sensor_tq.queue;
+    telemetry_queue_init(&user_tq, "User", 3, sizeof(user_input_t), TELEMETRY_STAMP_TRAILER);
+    xUserQueue       = user_tq.queue;
+    telemetry_queue_init(&network_tq, "Network", 8, NETWORK_ITEM_SIZE, TELEMETRY_STAMP_TRAILER);
+    xNetworkQueue    = network_tq.queue;
     xTimerSemaphore  = xSemaphoreCreateBinary();
 
     // Create queue set (can hold references to all queues + semaphore)
@@ -320,6 +570,7 @@ void app_main(void) {
         }
 
         ESP_LOGI(TAG, "Queue set created and configured successfully");
+#endif
 
         // ===== Producers / Sources =====
         // ★ ทดลองที่ 2: ปิดใช้งานแหล่งข้อมูล Sensor (คอมเมนต์บรรทัดนี้)
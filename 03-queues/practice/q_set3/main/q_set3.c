@@ -9,6 +9,7 @@
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "telemetry_queue.h"
 
 static const char *TAG = "QUEUE_SETS";
 
@@ -19,6 +20,12 @@ static const char *TAG = "QUEUE_SETS";
 #define LED_TIMER      GPIO_NUM_18
 #define LED_PROCESSOR  GPIO_NUM_19
 
+// Multiplexed event channel: one queue of tagged events (type + length +
+// payload) replaces the three queues, the semaphore and the queue set.
+// 0 = classic xQueueSelectFromSet processor
+#define USE_EVENT_CHANNEL       1
+#define EVENT_CHANNEL_LEN       (5 + 3 + 8 + 1)
+
 // Queue handles
 QueueHandle_t xSensorQueue;
 QueueHandle_t xUserQueue;
@@ -28,6 +35,17 @@ SemaphoreHandle_t xTimerSemaphore;
 // Queue Set handle
 QueueSetHandle_t xQueueSet;
 
+// Multiplexed event channel handle
+QueueHandle_t xEventChannel;
+
+// Instrumented wrappers: depth high-water mark, failed sends by cause and
+// enqueue → dequeue latency. The raw handles above stay valid for the set
+#if USE_EVENT_CHANNEL
+static telemetry_queue_t event_tq;
+#else
+static telemetry_queue_t sensor_tq, user_tq, network_tq;
+#endif
+
 // ========== Data structures ==========
 typedef struct {
     int sensor_id;
@@ -48,7 +66,21 @@ typedef struct {
     int priority;
 } network_message_t;
 
-typedef enum { MSG_SENSOR, MSG_USER, MSG_NETWORK, MSG_TIMER } message_type_t;
+typedef enum { MSG_SENSOR, MSG_USER, MSG_NETWORK, MSG_TIMER, MSG_TYPE_COUNT } message_type_t;
+
+// Event channel item: small header followed by the payload of any type
+typedef struct {
+    uint8_t type;               // message_type_t
+    uint8_t reserved;
+    uint16_t length;            // payload bytes in use
+    union {
+        sensor_data_t sensor;
+        user_input_t user;
+        network_message_t network;
+    } payload;
+} event_t;
+
+typedef void (*event_handler_t)(const void* payload);
 
 typedef struct {
     uint32_t sensor_count;
@@ -59,6 +91,23 @@ typedef struct {
 
 message_stats_t stats = {0, 0, 0, 0};
 
+#if USE_EVENT_CHANNEL
+// ========== Event channel ==========
+// Copy the payload behind a header; one xQueueSend per event of any type
+BaseType_t post_event(message_type_t type, const void* payload, uint16_t length,
+                      TickType_t wait) {
+    event_t event;
+
+    event.type     = (uint8_t)type;
+    event.reserved = 0;
+    event.length   = length;
+    if (length > 0) {
+        memcpy(&event.payload, payload, length);
+    }
+    return telemetry_queue_send(&event_tq, &event, wait);
+}
+#endif
+
 // ========== Tasks ==========
 
 // (ยังมีให้เผื่อเปิดใช้ภายหลัง แต่ในทดลองนี้ปิดไม่สร้าง task)
@@ -72,7 +121,13 @@ void sensor_task(void *pvParameters) {
         sensor_data.humidity    = 30.0 + (esp_random() % 400) / 10.0; // 30-70%
         sensor_data.timestamp   = xTaskGetTickCount();
 
-        if (xQueueSend(xSensorQueue, &sensor_data, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_SENSOR, &sensor_data, sizeof(sensor_data),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&sensor_tq, &sensor_data, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "📊 Sensor: T=%.1f°C, H=%.1f%%, ID=%d",
                      sensor_data.temperature, sensor_data.humidity, sensor_id);
             gpio_set_level(LED_SENSOR, 1);
@@ -90,7 +145,13 @@ void user_input_task(void *pvParameters) {
         user_input.button_id  = 1 + (esp_random() % 3);        // 1..3
         user_input.pressed    = true;
         user_input.duration_ms= 100 + (esp_random() % 1000);   // 100..1100
-        if (xQueueSend(xUserQueue, &user_input, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_USER, &user_input, sizeof(user_input),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&user_tq, &user_input, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "🔘 User: Button %d pressed for %dms",
                      user_input.button_id, user_input.duration_ms);
             gpio_set_level(LED_USER, 1);
@@ -118,7 +179,13 @@ void network_task(void *pvParameters) {
         strcpy(network_msg.message, messages[esp_random() % 5]);
         network_msg.priority = 1 + (esp_random() % 5); // 1..5
 
-        if (xQueueSend(xNetworkQueue, &network_msg, pdMS_TO_TICKS(100)) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_NETWORK, &network_msg, sizeof(network_msg),
+                                     pdMS_TO_TICKS(100));
+#else
+        BaseType_t sent = telemetry_queue_send(&network_tq, &network_msg, pdMS_TO_TICKS(100));
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "🌐 Network [%s]: %s (P:%d)",
                      network_msg.source, network_msg.message, network_msg.priority);
             gpio_set_level(LED_NETWORK, 1);
@@ -135,7 +202,12 @@ void timer_task(void *pvParameters) {
     ESP_LOGI(TAG, "Timer task started");
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(10000)); // Every 10s
-        if (xSemaphoreGive(xTimerSemaphore) == pdPASS) {
+#if USE_EVENT_CHANNEL
+        BaseType_t sent = post_event(MSG_TIMER, NULL, 0, 0);
+#else
+        BaseType_t sent = xSemaphoreGive(xTimerSemaphore);
+#endif
+        if (sent == pdPASS) {
             ESP_LOGI(TAG, "⏰ Timer: Periodic timer fired");
             gpio_set_level(LED_TIMER, 1);
             vTaskDelay(pdMS_TO_TICKS(100));
@@ -144,6 +216,74 @@ void timer_task(void *pvParameters) {
     }
 }
 
+// ========== Event handlers (shared by queue set & event channel) ==========
+static void handle_sensor_event(const void* payload) {
+    const sensor_data_t* sensor_data = (const sensor_data_t*)payload;
+    stats.sensor_count++;
+    ESP_LOGI(TAG, "→ SENSOR: T=%.1f°C, H=%.1f%%",
+             sensor_data->temperature, sensor_data->humidity);
+    if (sensor_data->temperature > 35.0) ESP_LOGW(TAG, "⚠️  High temperature!");
+    if (sensor_data->humidity    > 60.0) ESP_LOGW(TAG, "⚠️  High humidity!");
+}
+
+static void handle_user_event(const void* payload) {
+    const user_input_t* user_input = (const user_input_t*)payload;
+    stats.user_count++;
+    ESP_LOGI(TAG, "→ USER: Button %d (%dms)",
+             user_input->button_id, user_input->duration_ms);
+    switch (user_input->button_id) {
+        case 1: ESP_LOGI(TAG, "💡 Toggle LED"); break;
+        case 2: ESP_LOGI(TAG, "📊 Show status"); break;
+        case 3: ESP_LOGI(TAG, "⚙️  Settings menu"); break;
+    }
+}
+
+static void handle_network_event(const void* payload) {
+    const network_message_t* network_msg = (const network_message_t*)payload;
+    stats.network_count++;
+    ESP_LOGI(TAG, "→ NETWORK: [%s] %s (P:%d)",
+             network_msg->source, network_msg->message, network_msg->priority);
+    if (network_msg->priority >= 4) ESP_LOGW(TAG, "🚨 High priority network!");
+}
+
+static void handle_timer_event(const void* payload) {
+    stats.timer_count++;
+    ESP_LOGI(TAG, "→ TIMER: Periodic maintenance");
+    ESP_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu",
+             stats.sensor_count, stats.user_count,
+             stats.network_count, stats.timer_count);
+}
+
+#if USE_EVENT_CHANNEL
+static const event_handler_t event_handlers[MSG_TYPE_COUNT] = {
+    [MSG_SENSOR]  = handle_sensor_event,
+    [MSG_USER]    = handle_user_event,
+    [MSG_NETWORK] = handle_network_event,
+    [MSG_TIMER]   = handle_timer_event,
+};
+
+// Main processing task: one receive delivers one event of any type
+void processor_task(void *pvParameters) {
+    event_t event;
+
+    ESP_LOGI(TAG, "Processor task started - waiting for events...");
+
+    while (1) {
+        if (telemetry_queue_receive(&event_tq, &event, portMAX_DELAY) == pdPASS) {
+            gpio_set_level(LED_PROCESSOR, 1);
+
+            if (event.type < MSG_TYPE_COUNT) {
+                event_handlers[event.type](&event.payload);
+            } else {
+                ESP_LOGW(TAG, "Unknown event type %d (%u bytes)", event.type, event.length);
+            }
+
+            vTaskDelay(pdMS_TO_TICKS(200));  // simulate processing
+            gpio_set_level(LED_PROCESSOR, 0);
+        }
+    }
+}
+#else
 void processor_task(void *pvParameters) {
     QueueSetMemberHandle_t xActivatedMember;
     sensor_data_t      sensor_data;
@@ -157,38 +297,20 @@ void processor_task(void *pvParameters) {
             gpio_set_level(LED_PROCESSOR, 1);
 
             if (xActivatedMember == xSensorQueue) {
-                if (xQueueReceive(xSensorQueue, &sensor_data, 0) == pdPASS) {
-                    stats.sensor_count++;
-                    ESP_LOGI(TAG, "→ SENSOR: T=%.1f°C, H=%.1f%%",
-                             sensor_data.temperature, sensor_data.humidity);
-                    if (sensor_data.temperature > 35.0) ESP_LOGW(TAG, "⚠️  High temperature!");
-                    if (sensor_data.humidity    > 60.0) ESP_LOGW(TAG, "⚠️  High humidity!");
+                if (telemetry_queue_receive(&sensor_tq, &sensor_data, 0) == pdPASS) {
+                    handle_sensor_event(&sensor_data);
                 }
             } else if (xActivatedMember == xUserQueue) {
-                if (xQueueReceive(xUserQueue, &user_input, 0) == pdPASS) {
-                    stats.user_count++;
-                    ESP_LOGI(TAG, "→ USER: Button %d (%dms)",
-                             user_input.button_id, user_input.duration_ms);
-                    switch (user_input.button_id) {
-                        case 1: ESP_LOGI(TAG, "💡 Toggle LED"); break;
-                        case 2: ESP_LOGI(TAG, "📊 Show status"); break;
-                        case 3: ESP_LOGI(TAG, "⚙️  Settings menu"); break;
-                    }
+                if (telemetry_queue_receive(&user_tq, &user_input, 0) == pdPASS) {
+                    handle_user_event(&user_input);
                 }
             } else if (xActivatedMember == xNetworkQueue) {
-                if (xQueueReceive(xNetworkQueue, &network_msg, 0) == pdPASS) {
-                    stats.network_count++;
-                    ESP_LOGI(TAG, "→ NETWORK: [%s] %s (P:%d)",
-                             network_msg.source, network_msg.message, network_msg.priority);
-                    if (network_msg.priority >= 4) ESP_LOGW(TAG, "🚨 High priority network!");
+                if (telemetry_queue_receive(&network_tq, &network_msg, 0) == pdPASS) {
+                    handle_network_event(&network_msg);
                 }
             } else if (xActivatedMember == xTimerSemaphore) {
                 if (xSemaphoreTake(xTimerSemaphore, 0) == pdPASS) {
-                    stats.timer_count++;
-                    ESP_LOGI(TAG, "→ TIMER: Periodic maintenance");
-                    ESP_LOGI(TAG, "📈 Stats - Sensor:%lu, User:%lu, Network:%lu, Timer:%lu",
-                             stats.sensor_count, stats.user_count,
-                             stats.network_count, stats.timer_count);
+                    handle_timer_event(NULL);
                 }
             }
 
@@ -197,6 +319,7 @@ void processor_task(void *pvParameters) {
         }
     }
 }
+#endif
 
 void monitor_task(void *pvParameters) {
     ESP_LOGI(TAG, "System monitor started");
@@ -204,9 +327,16 @@ void monitor_task(void *pvParameters) {
         vTaskDelay(pdMS_TO_TICKS(15000)); // Every 15s
         ESP_LOGI(TAG, "\n═══ SYSTEM MONITOR ═══");
         ESP_LOGI(TAG, "Queue States:");
-        ESP_LOGI(TAG, "  Sensor Queue:  %d/%d",  uxQueueMessagesWaiting(xSensorQueue), 5);
-        ESP_LOGI(TAG, "  User Queue:    %d/%d",  uxQueueMessagesWaiting(xUserQueue),   3);
-        ESP_LOGI(TAG, "  Network Queue: %d/%d",  uxQueueMessagesWaiting(xNetworkQueue),8);
+#if USE_EVENT_CHANNEL
+        telemetry_queue_t* queues[] = { &event_tq };
+#else
+        telemetry_queue_t* queues[] = { &sensor_tq, &user_tq, &network_tq };
+#endif
+        for (size_t i = 0; i < sizeof(queues) / sizeof(queues[0]); i++) {
+            telemetry_snapshot_t snap;
+            telemetry_queue_snapshot(queues[i], &snap, false);
+            telemetry_snapshot_log(&snap, TAG);
+        }
         ESP_LOGI(TAG, "Message Statistics:");
         ESP_LOGI(TAG, "  Sensor:  %lu messages",  stats.sensor_count);
         ESP_LOGI(TAG, "  User:    %lu messages",  stats.user_count);
@@ -233,10 +363,23 @@ void app_main(void) {
     gpio_set_level(LED_TIMER, 0);
     gpio_set_level(LED_PROCESSOR, 0);
 
+#if USE_EVENT_CHANNEL
+    // One multiplexed channel replaces the individual queues and the queue set
+    telemetry_queue_init(&event_tq, "Events", EVENT_CHANNEL_LEN, sizeof(event_t),
+                         TELEMETRY_STAMP_TRAILER);
+    xEventChannel = event_tq.queue;
+
+    if (xEventChannel) {
+        ESP_LOGI(TAG, "Event channel created: %d x %u bytes",
+                 EVENT_CHANNEL_LEN, (unsigned)sizeof(event_t));
+#else
     // Create queues & semaphore
-    xSensorQueue     = xQueueCreate(5, sizeof(sensor_data_t));
-    xUserQueue       = xQueueCreate(3, sizeof(user_input_t));
-    xNetworkQueue    = xQueueCreate(8, sizeof(network_message_t));
+    telemetry_queue_init(&sensor_tq, "Sensor", 5, sizeof(sensor_data_t), TELEMETRY_STAMP_TRAILER);
+    xSensorQueue     = sensor_tq.queue;
+    telemetry_queue_init(&user_tq, "User", 3, sizeof(user_input_t), TELEMETRY_STAMP_TRAILER);
+    xUserQueue       = user_tq.queue;
+    telemetry_queue_init(&network_tq, "Network", 8, sizeof(network_message_t), TELEMETRY_STAMP_TRAILER);
+    xNetworkQueue    = network_tq.queue;
     xTimerSemaphore  = xSemaphoreCreateBinary();
 
     // Queue set capacity = sum of member capacities
@@ -253,6 +396,7 @@ void app_main(void) {
         }
 
         ESP_LOGI(TAG, "Queue set created and configured successfully");
+#endif
 
         // === Create sources (Sensor ปิดไว้) ===
         // xTaskCreate(sensor_task, "Sensor", 2048, NULL, 3, NULL);   // ← ปิดใช้งานตามทดลอง 2
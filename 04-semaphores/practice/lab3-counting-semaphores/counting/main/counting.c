@@ -1,12 +1,20 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "esp_cpu.h"
+#include "mpmc_queue.h"
+#include "resource_pool.h"
+#include "resource_pool_metrics.h"
 
 static const char *TAG = "COUNTING_SEM";
 
@@ -22,8 +30,37 @@ static const char *TAG = "COUNTING_SEM";
 #define NUM_PRODUCERS 5  // Number of producer tasks
 #define NUM_CONSUMERS 3  // Number of consumer tasks
 
+// Many-producer scaling benchmark, run once at boot: xQueueSend/xQueueReceive
+// vs the lock-free MPMC queue for several producer/consumer counts, with the
+// tasks spread over both cores
+#define RUN_MPMC_BENCHMARK  1
+#define BENCH_ITEMS         20000
+#define BENCH_QUEUE_LEN     16      // power of two for the MPMC queue
+#define BENCH_PRIORITY      5
+
+// Resource pool: one atomic claim on a bitmap hands out a specific resource,
+// and requesters block on task notifications only while every bit is set.
+// 0 = counting semaphore followed by an unlocked scan of resources[]
+#define USE_RESOURCE_POOL   1
+
+// Sizing hint in the statistics: resources needed to serve the measured
+// demand at this utilisation
+#define POOL_TARGET_UTILISATION 0.7f
+
+// Acquire/release cost and fairness, pool vs semaphore + scan, run at boot
+#define RUN_POOL_BENCHMARK  1
+#define POOL_BENCH_LARGE    256     // resources for the cost test
+#define POOL_BENCH_OPS      10000
+#define POOL_BENCH_MS       1000    // contention test length
+#define POOL_BENCH_HOLD_US  20
+
+#if USE_RESOURCE_POOL
+static resource_pool_t resource_pool;
+static resource_pool_metrics_t resource_pool_metrics;
+#else
 // Semaphore handle
 SemaphoreHandle_t xCountingSemaphore;
+#endif
 
 // Resource management
 typedef struct {
@@ -46,11 +83,48 @@ typedef struct {
     uint32_t successful_acquisitions;
     uint32_t failed_acquisitions;
     uint32_t resources_in_use;
-    uint32_t average_wait_time;
+    uint32_t average_wait_time;     // ms
+    uint64_t total_wait_us;
 } system_stats_t;
 
-system_stats_t stats = {0, 0, 0, 0, 0};
+system_stats_t stats = {0, 0, 0, 0, 0, 0};
 
+#if USE_RESOURCE_POOL
+// Claim a free resource, waiting up to wait ticks; the bitmap makes the
+// index ours, so filling in resources[] needs no lock
+int take_resource(const char* user_name, TickType_t wait) {
+    int i = resource_pool_acquire(&resource_pool, wait);
+    if (i < 0) {
+        return -1;
+    }
+
+    strcpy(resources[i].current_user, user_name);
+    resources[i].in_use = true;
+    resources[i].usage_count++;
+
+    switch (i) {
+        case 0: gpio_set_level(LED_RESOURCE_1, 1); break;
+        case 1: gpio_set_level(LED_RESOURCE_2, 1); break;
+        case 2: gpio_set_level(LED_RESOURCE_3, 1); break;
+    }
+    return i;
+}
+
+void give_resource(int resource_index, uint32_t usage_time) {
+    resources[resource_index].in_use = false;
+    strcpy(resources[resource_index].current_user, "");
+    resources[resource_index].total_usage_time += usage_time;
+
+    switch (resource_index) {
+        case 0: gpio_set_level(LED_RESOURCE_1, 0); break;
+        case 1: gpio_set_level(LED_RESOURCE_2, 0); break;
+        case 2: gpio_set_level(LED_RESOURCE_3, 0); break;
+    }
+
+    // Publish last: the next owner may start writing right after
+    resource_pool_release(&resource_pool, resource_index);
+}
+#else
 // Find available resource and mark as in use
 int acquire_resource(const char* user_name) {
     for (int i = 0; i < MAX_RESOURCES; i++) {
@@ -91,6 +165,26 @@ void release_resource(int resource_index, uint32_t usage_time) {
     }
 }
 
+// Counting semaphore first, then scan for the slot it stands for
+int take_resource(const char* user_name, TickType_t wait) {
+    if (xSemaphoreTake(xCountingSemaphore, wait) != pdTRUE) {
+        return -1;
+    }
+
+    int resource_idx = acquire_resource(user_name);
+    if (resource_idx < 0) {
+        ESP_LOGE(TAG, "✗ %s: Semaphore acquired but no resource available!", user_name);
+        xSemaphoreGive(xCountingSemaphore); // Give back immediately
+    }
+    return resource_idx;
+}
+
+void give_resource(int resource_index, uint32_t usage_time) {
+    release_resource(resource_index, usage_time);
+    xSemaphoreGive(xCountingSemaphore);
+}
+#endif
+
 // Producer task - requests resources
 void producer_task(void *pvParameters) {
     int producer_id = *((int*)pvParameters);
@@ -109,38 +203,30 @@ void producer_task(void *pvParameters) {
         vTaskDelay(pdMS_TO_TICKS(50));
         gpio_set_level(LED_PRODUCER, 0);
 
-        uint32_t start_time = xTaskGetTickCount();
-
-        // Try to acquire counting semaphore (resource from pool)
-        if (xSemaphoreTake(xCountingSemaphore, pdMS_TO_TICKS(8000)) == pdTRUE) {
-            uint32_t wait_time = (xTaskGetTickCount() - start_time) * portTICK_PERIOD_MS;
-            stats.successful_acquisitions++;
-
-            // Acquire actual resource
-            int resource_idx = acquire_resource(task_name);
+        int64_t start_us = esp_timer_get_time();
 
-            if (resource_idx >= 0) {
-                ESP_LOGI(TAG, "✓ %s: Acquired resource %d (wait: %lums)", 
-                        task_name, resource_idx + 1, wait_time);
+        // Try to acquire a resource from the pool
+        int resource_idx = take_resource(task_name, pdMS_TO_TICKS(8000));
 
-                // Simulate resource usage
-                uint32_t usage_time = 1000 + (esp_random() % 3000); // 1-4 seconds
-                ESP_LOGI(TAG, "🔧 %s: Using resource %d for %lums", 
-                        task_name, resource_idx + 1, usage_time);
+        if (resource_idx >= 0) {
+            int64_t wait_us = esp_timer_get_time() - start_us;
+            uint32_t wait_time = wait_us / 1000;
+            stats.total_wait_us += wait_us;
+            stats.successful_acquisitions++;
 
-                vTaskDelay(pdMS_TO_TICKS(usage_time));
+            ESP_LOGI(TAG, "✓ %s: Acquired resource %d (wait: %lums)", 
+                    task_name, resource_idx + 1, wait_time);
 
-                // Release resource
-                release_resource(resource_idx, usage_time);
-                ESP_LOGI(TAG, "✓ %s: Released resource %d", task_name, resource_idx + 1);
+            // Simulate resource usage
+            uint32_t usage_time = 1000 + (esp_random() % 3000); // 1-4 seconds
+            ESP_LOGI(TAG, "🔧 %s: Using resource %d for %lums", 
+                    task_name, resource_idx + 1, usage_time);
 
-                // Give back semaphore
-                xSemaphoreGive(xCountingSemaphore);
+            vTaskDelay(pdMS_TO_TICKS(usage_time));
 
-            } else {
-                ESP_LOGE(TAG, "✗ %s: Semaphore acquired but no resource available!", task_name);
-                xSemaphoreGive(xCountingSemaphore); // Give back immediately
-            }
+            // Release resource
+            give_resource(resource_idx, usage_time);
+            ESP_LOGI(TAG, "✓ %s: Released resource %d", task_name, resource_idx + 1);
 
         } else {
             stats.failed_acquisitions++;
@@ -159,7 +245,11 @@ void resource_monitor_task(void *pvParameters) {
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(5000)); // Every 5 seconds
 
+#if USE_RESOURCE_POOL
+        int available_count = MAX_RESOURCES - resource_pool_in_use(&resource_pool);
+#else
         int available_count = uxSemaphoreGetCount(xCountingSemaphore);
+#endif
         int used_count = MAX_RESOURCES - available_count;
 
         ESP_LOGI(TAG, "\n📊 RESOURCE POOL STATUS");
@@ -199,12 +289,30 @@ void statistics_task(void *pvParameters) {
         ESP_LOGI(TAG, "Total requests: %lu", stats.total_requests);
         ESP_LOGI(TAG, "Successful acquisitions: %lu", stats.successful_acquisitions);
         ESP_LOGI(TAG, "Failed acquisitions: %lu", stats.failed_acquisitions);
+#if USE_RESOURCE_POOL
+        stats.resources_in_use = resource_pool_in_use(&resource_pool);
+#endif
         ESP_LOGI(TAG, "Current resources in use: %lu", stats.resources_in_use);
 
         if (stats.total_requests > 0) {
             float success_rate = (float)stats.successful_acquisitions / stats.total_requests * 100;
             ESP_LOGI(TAG, "Success rate: %.1f%%", success_rate);
         }
+        if (stats.successful_acquisitions > 0) {
+            stats.average_wait_time = stats.total_wait_us / stats.successful_acquisitions / 1000;
+        }
+        ESP_LOGI(TAG, "Average wait time: %lums", stats.average_wait_time);
+
+#if USE_RESOURCE_POOL
+        // Per-task wait/hold percentiles over the last window
+        static resource_pool_report_t report;
+        resource_pool_metrics_snapshot(&resource_pool, &report, true);
+        ESP_LOGI(TAG, "Wait and hold times (last %.0f s):", report.window_us / 1e6f);
+        resource_pool_report_log(&report, TAG);
+        ESP_LOGI(TAG, "Sizing: offered load %.2f → MAX_RESOURCES %d for %.0f%% utilisation (now %d)",
+                 report.offered_load, (int)ceilf(report.offered_load / POOL_TARGET_UTILISATION),
+                 POOL_TARGET_UTILISATION * 100, MAX_RESOURCES);
+#endif
 
         // Resource utilization statistics
         ESP_LOGI(TAG, "Resource utilization:");
@@ -237,15 +345,12 @@ void load_generator_task(void *pvParameters) {
 
             // Try to acquire all resources quickly
             for (int i = 0; i < MAX_RESOURCES + 2; i++) {
-                if (xSemaphoreTake(xCountingSemaphore, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    int res_idx = acquire_resource("LoadGen");
-                    if (res_idx >= 0) {
-                        ESP_LOGI(TAG, "LoadGen: Acquired resource %d", res_idx + 1);
-                        vTaskDelay(pdMS_TO_TICKS(500)); // Hold briefly
-                        release_resource(res_idx, 500);
-                        ESP_LOGI(TAG, "LoadGen: Released resource %d", res_idx + 1);
-                    }
-                    xSemaphoreGive(xCountingSemaphore);
+                int res_idx = take_resource("LoadGen", pdMS_TO_TICKS(100));
+                if (res_idx >= 0) {
+                    ESP_LOGI(TAG, "LoadGen: Acquired resource %d", res_idx + 1);
+                    vTaskDelay(pdMS_TO_TICKS(500)); // Hold briefly
+                    give_resource(res_idx, 500);
+                    ESP_LOGI(TAG, "LoadGen: Released resource %d", res_idx + 1);
                 } else {
                     ESP_LOGW(TAG, "LoadGen: Resource pool exhausted");
                 }
@@ -259,9 +364,306 @@ void load_generator_task(void *pvParameters) {
     }
 }
 
+#if RUN_MPMC_BENCHMARK
+// ================ MPMC SCALING BENCHMARK ================
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} bench_item_t;
+
+typedef struct {
+    bool use_mpmc;
+    uint32_t per_producer;
+    uint32_t total;
+    QueueHandle_t queue;
+    mpmc_queue_t mpmc;
+    uint8_t storage[MPMC_QUEUE_STORAGE_SIZE(BENCH_QUEUE_LEN, sizeof(bench_item_t))];
+    atomic_uint received;
+    atomic_uint checksum;       // sum of seq, to catch lost or duplicated items
+    int64_t end_us;
+    TaskHandle_t waiter;
+} bench_t;
+
+static bench_t bench;
+
+static void bench_producer_task(void *pvParameters) {
+    bench_item_t item = { .producer = (uint32_t)(uintptr_t)pvParameters };
+
+    for (item.seq = 0; item.seq < bench.per_producer; item.seq++) {
+        if (bench.use_mpmc) {
+            mpmc_queue_send(&bench.mpmc, &item, portMAX_DELAY);
+        } else {
+            xQueueSend(bench.queue, &item, portMAX_DELAY);
+        }
+    }
+    xTaskNotifyGive(bench.waiter);
+    vTaskDelete(NULL);
+}
+
+static void bench_consumer_task(void *pvParameters) {
+    bench_item_t item;
+
+    // Short timeout: once the last item is taken the other consumers stay
+    // blocked, so each one re-checks the shared count periodically
+    while (atomic_load(&bench.received) < bench.total) {
+        bool got = bench.use_mpmc
+            ? mpmc_queue_receive(&bench.mpmc, &item, pdMS_TO_TICKS(20))
+            : xQueueReceive(bench.queue, &item, pdMS_TO_TICKS(20)) == pdTRUE;
+        if (got) {
+            atomic_fetch_add(&bench.checksum, item.seq);
+            if (atomic_fetch_add(&bench.received, 1) + 1 == bench.total) {
+                bench.end_us = esp_timer_get_time();
+            }
+        }
+    }
+    xTaskNotifyGive(bench.waiter);
+    vTaskDelete(NULL);
+}
+
+// Producers start on core 0 and consumers on core 1, then alternate
+static float bench_run(bool use_mpmc, int producers, int consumers) {
+    memset(&bench, 0, sizeof(bench));
+    bench.use_mpmc = use_mpmc;
+    bench.per_producer = BENCH_ITEMS / producers;
+    bench.total = bench.per_producer * producers;
+    bench.waiter = xTaskGetCurrentTaskHandle();
+    if (use_mpmc) {
+        mpmc_queue_init(&bench.mpmc, bench.storage, BENCH_QUEUE_LEN, sizeof(bench_item_t));
+    } else {
+        bench.queue = xQueueCreate(BENCH_QUEUE_LEN, sizeof(bench_item_t));
+        if (bench.queue == NULL) {
+            return 0;
+        }
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < consumers; i++) {
+        xTaskCreatePinnedToCore(bench_consumer_task, "BenchRx", 2048, NULL,
+                                BENCH_PRIORITY, NULL, (i + 1) % 2);
+    }
+    for (int i = 0; i < producers; i++) {
+        xTaskCreatePinnedToCore(bench_producer_task, "BenchTx", 2048, (void*)(uintptr_t)i,
+                                BENCH_PRIORITY, NULL, i % 2);
+    }
+    for (int i = 0; i < producers + consumers; i++) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+
+    uint32_t expected = producers * (bench.per_producer * (bench.per_producer - 1) / 2);
+    if (atomic_load(&bench.checksum) != expected) {
+        ESP_LOGE(TAG, "Benchmark checksum mismatch (%s)", use_mpmc ? "MPMC" : "xQueue");
+    }
+    if (!use_mpmc) {
+        vQueueDelete(bench.queue);
+    }
+    return bench.total * 1e6f / (float)(bench.end_us - start);
+}
+
+static void benchmark_mpmc(void) {
+    static const int configs[][2] = {
+        {1, 1}, {2, 1}, {NUM_PRODUCERS, 1}, {2, 2}, {NUM_PRODUCERS, NUM_CONSUMERS},
+    };
+
+    ESP_LOGI(TAG, "MPMC scaling benchmark: %d items, depth %d", BENCH_ITEMS, BENCH_QUEUE_LEN);
+    ESP_LOGI(TAG, "  P x C    xQueue items/s    MPMC items/s    speed-up");
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        int producers = configs[i][0];
+        int consumers = configs[i][1];
+        float queue_rate = bench_run(false, producers, consumers);
+        float mpmc_rate = bench_run(true, producers, consumers);
+        ESP_LOGI(TAG, "  %d x %d    %14.0f  %14.0f    %6.2fx (sleeps %u, wakeups %u)",
+                 producers, consumers, queue_rate, mpmc_rate,
+                 queue_rate > 0 ? mpmc_rate / queue_rate : 0.0f,
+                 (unsigned)bench.mpmc.sleeps, (unsigned)bench.mpmc.wakeups);
+    }
+}
+#endif
+
+#if RUN_POOL_BENCHMARK
+// ================ RESOURCE POOL BENCHMARK ================
+// Both paths hand out slots of the same size; holders[] counts owners per
+// slot so a claim that overlaps another shows up as a double claim
+typedef struct {
+    bool use_pool;
+    uint32_t capacity;
+    resource_pool_t pool;
+    SemaphoreHandle_t sem;
+    volatile bool in_use[POOL_BENCH_LARGE];
+    atomic_uint holders[POOL_BENCH_LARGE];
+    atomic_uint misses;         // semaphore taken but the scan found nothing
+    atomic_uint double_claims;
+    int64_t stop_us;
+    uint32_t ops[NUM_PRODUCERS];
+    TaskHandle_t waiter;
+} pool_bench_t;
+
+static pool_bench_t pool_bench;
+
+// The semaphore + scan pair that take_resource() used before the pool
+static int legacy_acquire(TickType_t wait) {
+    if (xSemaphoreTake(pool_bench.sem, wait) != pdTRUE) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < pool_bench.capacity; i++) {
+        if (!pool_bench.in_use[i]) {
+            pool_bench.in_use[i] = true;
+            return i;
+        }
+    }
+    atomic_fetch_add(&pool_bench.misses, 1);
+    xSemaphoreGive(pool_bench.sem);
+    return -1;
+}
+
+static void legacy_release(int i) {
+    pool_bench.in_use[i] = false;
+    xSemaphoreGive(pool_bench.sem);
+}
+
+static int bench_acquire(TickType_t wait) {
+    return pool_bench.use_pool ? resource_pool_acquire(&pool_bench.pool, wait)
+                               : legacy_acquire(wait);
+}
+
+static void bench_release(int i) {
+    if (pool_bench.use_pool) {
+        resource_pool_release(&pool_bench.pool, i);
+    } else {
+        legacy_release(i);
+    }
+}
+
+static bool pool_bench_setup(bool use_pool, uint32_t capacity) {
+    memset(&pool_bench, 0, sizeof(pool_bench));
+    pool_bench.use_pool = use_pool;
+    pool_bench.capacity = capacity;
+    pool_bench.waiter = xTaskGetCurrentTaskHandle();
+    if (use_pool) {
+        return resource_pool_init(&pool_bench.pool, capacity);
+    }
+    pool_bench.sem = xSemaphoreCreateCounting(capacity, capacity);
+    return pool_bench.sem != NULL;
+}
+
+static void pool_bench_teardown(void) {
+    if (pool_bench.sem != NULL) {
+        vSemaphoreDelete(pool_bench.sem);
+    }
+}
+
+// Cycles for one uncontended acquire + release with held slots already taken
+static uint32_t pool_bench_cost(bool use_pool, uint32_t held) {
+    if (!pool_bench_setup(use_pool, POOL_BENCH_LARGE)) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < held; i++) {
+        bench_acquire(0);
+    }
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int i = 0; i < POOL_BENCH_OPS; i++) {
+        bench_release(bench_acquire(0));
+    }
+    uint32_t cycles = (esp_cpu_get_cycle_count() - start) / POOL_BENCH_OPS;
+
+    pool_bench_teardown();
+    return cycles;
+}
+
+static void pool_bench_task(void *pvParameters) {
+    int id = (int)(uintptr_t)pvParameters;
+
+    while (esp_timer_get_time() < pool_bench.stop_us) {
+        int i = bench_acquire(pdMS_TO_TICKS(100));
+        if (i < 0) {
+            continue;
+        }
+        if (atomic_fetch_add(&pool_bench.holders[i], 1) != 0) {
+            atomic_fetch_add(&pool_bench.double_claims, 1);
+        }
+
+        int64_t hold_until = esp_timer_get_time() + POOL_BENCH_HOLD_US;
+        while (esp_timer_get_time() < hold_until) {
+        }
+
+        atomic_fetch_sub(&pool_bench.holders[i], 1);
+        bench_release(i);
+        pool_bench.ops[id]++;
+    }
+    xTaskNotifyGive(pool_bench.waiter);
+    vTaskDelete(NULL);
+}
+
+// NUM_PRODUCERS tasks over both cores share MAX_RESOURCES slots for
+// POOL_BENCH_MS; fairness is Jain's index over the per-task counts
+static void pool_bench_contention(bool use_pool) {
+    if (!pool_bench_setup(use_pool, MAX_RESOURCES)) {
+        return;
+    }
+    pool_bench.stop_us = esp_timer_get_time() + POOL_BENCH_MS * 1000LL;
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        xTaskCreatePinnedToCore(pool_bench_task, "PoolBench", 2048, (void*)(uintptr_t)i,
+                                BENCH_PRIORITY, NULL, i % 2);
+    }
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+
+    uint32_t total = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    float sum_sq = 0;
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        uint32_t n = pool_bench.ops[i];
+        total += n;
+        sum_sq += (float)n * n;
+        if (n < min) min = n;
+        if (n > max) max = n;
+    }
+    float jain = sum_sq > 0 ? (float)total * total / (NUM_PRODUCERS * sum_sq) : 0;
+
+    ESP_LOGI(TAG, "  %-13s %8lu ops/s  per task %lu..%lu  Jain %.3f  double claims %u, misses %u",
+             use_pool ? "bitmap pool" : "sem + scan",
+             total * 1000 / POOL_BENCH_MS, min, max, jain,
+             (unsigned)pool_bench.double_claims, (unsigned)pool_bench.misses);
+    if (use_pool) {
+        ESP_LOGI(TAG, "  pool: %u CAS retries, %u sleeps",
+                 (unsigned)pool_bench.pool.cas_retries, (unsigned)pool_bench.pool.sleeps);
+    }
+    pool_bench_teardown();
+}
+
+static void benchmark_resource_pool(void) {
+    float us_per_cycle = 1.0f / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+
+    ESP_LOGI(TAG, "Resource pool benchmark: %d resources, %d acquire/release pairs",
+             POOL_BENCH_LARGE, POOL_BENCH_OPS);
+    ESP_LOGI(TAG, "  held    sem + scan         bitmap pool");
+    static const uint32_t held[] = { 0, POOL_BENCH_LARGE / 2, POOL_BENCH_LARGE - 1 };
+    for (size_t i = 0; i < sizeof(held) / sizeof(held[0]); i++) {
+        uint32_t legacy = pool_bench_cost(false, held[i]);
+        uint32_t pool = pool_bench_cost(true, held[i]);
+        ESP_LOGI(TAG, "  %4lu    %5lu cyc (%.2f us)  %5lu cyc (%.2f us)", held[i],
+                 legacy, legacy * us_per_cycle, pool, pool * us_per_cycle);
+    }
+
+    ESP_LOGI(TAG, "Contention: %d tasks, %d resources, %d us hold, %d ms",
+             NUM_PRODUCERS, MAX_RESOURCES, POOL_BENCH_HOLD_US, POOL_BENCH_MS);
+    pool_bench_contention(false);
+    pool_bench_contention(true);
+}
+#endif
+
 void app_main(void) {
     ESP_LOGI(TAG, "Counting Semaphores Lab Starting...");
 
+#if RUN_MPMC_BENCHMARK
+    benchmark_mpmc();
+#endif
+#if RUN_POOL_BENCHMARK
+    benchmark_resource_pool();
+#endif
+
     // Configure LED pins
     gpio_set_direction(LED_RESOURCE_1, GPIO_MODE_OUTPUT);
     gpio_set_direction(LED_RESOURCE_2, GPIO_MODE_OUTPUT);
@@ -276,11 +678,18 @@ void app_main(void) {
     gpio_set_level(LED_PRODUCER, 0);
     gpio_set_level(LED_SYSTEM, 0);
 
+#if USE_RESOURCE_POOL
+    // Resource pool (every bit clear = every resource free)
+    if (resource_pool_init(&resource_pool, MAX_RESOURCES)) {
+        resource_pool_attach_metrics(&resource_pool, &resource_pool_metrics);
+        ESP_LOGI(TAG, "Resource pool created (%d resources)", MAX_RESOURCES);
+#else
     // Create counting semaphore (initial count = max resources)
     xCountingSemaphore = xSemaphoreCreateCounting(MAX_RESOURCES, MAX_RESOURCES);
 
     if (xCountingSemaphore != NULL) {
         ESP_LOGI(TAG, "Counting semaphore created (max count: %d)", MAX_RESOURCES);
+#endif
 
         // Producer task IDs (must be static for task parameters)
         static int producer_ids[NUM_PRODUCERS] = {1, 2, 3, 4, 5};
@@ -294,13 +703,13 @@ void app_main(void) {
 
         // Create monitoring tasks
         xTaskCreate(resource_monitor_task, "ResMonitor", 3072, NULL, 2, NULL);
-        xTaskCreate(statistics_task, "Statistics", 3072, NULL, 1, NULL);
+        xTaskCreate(statistics_task, "Statistics", 4096, NULL, 1, NULL);
         xTaskCreate(load_generator_task, "LoadGen", 2048, NULL, 4, NULL);
 
         ESP_LOGI(TAG, "System created with:");
         ESP_LOGI(TAG, "  Resources: %d", MAX_RESOURCES);
         ESP_LOGI(TAG, "  Producers: %d", NUM_PRODUCERS);
-        ESP_LOGI(TAG, "  Initial semaphore count: %d", MAX_RESOURCES);
+        ESP_LOGI(TAG, "  Initial free resources: %d", MAX_RESOURCES);
         ESP_LOGI(TAG, "\nSystem operational - monitoring resource pool usage!");
 
         // LED startup sequence
@@ -325,6 +734,6 @@ void app_main(void) {
         }
 
     } else {
-        ESP_LOGE(TAG, "Failed to create counting semaphore!");
+        ESP_LOGE(TAG, "Failed to create the resource pool!");
     }
 }
\ No newline at end of file
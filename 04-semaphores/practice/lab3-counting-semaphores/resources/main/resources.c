@@ -2,12 +2,15 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "resource_pool.h"
+#include "resource_pool_metrics.h"
 
 static const char *TAG = "COUNTING_SEM_EXP2";
 
@@ -27,8 +30,21 @@ static const char *TAG = "COUNTING_SEM_EXP2";
 #define NUM_PRODUCERS 5
 #define NUM_CONSUMERS 3   // (ยังไม่ได้ใช้ แต่อาจใช้ต่อยอดได้)
 
+/* ===== Resource pool =====
+ * 1 = จองผ่าน bitmap ของ resource_pool: CAS ครั้งเดียวได้ทั้ง "สิทธิ์" และ "หมายเลข resource"
+ *     task ที่ต้องรอจะเข้าคิวแบบ FIFO และถูกปลุกด้วย task notification
+ * 0 = แบบเดิม: counting semaphore แล้วค่อยวนหา resource ที่ว่าง
+ */
+#define USE_RESOURCE_POOL 1
+#define POOL_TARGET_UTILISATION 0.7f   // ใช้คำนวณจำนวน resource ที่แนะนำจาก demand ที่วัดได้
+
+#if USE_RESOURCE_POOL
+static resource_pool_t resource_pool;
+static resource_pool_metrics_t resource_pool_metrics;   // เวลา wait/hold ราย task (µs)
+#else
 /* ===== Counting semaphore ===== */
 static SemaphoreHandle_t xCountingSemaphore;
+#endif
 
 /* ===== Resource management ===== */
 typedef struct {
@@ -69,6 +85,30 @@ static inline void set_resource_led(int idx, int on) {
     }
 }
 
+#if USE_RESOURCE_POOL
+/* ===== Take / give resource ===== */
+// bit ใน bitmap เป็นของเราแล้ว จึงเขียน resources[i] ได้โดยไม่ต้องล็อก
+static int take_resource(const char* user_name, TickType_t wait) {
+    int i = resource_pool_acquire(&resource_pool, wait);
+    if (i < 0) return -1;
+
+    resources[i].in_use = true;
+    strncpy(resources[i].current_user, user_name, sizeof(resources[i].current_user)-1);
+    resources[i].current_user[sizeof(resources[i].current_user)-1] = '\0';
+    resources[i].usage_count++;
+    set_resource_led(i, 1);
+    return i;
+}
+
+static void give_resource(int resource_index, uint32_t usage_time_ms) {
+    resources[resource_index].in_use = false;
+    resources[resource_index].total_usage_time += usage_time_ms;
+    resources[resource_index].current_user[0] = '\0';
+    set_resource_led(resource_index, 0);
+    // คืน bit เป็นขั้นตอนสุดท้าย เพราะเจ้าของคนถัดไปเริ่มเขียนได้ทันที
+    resource_pool_release(&resource_pool, resource_index);
+}
+#else
 /* ===== Acquire an available resource ===== */
 static int acquire_resource(const char* user_name) {
     for (int i = 0; i < MAX_RESOURCES; i++) {
@@ -96,6 +136,24 @@ static void release_resource(int resource_index, uint32_t usage_time_ms) {
     }
 }
 
+/* ===== Take / give resource ===== */
+static int take_resource(const char* user_name, TickType_t wait) {
+    if (xSemaphoreTake(xCountingSemaphore, wait) != pdTRUE) return -1;
+
+    int res_idx = acquire_resource(user_name);
+    if (res_idx < 0) {
+        ESP_LOGE(TAG, "✗ %s: Semaphore acquired but no resource available!", user_name);
+        xSemaphoreGive(xCountingSemaphore);
+    }
+    return res_idx;
+}
+
+static void give_resource(int resource_index, uint32_t usage_time_ms) {
+    release_resource(resource_index, usage_time_ms);
+    xSemaphoreGive(xCountingSemaphore);
+}
+#endif
+
 /* ===== Producer task ===== */
 static void producer_task(void *pvParameters) {
     int producer_id = *((int*)pvParameters);
@@ -114,27 +172,22 @@ static void producer_task(void *pvParameters) {
         ESP_LOGI(TAG, "🏭 %s: Requesting resource...", task_name);
         TickType_t t0 = xTaskGetTickCount();
 
-        if (xSemaphoreTake(xCountingSemaphore, pdMS_TO_TICKS(8000)) == pdTRUE) {
+        int res_idx = take_resource(task_name, pdMS_TO_TICKS(8000));
+        if (res_idx >= 0) {
             uint32_t wait_ms = (xTaskGetTickCount() - t0) * portTICK_PERIOD_MS;
             stats.successful_acquisitions++;
 
-            int res_idx = acquire_resource(task_name);
-            if (res_idx >= 0) {
-                ESP_LOGI(TAG, "✓ %s: Acquired resource %d (wait: %lums)",
-                         task_name, res_idx + 1, wait_ms);
+            ESP_LOGI(TAG, "✓ %s: Acquired resource %d (wait: %lums)",
+                     task_name, res_idx + 1, wait_ms);
 
-                uint32_t use_ms = 1000 + (esp_random() % 3000); // 1–4s
-                ESP_LOGI(TAG, "🔧 %s: Using resource %d for %lums",
-                         task_name, res_idx + 1, use_ms);
+            uint32_t use_ms = 1000 + (esp_random() % 3000); // 1–4s
+            ESP_LOGI(TAG, "🔧 %s: Using resource %d for %lums",
+                     task_name, res_idx + 1, use_ms);
 
-                vTaskDelay(pdMS_TO_TICKS(use_ms));
+            vTaskDelay(pdMS_TO_TICKS(use_ms));
 
-                release_resource(res_idx, use_ms);
-                ESP_LOGI(TAG, "✓ %s: Released resource %d", task_name, res_idx + 1);
-            } else {
-                ESP_LOGE(TAG, "✗ %s: Semaphore acquired but no resource available!", task_name);
-            }
-            xSemaphoreGive(xCountingSemaphore);
+            give_resource(res_idx, use_ms);
+            ESP_LOGI(TAG, "✓ %s: Released resource %d", task_name, res_idx + 1);
         } else {
             stats.failed_acquisitions++;
             ESP_LOGW(TAG, "⏰ %s: Timeout waiting for resource", task_name);
@@ -150,7 +203,11 @@ static void resource_monitor_task(void *pvParameters) {
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(5000));
 
+#if USE_RESOURCE_POOL
+        int available = MAX_RESOURCES - (int)resource_pool_in_use(&resource_pool);
+#else
         int available = uxSemaphoreGetCount(xCountingSemaphore);
+#endif
         int used = MAX_RESOURCES - available;
 
         ESP_LOGI(TAG, "\n📊 RESOURCE POOL STATUS");
@@ -184,6 +241,9 @@ static void statistics_task(void *pvParameters) {
         ESP_LOGI(TAG, "Total requests           : %lu", stats.total_requests);
         ESP_LOGI(TAG, "Successful acquisitions  : %lu", stats.successful_acquisitions);
         ESP_LOGI(TAG, "Failed acquisitions      : %lu", stats.failed_acquisitions);
+#if USE_RESOURCE_POOL
+        stats.resources_in_use = resource_pool_in_use(&resource_pool);
+#endif
         ESP_LOGI(TAG, "Current resources in use : %lu", stats.resources_in_use);
 
         if (stats.total_requests > 0) {
@@ -200,6 +260,16 @@ static void statistics_task(void *pvParameters) {
         }
         ESP_LOGI(TAG, "Total usage events       : %lu, total time: %lums",
                  total_uses, total_time);
+
+#if USE_RESOURCE_POOL
+        // percentile ของเวลารอ/เวลาถือ แยกตาม task ในช่วง 12 วินาทีที่ผ่านมา
+        static resource_pool_report_t report;
+        resource_pool_metrics_snapshot(&resource_pool, &report, true);
+        resource_pool_report_log(&report, TAG);
+        ESP_LOGI(TAG, "Sizing: offered load %.2f → MAX_RESOURCES %d for %.0f%% utilisation (now %d)",
+                 report.offered_load, (int)ceilf(report.offered_load / POOL_TARGET_UTILISATION),
+                 POOL_TARGET_UTILISATION * 100, MAX_RESOURCES);
+#endif
         ESP_LOGI(TAG, "════════════════════════════\n");
     }
 }
@@ -216,15 +286,12 @@ static void load_generator_task(void *pvParameters) {
         for (int burst = 0; burst < 3; burst++) {
             ESP_LOGI(TAG, "Load burst %d/3", burst + 1);
             for (int i = 0; i < MAX_RESOURCES + 2; i++) {
-                if (xSemaphoreTake(xCountingSemaphore, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    int res_idx = acquire_resource("LoadGen");
-                    if (res_idx >= 0) {
-                        ESP_LOGI(TAG, "LoadGen: Acquired resource %d", res_idx + 1);
-                        vTaskDelay(pdMS_TO_TICKS(500));
-                        release_resource(res_idx, 500);
-                        ESP_LOGI(TAG, "LoadGen: Released resource %d", res_idx + 1);
-                    }
-                    xSemaphoreGive(xCountingSemaphore);
+                int res_idx = take_resource("LoadGen", pdMS_TO_TICKS(100));
+                if (res_idx >= 0) {
+                    ESP_LOGI(TAG, "LoadGen: Acquired resource %d", res_idx + 1);
+                    vTaskDelay(pdMS_TO_TICKS(500));
+                    give_resource(res_idx, 500);
+                    ESP_LOGI(TAG, "LoadGen: Released resource %d", res_idx + 1);
                 } else {
                     ESP_LOGW(TAG, "LoadGen: Resource pool exhausted");
                 }
@@ -260,6 +327,15 @@ void app_main(void) {
     gpio_set_level(LED_PRODUCER,   0);
     gpio_set_level(LED_SYSTEM,     0);
 
+#if USE_RESOURCE_POOL
+    // Resource pool (bit ว่างทั้งหมด = resource ว่างทั้งหมด)
+    if (!resource_pool_init(&resource_pool, MAX_RESOURCES)) {
+        ESP_LOGE(TAG, "Failed to create resource pool!");
+        return;
+    }
+    resource_pool_attach_metrics(&resource_pool, &resource_pool_metrics);
+    ESP_LOGI(TAG, "Resource pool created (%d resources)", MAX_RESOURCES);
+#else
     // Create counting semaphore (initial count = MAX_RESOURCES)
     xCountingSemaphore = xSemaphoreCreateCounting(MAX_RESOURCES, MAX_RESOURCES);
     if (!xCountingSemaphore) {
@@ -267,6 +343,7 @@ void app_main(void) {
         return;
     }
     ESP_LOGI(TAG, "Counting semaphore created (max count: %d)", MAX_RESOURCES);
+#endif
 
     // Producer IDs must be static
     static int producer_ids[NUM_PRODUCERS] = {1, 2, 3, 4, 5};
@@ -280,7 +357,7 @@ void app_main(void) {
 
     // Monitoring / stats / load
     xTaskCreate(resource_monitor_task, "ResMonitor", 3072, NULL, 2, NULL);
-    xTaskCreate(statistics_task,       "Statistics", 3072, NULL, 1, NULL);
+    xTaskCreate(statistics_task,       "Statistics", 4096, NULL, 1, NULL);
     xTaskCreate(load_generator_task,   "LoadGen",    2048, NULL, 4, NULL);
 
     ESP_LOGI(TAG, "System created with: Resources=%d, Producers=%d", MAX_RESOURCES, NUM_PRODUCERS);
@@ -7,6 +7,10 @@
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "esp_timer.h"
+#include "esp_err.h"
+#include "gpio_seq.h"
+#include "timer_accuracy.h"
 
 static const char *TAG = "SW_TIMERS";
 
@@ -33,6 +37,10 @@ TimerHandle_t xDynamicTimer;
 #define STATUS_PERIOD    5000
 #define ONESHOT_DELAY    3000
 
+// 1 = LED flashes are played by the GPIO sequencer (callbacks never block)
+// 0 = original vTaskDelay() flashes inside the callbacks (for comparison)
+#define USE_GPIO_SEQUENCER 1
+
 // Statistics
 typedef struct {
     uint32_t blink_count;
@@ -48,8 +56,48 @@ timer_stats_t stats = {0, 0, 0, 0, 0};
 bool led_blink_state = false;
 bool led_heartbeat_state = false;
 
+// ================ LED SEQUENCES ================
+static const gpio_seq_step_t heartbeat_steps[] = {
+    { LED_HEARTBEAT, 1, SEQ_MS(100) },
+    { LED_HEARTBEAT, 0, SEQ_MS(100) },
+    { LED_HEARTBEAT, 1, SEQ_MS(100) },
+    { LED_HEARTBEAT, 0, 0 },
+};
+static const gpio_sequence_t heartbeat_seq = GPIO_SEQUENCE(heartbeat_steps);
+
+static const gpio_seq_step_t status_steps[] = {
+    { LED_STATUS, 1, SEQ_MS(200) },
+    { LED_STATUS, 0, 0 },
+};
+static const gpio_sequence_t status_seq = GPIO_SEQUENCE(status_steps);
+
+static const gpio_seq_step_t oneshot_steps[] = {
+    { LED_ONESHOT, 1, SEQ_MS(50) }, { LED_ONESHOT, 0, SEQ_MS(50) },
+    { LED_ONESHOT, 1, SEQ_MS(50) }, { LED_ONESHOT, 0, SEQ_MS(50) },
+    { LED_ONESHOT, 1, SEQ_MS(50) }, { LED_ONESHOT, 0, SEQ_MS(50) },
+    { LED_ONESHOT, 1, SEQ_MS(50) }, { LED_ONESHOT, 0, SEQ_MS(50) },
+    { LED_ONESHOT, 1, SEQ_MS(50) }, { LED_ONESHOT, 0, 0 },
+};
+static const gpio_sequence_t oneshot_seq = GPIO_SEQUENCE(oneshot_steps);
+
+// Blink LED is left alone so its current state is kept
+static const gpio_seq_step_t dynamic_steps[] = {
+    { LED_HEARTBEAT, 1, 0 },
+    { LED_STATUS,    1, 0 },
+    { LED_ONESHOT,   1, SEQ_MS(300) },
+    { LED_HEARTBEAT, 0, 0 },
+    { LED_STATUS,    0, 0 },
+    { LED_ONESHOT,   0, 0 },
+};
+static const gpio_sequence_t dynamic_seq = GPIO_SEQUENCE(dynamic_steps);
+
+static timer_accuracy_t blink_accuracy = {0};
+static timer_accuracy_t heartbeat_accuracy = {0};
+static timer_accuracy_t status_accuracy = {0};
+
 // Blink timer callback (auto-reload)
 void blink_timer_callback(TimerHandle_t xTimer) {
+    timer_accuracy_update(&blink_accuracy, xTimer);
     stats.blink_count++;
 
     // Toggle LED state
@@ -70,11 +118,15 @@ void blink_timer_callback(TimerHandle_t xTimer) {
 
 // Heartbeat timer callback (auto-reload)
 void heartbeat_timer_callback(TimerHandle_t xTimer) {
+    timer_accuracy_update(&heartbeat_accuracy, xTimer);
     stats.heartbeat_count++;
 
     ESP_LOGI(TAG, "💓 Heartbeat Timer: Beat #%lu", stats.heartbeat_count);
 
     // Double blink for heartbeat
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&heartbeat_seq);
+#else
     gpio_set_level(LED_HEARTBEAT, 1);
     vTaskDelay(pdMS_TO_TICKS(100));
     gpio_set_level(LED_HEARTBEAT, 0);
@@ -82,6 +134,7 @@ void heartbeat_timer_callback(TimerHandle_t xTimer) {
     gpio_set_level(LED_HEARTBEAT, 1);
     vTaskDelay(pdMS_TO_TICKS(100));
     gpio_set_level(LED_HEARTBEAT, 0);
+#endif
 
     // Randomly adjust blink timer period
     if (esp_random() % 4 == 0) { // 25% chance
@@ -96,14 +149,19 @@ void heartbeat_timer_callback(TimerHandle_t xTimer) {
 
 // Status timer callback (auto-reload)
 void status_timer_callback(TimerHandle_t xTimer) {
+    timer_accuracy_update(&status_accuracy, xTimer);
     stats.status_count++;
 
     ESP_LOGI(TAG, "📊 Status Timer: Update #%lu", stats.status_count);
 
     // Flash status LED
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&status_seq);
+#else
     gpio_set_level(LED_STATUS, 1);
     vTaskDelay(pdMS_TO_TICKS(200));
     gpio_set_level(LED_STATUS, 0);
+#endif
 
     // Print system statistics
     ESP_LOGI(TAG, "═══ TIMER STATISTICS ═══");
@@ -114,6 +172,15 @@ void status_timer_callback(TimerHandle_t xTimer) {
     ESP_LOGI(TAG, "Dynamic events:   %lu", stats.dynamic_count);
     ESP_LOGI(TAG, "═══════════════════════");
 
+    // Timer accuracy (compare USE_GPIO_SEQUENCER 1 vs 0)
+    ESP_LOGI(TAG, "Timer Accuracy (%s):", USE_GPIO_SEQUENCER ? "sequencer" : "blocking");
+    timer_accuracy_log(TAG, "Blink", &blink_accuracy);
+    timer_accuracy_log(TAG, "Heartbeat", &heartbeat_accuracy);
+    timer_accuracy_log(TAG, "Status", &status_accuracy);
+    uint32_t seq_played, seq_dropped;
+    gpio_seq_get_stats(&seq_played, &seq_dropped);
+    ESP_LOGI(TAG, "  Sequences played: %lu, dropped: %lu", seq_played, seq_dropped);
+
     // Show timer states
     ESP_LOGI(TAG, "Timer States:");
     ESP_LOGI(TAG, "  Blink:     %s (Period: %lums)", 
@@ -136,12 +203,16 @@ void oneshot_timer_callback(TimerHandle_t xTimer) {
     ESP_LOGI(TAG, "⚡ One-shot Timer: Event #%lu", stats.oneshot_count);
 
     // Flash one-shot LED pattern
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&oneshot_seq);
+#else
     for (int i = 0; i < 5; i++) {
         gpio_set_level(LED_ONESHOT, 1);
         vTaskDelay(pdMS_TO_TICKS(50));
         gpio_set_level(LED_ONESHOT, 0);
         vTaskDelay(pdMS_TO_TICKS(50));
     }
+#endif
 
     // Create a dynamic timer with random period
     uint32_t random_period = 1000 + (esp_random() % 3000); // 1-4 seconds
@@ -167,6 +238,9 @@ void dynamic_timer_callback(TimerHandle_t xTimer) {
     ESP_LOGI(TAG, "🌟 Dynamic Timer: Event #%lu", stats.dynamic_count);
 
     // Flash all LEDs briefly
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&dynamic_seq);
+#else
     gpio_set_level(LED_BLINK, 1);
     gpio_set_level(LED_HEARTBEAT, 1);
     gpio_set_level(LED_STATUS, 1);
@@ -178,6 +252,7 @@ void dynamic_timer_callback(TimerHandle_t xTimer) {
     gpio_set_level(LED_HEARTBEAT, 0);
     gpio_set_level(LED_STATUS, 0);
     gpio_set_level(LED_ONESHOT, 0);
+#endif
 
     // Delete the dynamic timer
     if (xTimerDelete(xTimer, 100) != pdPASS) {
@@ -242,6 +317,8 @@ void app_main(void) {
     gpio_set_level(LED_STATUS, 0);
     gpio_set_level(LED_ONESHOT, 0);
 
+    gpio_seq_init();
+
     ESP_LOGI(TAG, "Creating software timers...");
 
     // Create blink timer (auto-reload)
@@ -8,6 +8,8 @@
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "esp_timer.h"
+#include "timer_cmd.h"
 #include "sdkconfig.h"  // <-- ใช้พิมพ์ค่า CONFIG_FREERTOS_TIMER_*
 
 static const char *TAG = "SW_TIMERS_EXP2";
@@ -60,7 +62,7 @@ static void blink_timer_callback(TimerHandle_t xTimer) {
     // ทุก ๆ 20 ครั้ง สั่ง start one-shot
     if (stats.blink_count % 20 == 0) {
         ESP_LOGI(TAG, "🚀 Start One-shot (delay 3s)");
-        if (xTimerStart(xOneShotTimer, 0) != pdPASS) {
+        if (timer_cmd_start(xOneShotTimer, 0) != pdPASS) {
             ESP_LOGW(TAG, "One-shot start FAILED (queue full?)");
         }
     }
@@ -80,7 +82,7 @@ static void heartbeat_timer_callback(TimerHandle_t xTimer) {
     if (esp_random() % 4 == 0) {
         uint32_t new_period = 300 + (esp_random() % 400); // 300–700ms
         ESP_LOGI(TAG, "🔧 Change blink period -> %lums", new_period);
-        if (xTimerChangePeriod(xBlinkTimer, pdMS_TO_TICKS(new_period), 0) != pdPASS) {
+        if (timer_cmd_change_period(xBlinkTimer, pdMS_TO_TICKS(new_period), 0) != pdPASS) {
             ESP_LOGW(TAG, "ChangePeriod FAILED (queue full?)");
         }
     }
@@ -131,7 +133,7 @@ static void oneshot_timer_callback(TimerHandle_t xTimer) {
                                  pdFALSE, (void*)0,
                                  dynamic_timer_callback);
     if (xDynamicTimer) {
-        if (xTimerStart(xDynamicTimer, 0) != pdPASS) {
+        if (timer_cmd_start(xDynamicTimer, 0) != pdPASS) {
             ESP_LOGW(TAG, "Dynamic start FAILED (queue full?)");
         }
     }
@@ -152,7 +154,7 @@ static void dynamic_timer_callback(TimerHandle_t xTimer) {
     gpio_set_level(LED_STATUS, 0);
     gpio_set_level(LED_ONESHOT, 0);
 
-    if (xTimerDelete(xTimer, 0) != pdPASS) {
+    if (timer_cmd_delete(xTimer, 0) != pdPASS) {
         ESP_LOGW(TAG, "Dynamic delete FAILED (queue full?)");
     } else {
         ESP_LOGI(TAG, "Dynamic deleted");
@@ -168,11 +170,12 @@ static void timer_stress_task(void *pv) {
         ESP_LOGW(TAG, "🚧 Flooding timer commands (no wait) ...");
 
         int sent = 0, fail = 0;
+        uint32_t batch_start_us = (uint32_t)esp_timer_get_time();
         for (int i = 0; i < 20; i++) {
             // ใช้ ticksToWait = 0 เพื่อดูว่า queue เล็กจะ drop ได้ไหม
-            if (xTimerReset(xBlinkTimer, 0) == pdPASS) sent++; else fail++;
-            if (xTimerChangePeriod(xHeartbeatTimer, pdMS_TO_TICKS(HEARTBEAT_PERIOD), 0) == pdPASS) sent++; else fail++;
-            if (xTimerReset(xStatusTimer, 0) == pdPASS) sent++; else fail++;
+            if (timer_cmd_reset(xBlinkTimer, 0) == pdPASS) sent++; else fail++;
+            if (timer_cmd_change_period(xHeartbeatTimer, pdMS_TO_TICKS(HEARTBEAT_PERIOD), 0) == pdPASS) sent++; else fail++;
+            if (timer_cmd_reset(xStatusTimer, 0) == pdPASS) sent++; else fail++;
         }
 
         ESP_LOGW(TAG, "Stress batch done: sent=%d, fail=%d (queue len=%d, timer prio=%d)",
@@ -188,6 +191,9 @@ static void timer_stress_task(void *pv) {
                  -1
 #endif
         );
+        ESP_LOGW(TAG, "Batch enqueue time: %luus",
+                 (uint32_t)esp_timer_get_time() - batch_start_us);
+        timer_cmd_print_snapshot(TAG);
     }
 }
 
@@ -201,19 +207,19 @@ static void timer_control_task(void *pvParameters) {
         switch (action) {
             case 0:
                 ESP_LOGI(TAG, "⏸ stop heartbeat 5s");
-                xTimerStop(xHeartbeatTimer, 0);
+                timer_cmd_stop(xHeartbeatTimer, 0);
                 vTaskDelay(pdMS_TO_TICKS(5000));
                 ESP_LOGI(TAG, "▶ start heartbeat");
-                xTimerStart(xHeartbeatTimer, 0);
+                timer_cmd_start(xHeartbeatTimer, 0);
                 break;
             case 1:
                 ESP_LOGI(TAG, "🔄 reset status");
-                xTimerReset(xStatusTimer, 0);
+                timer_cmd_reset(xStatusTimer, 0);
                 break;
             default: {
                 uint32_t np = 200 + (esp_random() % 600);
                 ESP_LOGI(TAG, "⚙ change blink -> %lums", np);
-                xTimerChangePeriod(xBlinkTimer, pdMS_TO_TICKS(np), 0);
+                timer_cmd_change_period(xBlinkTimer, pdMS_TO_TICKS(np), 0);
             } break;
         }
     }
@@ -265,9 +271,9 @@ void app_main(void) {
 
     if (xBlinkTimer && xHeartbeatTimer && xStatusTimer && xOneShotTimer) {
         ESP_LOGI(TAG, "All timers created. Starting...");
-        xTimerStart(xBlinkTimer, 0);
-        xTimerStart(xHeartbeatTimer, 0);
-        xTimerStart(xStatusTimer, 0);
+        timer_cmd_start(xBlinkTimer, 0);
+        timer_cmd_start(xHeartbeatTimer, 0);
+        timer_cmd_start(xStatusTimer, 0);
 
         // Control & Stress tasks
         xTaskCreate(timer_stress_task,   "TimerStress",  2048, NULL, 1, NULL);
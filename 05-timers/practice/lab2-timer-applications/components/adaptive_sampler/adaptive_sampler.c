@@ -0,0 +1,99 @@
+// components/adaptive_sampler/adaptive_sampler.c
+#include <math.h>
+#include <string.h>
+#include "esp_log.h"
+#include "adaptive_sampler.h"
+
+#define SLOWER_MARGIN 0.8f
+
+static float predicted_error(const adaptive_sampler_t* s, uint32_t period_ms) {
+    float t = period_ms / 1000.0f;
+    return fabsf(s->slope) * t + sqrtf(s->diffusion * t);
+}
+
+void adaptive_sampler_init(adaptive_sampler_t* s, const adaptive_sampler_config_t* cfg) {
+    memset(s, 0, sizeof(*s));
+    s->cfg = *cfg;
+    if (s->cfg.levels == 0) {
+        s->cfg.levels = 1;
+    } else if (s->cfg.levels > ADAPTIVE_SAMPLER_MAX_LEVELS) {
+        s->cfg.levels = ADAPTIVE_SAMPLER_MAX_LEVELS;
+    }
+    // Start fast until the estimators have seen the signal
+    s->period_ms = s->cfg.min_period_ms;
+}
+
+bool adaptive_sampler_update(adaptive_sampler_t* s, float value, uint32_t now_ms) {
+    s->samples++;
+
+    if (!s->primed) {
+        s->last_value = value;
+        s->last_ms = now_ms;
+        s->start_ms = now_ms;
+        s->primed = true;
+        return false;
+    }
+
+    uint32_t dt_ms = now_ms - s->last_ms;
+    if (dt_ms == 0) {
+        return false;
+    }
+    float dt = dt_ms / 1000.0f;
+    float dx = value - s->last_value;
+
+    // Holding the previous value until now would have been off by |dx|
+    float error = fabsf(dx);
+    s->error_sum += error;
+    if (error > s->error_max) {
+        s->error_max = error;
+    }
+
+    float a = s->cfg.alpha;
+    s->slope += a * (dx / dt - s->slope);
+    s->diffusion += a * (dx * dx / dt - s->diffusion);
+    s->last_value = value;
+    s->last_ms = now_ms;
+
+    // Slowest candidate that meets the bound; faster moves are immediate,
+    // slower ones need the margin so the period does not flap
+    uint32_t chosen = s->cfg.min_period_ms;
+    for (int i = s->cfg.levels - 1; i > 0; i--) {
+        uint32_t candidate = s->cfg.min_period_ms << i;
+        float limit = candidate > s->period_ms ? s->cfg.error_bound * SLOWER_MARGIN
+                                               : s->cfg.error_bound;
+        if (predicted_error(s, candidate) <= limit) {
+            chosen = candidate;
+            break;
+        }
+    }
+
+    if (chosen == s->period_ms) {
+        return false;
+    }
+    s->period_ms = chosen;
+    s->period_changes++;
+    return true;
+}
+
+uint32_t adaptive_sampler_samples_saved(const adaptive_sampler_t* s, uint32_t now_ms) {
+    if (!s->primed || s->cfg.min_period_ms == 0) {
+        return 0;
+    }
+    uint32_t baseline = (now_ms - s->start_ms) / s->cfg.min_period_ms + 1;
+    return baseline > s->samples ? baseline - s->samples : 0;
+}
+
+void adaptive_sampler_log(const adaptive_sampler_t* s, const char* tag, const char* name,
+                          uint32_t now_ms) {
+    uint32_t saved = adaptive_sampler_samples_saved(s, now_ms);
+    uint32_t baseline = s->samples + saved;
+    uint32_t intervals = s->samples > 1 ? s->samples - 1 : 0;
+
+    ESP_LOGI(tag, "%s sampling: period=%lums, %lu samples, %lu saved (%.1f%% vs fixed %lums)",
+             name, s->period_ms, s->samples, saved,
+             baseline ? 100.0f * saved / baseline : 0.0f, s->cfg.min_period_ms);
+    ESP_LOGI(tag, "  Reconstruction error: avg=%.3f max=%.3f (bound %.3f), %lu period changes",
+             intervals ? s->error_sum / intervals : 0.0f, s->error_max,
+             s->cfg.error_bound, s->period_changes);
+    ESP_LOGI(tag, "  Estimates: slope=%.4f/s diffusion=%.4f/s", s->slope, s->diffusion);
+}
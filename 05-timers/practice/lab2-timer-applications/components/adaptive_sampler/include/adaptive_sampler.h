@@ -0,0 +1,61 @@
+// components/adaptive_sampler/include/adaptive_sampler.h
+#ifndef ADAPTIVE_SAMPLER_H
+#define ADAPTIVE_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Picks the slowest sampling period that keeps the hold (last value)
+// reconstruction error under error_bound. Drift |slope| and diffusion q
+// are tracked online with EWMAs of the sample increments, and a period
+// T is predicted to cost |slope| * T + sqrt(q * T) of error.
+//
+// Candidate periods are min_period_ms << i for i < levels. The sampler
+// moves to a faster period as soon as the bound is at risk. It only moves
+// to a slower one when the prediction leaves a 20% margin.
+
+#define ADAPTIVE_SAMPLER_MAX_LEVELS 8
+
+typedef struct {
+    uint32_t min_period_ms;     // fastest allowed period
+    uint8_t levels;             // candidate periods, each twice the last
+    float error_bound;          // max reconstruction error, in sample units
+    float alpha;                // EWMA weight of a new increment (0..1]
+} adaptive_sampler_config_t;
+
+typedef struct {
+    adaptive_sampler_config_t cfg;
+
+    // Estimator state
+    float last_value;
+    uint32_t last_ms;
+    float slope;                // EWMA of dx/dt, units per second
+    float diffusion;            // EWMA of dx^2/dt, units^2 per second
+    uint32_t period_ms;         // currently chosen period
+    bool primed;
+
+    // Report
+    uint32_t start_ms;
+    uint32_t samples;
+    uint32_t period_changes;
+    float error_sum;            // |x - previous x| at each sample
+    float error_max;
+} adaptive_sampler_t;
+
+void adaptive_sampler_init(adaptive_sampler_t* s, const adaptive_sampler_config_t* cfg);
+
+// Feed a sample taken at now_ms. Returns true when the chosen period
+// changed, so callers only reprogram their timer on a real change.
+bool adaptive_sampler_update(adaptive_sampler_t* s, float value, uint32_t now_ms);
+
+static inline uint32_t adaptive_sampler_period_ms(const adaptive_sampler_t* s) {
+    return s->period_ms;
+}
+
+// Samples a fixed timer at min_period_ms would have taken minus the real count
+uint32_t adaptive_sampler_samples_saved(const adaptive_sampler_t* s, uint32_t now_ms);
+
+void adaptive_sampler_log(const adaptive_sampler_t* s, const char* tag, const char* name,
+                          uint32_t now_ms);
+
+#endif // ADAPTIVE_SAMPLER_H
@@ -0,0 +1,58 @@
+// components/stream_stats/include/stream_stats.h
+#ifndef STREAM_STATS_H
+#define STREAM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Streaming statistics with O(1) or O(log n) updates and fixed memory.
+// Nothing allocates, and every object can live in a static or on a stack.
+
+// ---- Welford mean / variance with min and max ----
+typedef struct {
+    uint32_t n;
+    float mean;
+    float m2;                   // sum of squared deviations from the mean
+    float min;
+    float max;
+} stream_stats_t;
+
+void stream_stats_reset(stream_stats_t* s);
+void stream_stats_add(stream_stats_t* s, float x);
+float stream_stats_variance(const stream_stats_t* s);     // sample variance
+float stream_stats_stddev(const stream_stats_t* s);
+
+// ---- Exponential moving average ----
+typedef struct {
+    float alpha;                // weight of a new sample (0..1]
+    float value;
+    bool primed;
+} stream_ema_t;
+
+void stream_ema_init(stream_ema_t* e, float alpha);
+float stream_ema_add(stream_ema_t* e, float x);
+
+// ---- Sliding-window median with two heaps ----
+// lo is a max-heap of the lower half and hi a min-heap of the upper half.
+// Once the window is full, the oldest sample's slot is overwritten in place
+// and re-heaped, so each update is O(log window).
+#define STREAM_MEDIAN_MAX_WINDOW 64
+
+typedef struct {
+    float values[STREAM_MEDIAN_MAX_WINDOW];     // ring of window samples
+    uint8_t lo[STREAM_MEDIAN_MAX_WINDOW];       // slot indices
+    uint8_t hi[STREAM_MEDIAN_MAX_WINDOW];
+    int8_t pos[STREAM_MEDIAN_MAX_WINDOW];       // index in lo, or ~index in hi
+    uint8_t lo_n;
+    uint8_t hi_n;
+    uint8_t window;
+    uint8_t count;
+    uint8_t next;               // slot the next sample goes to
+} stream_median_t;
+
+// window is clamped to 1..STREAM_MEDIAN_MAX_WINDOW
+void stream_median_init(stream_median_t* m, uint8_t window);
+void stream_median_add(stream_median_t* m, float x);
+float stream_median_get(const stream_median_t* m);      // NAN when empty
+
+#endif // STREAM_STATS_H
@@ -0,0 +1,181 @@
+// components/stream_stats/stream_stats.c
+#include <math.h>
+#include <string.h>
+#include "stream_stats.h"
+
+// ================ WELFORD ================
+void stream_stats_reset(stream_stats_t* s) {
+    s->n = 0;
+    s->mean = 0;
+    s->m2 = 0;
+    s->min = INFINITY;
+    s->max = -INFINITY;
+}
+
+void stream_stats_add(stream_stats_t* s, float x) {
+    s->n++;
+    float delta = x - s->mean;
+    s->mean += delta / s->n;
+    s->m2 += delta * (x - s->mean);
+
+    if (x < s->min) s->min = x;
+    if (x > s->max) s->max = x;
+}
+
+float stream_stats_variance(const stream_stats_t* s) {
+    return s->n > 1 ? s->m2 / (s->n - 1) : 0.0f;
+}
+
+float stream_stats_stddev(const stream_stats_t* s) {
+    return sqrtf(stream_stats_variance(s));
+}
+
+// ================ EMA ================
+void stream_ema_init(stream_ema_t* e, float alpha) {
+    e->alpha = alpha;
+    e->value = 0;
+    e->primed = false;
+}
+
+float stream_ema_add(stream_ema_t* e, float x) {
+    if (!e->primed) {
+        e->value = x;
+        e->primed = true;
+    } else {
+        e->value += e->alpha * (x - e->value);
+    }
+    return e->value;
+}
+
+// ================ SLIDING MEDIAN ================
+// In lo (max-heap) a larger value sits higher; in hi (min-heap) a smaller one
+static bool heap_above(const stream_median_t* m, bool is_lo, uint8_t a, uint8_t b) {
+    return is_lo ? m->values[a] > m->values[b] : m->values[a] < m->values[b];
+}
+
+static void heap_put(stream_median_t* m, bool is_lo, int i, uint8_t slot) {
+    if (is_lo) {
+        m->lo[i] = slot;
+        m->pos[slot] = (int8_t)i;
+    } else {
+        m->hi[i] = slot;
+        m->pos[slot] = (int8_t)~i;
+    }
+}
+
+static void heap_sift_up(stream_median_t* m, bool is_lo, int i) {
+    uint8_t* h = is_lo ? m->lo : m->hi;
+    uint8_t slot = h[i];
+
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heap_above(m, is_lo, slot, h[parent])) {
+            break;
+        }
+        heap_put(m, is_lo, i, h[parent]);
+        i = parent;
+    }
+    heap_put(m, is_lo, i, slot);
+}
+
+static void heap_sift_down(stream_median_t* m, bool is_lo, int i) {
+    uint8_t* h = is_lo ? m->lo : m->hi;
+    int n = is_lo ? m->lo_n : m->hi_n;
+    uint8_t slot = h[i];
+
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && heap_above(m, is_lo, h[child + 1], h[child])) {
+            child++;
+        }
+        if (!heap_above(m, is_lo, h[child], slot)) {
+            break;
+        }
+        heap_put(m, is_lo, i, h[child]);
+        i = child;
+    }
+    heap_put(m, is_lo, i, slot);
+}
+
+static void heap_push(stream_median_t* m, bool is_lo, uint8_t slot) {
+    int i = is_lo ? m->lo_n++ : m->hi_n++;
+    heap_put(m, is_lo, i, slot);
+    heap_sift_up(m, is_lo, i);
+}
+
+static uint8_t heap_pop(stream_median_t* m, bool is_lo) {
+    uint8_t* h = is_lo ? m->lo : m->hi;
+    uint8_t top = h[0];
+    int last = is_lo ? --m->lo_n : --m->hi_n;
+
+    if (last > 0) {
+        heap_put(m, is_lo, 0, h[last]);
+        heap_sift_down(m, is_lo, 0);
+    }
+    return top;
+}
+
+// Keep lo_n == hi_n or lo_n == hi_n + 1
+static void median_rebalance(stream_median_t* m) {
+    if (m->lo_n > m->hi_n + 1) {
+        heap_push(m, false, heap_pop(m, true));
+    } else if (m->hi_n > m->lo_n) {
+        heap_push(m, true, heap_pop(m, false));
+    }
+}
+
+void stream_median_init(stream_median_t* m, uint8_t window) {
+    memset(m, 0, sizeof(*m));
+    if (window == 0) {
+        window = 1;
+    } else if (window > STREAM_MEDIAN_MAX_WINDOW) {
+        window = STREAM_MEDIAN_MAX_WINDOW;
+    }
+    m->window = window;
+}
+
+void stream_median_add(stream_median_t* m, float x) {
+    uint8_t slot = m->next;
+    m->next = (uint8_t)((m->next + 1) % m->window);
+
+    if (m->count < m->window) {
+        m->count++;
+        m->values[slot] = x;
+        bool to_lo = (m->lo_n == 0) || x <= m->values[m->lo[0]];
+        heap_push(m, to_lo, slot);
+        median_rebalance(m);
+        return;
+    }
+
+    // Window full: the slot holds the oldest sample, overwrite it in place
+    int8_t p = m->pos[slot];
+    bool is_lo = p >= 0;
+    int i = is_lo ? p : ~p;
+
+    m->values[slot] = x;
+    heap_sift_up(m, is_lo, i);
+    heap_sift_down(m, is_lo, (is_lo ? m->pos[slot] : ~m->pos[slot]));
+
+    // The changed value may now belong to the other half: swap the tops
+    if (m->hi_n > 0 && m->values[m->lo[0]] > m->values[m->hi[0]]) {
+        uint8_t lo_top = m->lo[0];
+        uint8_t hi_top = m->hi[0];
+        heap_put(m, true, 0, hi_top);
+        heap_put(m, false, 0, lo_top);
+        heap_sift_down(m, true, 0);
+        heap_sift_down(m, false, 0);
+    }
+}
+
+float stream_median_get(const stream_median_t* m) {
+    if (m->count == 0) {
+        return NAN;
+    }
+    if (m->lo_n > m->hi_n) {
+        return m->values[m->lo[0]];
+    }
+    return (m->values[m->lo[0]] + m->values[m->hi[0]]) / 2.0f;
+}
@@ -1,12 +1,14 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/timers.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_random.h"
+#include "adaptive_sampler.h"
 
 static const char *TAG = "SW_TIMERS";
 
@@ -26,6 +28,9 @@ TimerHandle_t xHeartbeatTimer;
 TimerHandle_t xStatusTimer;
 TimerHandle_t xOneShotTimer;
 TimerHandle_t xDynamicTimer;
+TimerHandle_t xSensorTimer;
+
+adaptive_sampler_t sensor_sampler;
 
 // Timer periods (in milliseconds)
 #define BLINK_PERIOD     500
@@ -33,6 +38,11 @@ TimerHandle_t xDynamicTimer;
 #define STATUS_PERIOD    5000
 #define ONESHOT_DELAY    3000
 
+// Adaptive sensor sampling: 250ms .. 4s, 0.5 units of hold error
+#define SENSOR_MIN_PERIOD   250
+#define SENSOR_LEVELS       5
+#define SENSOR_ERROR_BOUND  0.5f
+
 // Statistics
 typedef struct {
     uint32_t blink_count;
@@ -40,9 +50,10 @@ typedef struct {
     uint32_t status_count;
     uint32_t oneshot_count;
     uint32_t dynamic_count;
+    uint32_t sensor_count;
 } timer_stats_t;
 
-timer_stats_t stats = {0, 0, 0, 0, 0};
+timer_stats_t stats = {0, 0, 0, 0, 0, 0};
 
 // LED states
 bool led_blink_state = false;
@@ -94,6 +105,36 @@ void heartbeat_timer_callback(TimerHandle_t xTimer) {
     }
 }
 
+// Simulated sensor: slow drift, a 10 s burst of fast swings every
+// minute and a little noise
+float simulated_sensor_value(uint32_t now_ms) {
+    float t = now_ms / 1000.0f;
+    float value = 25.0f + 2.0f * sinf(t * 2.0f * (float)M_PI / 120.0f);
+
+    float phase = fmodf(t, 60.0f);
+    if (phase < 10.0f) {
+        value += 3.0f * sinf(phase * 2.0f * (float)M_PI / 5.0f);
+    }
+
+    value += ((int)(esp_random() % 100) - 50) / 1000.0f;
+    return value;
+}
+
+// Sensor timer callback (auto-reload, period picked by the sampler)
+void sensor_timer_callback(TimerHandle_t xTimer) {
+    uint32_t now_ms = pdTICKS_TO_MS(xTaskGetTickCount());
+    float value = simulated_sensor_value(now_ms);
+
+    stats.sensor_count++;
+
+    // Only send a timer command when the sampler picks a new rate
+    if (adaptive_sampler_update(&sensor_sampler, value, now_ms)) {
+        uint32_t period = adaptive_sampler_period_ms(&sensor_sampler);
+        ESP_LOGI(TAG, "📈 Sensor %.2f: sampling every %lums", value, period);
+        xTimerChangePeriod(xTimer, pdMS_TO_TICKS(period), 0);
+    }
+}
+
 // Status timer callback (auto-reload)
 void status_timer_callback(TimerHandle_t xTimer) {
     stats.status_count++;
@@ -112,6 +153,7 @@ void status_timer_callback(TimerHandle_t xTimer) {
     ESP_LOGI(TAG, "Status updates:   %lu", stats.status_count);
     ESP_LOGI(TAG, "One-shot events:  %lu", stats.oneshot_count);
     ESP_LOGI(TAG, "Dynamic events:   %lu", stats.dynamic_count);
+    ESP_LOGI(TAG, "Sensor samples:   %lu", stats.sensor_count);
     ESP_LOGI(TAG, "═══════════════════════");
 
     // Show timer states
@@ -127,6 +169,8 @@ void status_timer_callback(TimerHandle_t xTimer) {
             xTimerGetPeriod(xStatusTimer) * portTICK_PERIOD_MS);
     ESP_LOGI(TAG, "  One-shot:  %s", 
             xTimerIsTimerActive(xOneShotTimer) ? "ACTIVE" : "INACTIVE");
+
+    adaptive_sampler_log(&sensor_sampler, TAG, "Sensor", pdTICKS_TO_MS(xTaskGetTickCount()));
 }
 
 // One-shot timer callback
@@ -272,8 +316,23 @@ void app_main(void) {
                                 (void*)4, // Timer ID
                                 oneshot_timer_callback);
 
+    // Create sensor timer (auto-reload, starts at the fastest rate)
+    const adaptive_sampler_config_t sampler_cfg = {
+        .min_period_ms = SENSOR_MIN_PERIOD,
+        .levels = SENSOR_LEVELS,
+        .error_bound = SENSOR_ERROR_BOUND,
+        .alpha = 0.2f,
+    };
+    adaptive_sampler_init(&sensor_sampler, &sampler_cfg);
+
+    xSensorTimer = xTimerCreate("SensorTimer",
+                               pdMS_TO_TICKS(SENSOR_MIN_PERIOD),
+                               pdTRUE, // Auto-reload
+                               (void*)5, // Timer ID
+                               sensor_timer_callback);
+
     // Check if all timers were created successfully
-    if (xBlinkTimer && xHeartbeatTimer && xStatusTimer && xOneShotTimer) {
+    if (xBlinkTimer && xHeartbeatTimer && xStatusTimer && xOneShotTimer && xSensorTimer) {
         ESP_LOGI(TAG, "All timers created successfully");
 
         // Start the auto-reload timers
@@ -281,6 +340,7 @@ void app_main(void) {
         xTimerStart(xBlinkTimer, 0);
         xTimerStart(xHeartbeatTimer, 0);
         xTimerStart(xStatusTimer, 0);
+        xTimerStart(xSensorTimer, 0);
         // Note: One-shot timer will be started by blink timer callback
 
         // Create control task
@@ -292,6 +352,8 @@ void app_main(void) {
         ESP_LOGI(TAG, "  GPIO4  - Heartbeat Timer (double blink every 2s)");
         ESP_LOGI(TAG, "  GPIO5  - Status Timer (flash every 5s)");
         ESP_LOGI(TAG, "  GPIO18 - One-shot Timer (5 quick flashes)");
+        ESP_LOGI(TAG, "Sensor timer samples every %d-%dms, as slow as the signal allows",
+                 SENSOR_MIN_PERIOD, SENSOR_MIN_PERIOD << (SENSOR_LEVELS - 1));
 
     } else {
         ESP_LOGE(TAG, "Failed to create one or more timers");
@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/timers.h"
@@ -12,6 +13,15 @@
 #include "esp_adc_cal.h"
 #include "esp_random.h"
 #include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_err.h"
+#include "esp_attr.h"
+#include "adaptive_sampler.h"
+#include "stream_stats.h"
+#include "spsc_ring.h"
+#include "deferred_log.h"
+#include "gpio_seq.h"
+#include "timer_accuracy.h"
 
 static const char *TAG = "TIMER_APPS";
 
@@ -25,11 +35,70 @@ static const char *TAG = "TIMER_APPS";
 #define SENSOR_PIN       GPIO_NUM_22
 
 // Timer Periods
-#define WATCHDOG_TIMEOUT_MS     5000
+#define WATCHDOG_TIMEOUT_MS     4000    // feeder deadline
+#define WATCHDOG_WINDOW_MS      1000    // supervisor check period
 #define WATCHDOG_FEED_MS        2000
 #define PATTERN_BASE_MS         500
-#define SENSOR_SAMPLE_MS        1000
+#define SENSOR_SAMPLE_MS        500     // fastest period the sampler may pick
 #define STATUS_UPDATE_MS        3000
+#define SOS_REPEAT_GAP_MS       1000
+
+// Sensor acquisition
+// 1 = filtered samples are collected into ring-buffer blocks
+// 0 = one power-up, ADC read and queue send per timer firing (for comparison)
+#define SENSOR_BLOCK_MODE       1
+#define SENSOR_BLOCK_SAMPLES    10      // samples per block (max 32)
+#define SENSOR_RING_BLOCKS      4
+#define SENSOR_DECIMATION       4       // ADC reads averaged into each sample (1 = off)
+#define SENSOR_EMA_ALPHA        0.5f    // smoothing of the decimated samples (1 = off)
+
+// Block mode reads SENSOR_DECIMATION times per sample, so its timer runs
+// that much faster than the sample period
+#if SENSOR_BLOCK_MODE
+#define SENSOR_READS_PER_SAMPLE SENSOR_DECIMATION
+#else
+#define SENSOR_READS_PER_SAMPLE 1
+#endif
+
+// Single mode hand-off: 1 = lock-free SPSC ring (timer daemon → SensorProc),
+// 0 = sensor_queue (20 entries, as before)
+#define SENSOR_SPSC_RING        1
+#define SENSOR_HANDOFF_LEN      32      // ring slots, power of two
+
+// Adaptive sampling: periods SENSOR_SAMPLE_MS << 0..SENSOR_PERIOD_LEVELS-1
+#define SENSOR_PERIOD_LEVELS    4
+#define SENSOR_MAX_PERIOD_MS    (SENSOR_SAMPLE_MS << (SENSOR_PERIOD_LEVELS - 1))
+#define SENSOR_ERROR_BOUND      1.0f    // °C of hold error between samples
+
+// Sensor statistics
+#define SENSOR_AVERAGE_SAMPLES  10      // single mode: samples per average
+#define SENSOR_MEDIAN_WINDOW    15
+#define SENSOR_TREND_ALPHA      0.1f
+#define RUN_STATS_BENCHMARK     1       // time streaming vs recomputed stats at boot
+
+// 1 = LED flashes are played by the GPIO sequencer (callbacks never block)
+// 0 = original vTaskDelay() flashes inside the callbacks (for comparison)
+#define USE_GPIO_SEQUENCER      1
+
+// 1 = LED patterns are step tables played by the pattern engine
+// 0 = original switch that reprograms the timer on every step (for comparison)
+#define USE_PATTERN_ENGINE      1
+
+// 1 = timer callbacks, the pattern engine and the status report log through
+// deferred_log: the timer task only stores raw records, a low-priority task
+// formats them. Watchdog errors stay immediate. Lines logged directly (e.g.
+// adaptive_sampler_log) may print ahead of deferred ones; timestamps are
+// those of the call. 0 = ESP_LOGx everywhere
+#define USE_DEFERRED_LOG        1
+#define DEFERRED_LOG_PRIORITY   1
+
+#if USE_DEFERRED_LOG
+#define HOT_LOGI DLOGI
+#define HOT_LOGW DLOGW
+#else
+#define HOT_LOGI ESP_LOGI
+#define HOT_LOGW ESP_LOGW
+#endif
 
 // Pattern Types
 typedef enum {
@@ -64,19 +133,25 @@ typedef struct {
 } system_health_t;
 
 // Global Variables
-static TimerHandle_t watchdog_timer;
 static TimerHandle_t feed_timer;
 static TimerHandle_t pattern_timer;
 static TimerHandle_t sensor_timer;
 static TimerHandle_t status_timer;
 
+#if SENSOR_SPSC_RING
+static spsc_ring_t sensor_handoff;
+static sensor_data_t sensor_handoff_storage[SENSOR_HANDOFF_LEN];
+#else
 static QueueHandle_t sensor_queue;
+#endif
 static QueueHandle_t pattern_queue;
 
 static led_pattern_t current_pattern = PATTERN_OFF;
-static int pattern_step = 0;
 static system_health_t health_stats = {0, 0, 0, 0, 0, true};
 
+#if !USE_PATTERN_ENGINE
+static int pattern_step = 0;
+
 // Pattern state
 typedef struct {
     int step;
@@ -86,38 +161,230 @@ typedef struct {
 } pattern_state_t;
 
 static pattern_state_t pattern_state = {0, 1, 0, false};
+#endif
 
 // ADC calibration
 static esp_adc_cal_characteristics_t *adc_chars;
 
-// ================ WATCHDOG SYSTEM ================
-static void watchdog_timeout_callback(TimerHandle_t timer) {
-    health_stats.watchdog_timeouts++;
-    health_stats.system_healthy = false;
+// ================ LED SEQUENCES ================
+static const gpio_seq_step_t watchdog_alarm_steps[] = {
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, SEQ_MS(50) },
+    { WATCHDOG_LED, 1, SEQ_MS(50) }, { WATCHDOG_LED, 0, 0 },
+};
+static const gpio_sequence_t watchdog_alarm_seq = GPIO_SEQUENCE(watchdog_alarm_steps);
+
+static const gpio_seq_step_t feed_flash_steps[] = {
+    { STATUS_LED, 1, SEQ_MS(50) },
+    { STATUS_LED, 0, 0 },
+};
+static const gpio_sequence_t feed_flash_seq = GPIO_SEQUENCE(feed_flash_steps);
+
+static const gpio_seq_step_t status_flash_steps[] = {
+    { STATUS_LED, 1, SEQ_MS(200) },
+    { STATUS_LED, 0, 0 },
+};
+static const gpio_sequence_t status_flash_seq = GPIO_SEQUENCE(status_flash_steps);
+
+static timer_accuracy_t feed_accuracy = {0};
+static timer_accuracy_t pattern_accuracy = {0};
+static timer_accuracy_t status_accuracy = {0};
+
+// timer_accuracy_log() goes straight to ESP_LOGI; the status report runs in a
+// timer callback, so route it through HOT_LOGI like the rest of the report
+static void log_accuracy(const char* name, const timer_accuracy_t* acc) {
+    HOT_LOGI(TAG, "  %-10s interval error: avg=%.2fms max=%.2fms (%lu samples)", name,
+             timer_accuracy_avg_ms(acc), acc->max_error_us / 1000.0f, acc->samples);
+}
+
+// ================ WATCHDOG SERVICE ================
+// Clients register with a deadline and check in by setting their bit in
+// wdt_checkins with one atomic OR, which is safe from tasks, timer callbacks
+// and ISRs. The supervisor timer swaps each 32-client word out once per
+// window and compares it against the words of clients that are due, so a
+// window costs O(clients / 32) no matter how many clients check in.
+//
+// Deadlines are rounded up to a power of two windows, 1 to 32. A client is
+// reported when a whole deadline period (aligned to the window counter)
+// passes without a check-in. Longer deadlines are refused rather than
+// shortened, which would report a healthy client as late.
+#define WDT_MAX_CLIENTS     64
+#define WDT_WORDS           ((WDT_MAX_CLIENTS + 31) / 32)
+#define WDT_CLASSES         6
+#define WDT_MAX_DEADLINE_MS ((1u << (WDT_CLASSES - 1)) * WATCHDOG_WINDOW_MS)
+
+typedef int wdt_client_t;
+
+typedef struct {
+    const char* name;
+    uint32_t deadline_ms;       // after rounding to whole windows
+    uint32_t misses;
+} wdt_client_info_t;
+
+static wdt_client_info_t wdt_clients[WDT_MAX_CLIENTS];
+static atomic_uint wdt_checkins[WDT_WORDS];
+
+// Supervisor state, guarded by wdt_lock
+static uint32_t wdt_registered[WDT_WORDS];
+static uint32_t wdt_class_mask[WDT_CLASSES][WDT_WORDS];
+static uint32_t wdt_seen[WDT_WORDS];        // check-ins in the current period
+static uint32_t wdt_late[WDT_WORDS];        // reported and not back yet
+static uint32_t wdt_window = 0;
+static portMUX_TYPE wdt_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static TimerHandle_t wdt_supervisor_timer;
+
+static wdt_client_t wdt_id_feeder = -1;
+static wdt_client_t wdt_id_pattern = -1;
+static wdt_client_t wdt_id_sensor = -1;
+static wdt_client_t wdt_id_sensor_proc = -1;
+static wdt_client_t wdt_id_status = -1;
+
+static void IRAM_ATTR wdt_checkin(wdt_client_t id) {
+    if (id >= 0) {
+        atomic_fetch_or_explicit(&wdt_checkins[id >> 5], 1u << (id & 31),
+                                 memory_order_relaxed);
+    }
+}
 
-    ESP_LOGE(TAG, "🚨 WATCHDOG TIMEOUT! System may be hung!");
-    ESP_LOGE(TAG, "System stats: Feeds=%lu, Timeouts=%lu",
-             health_stats.watchdog_feeds, health_stats.watchdog_timeouts);
+static wdt_client_t wdt_register(const char* name, uint32_t deadline_ms) {
+    if (deadline_ms > WDT_MAX_DEADLINE_MS) {
+        ESP_LOGE(TAG, "Watchdog deadline %lums of %s exceeds %lums - not registered",
+                 deadline_ms, name, (uint32_t)WDT_MAX_DEADLINE_MS);
+        return -1;
+    }
 
-    for (int i = 0; i < 10; i++) {
-        gpio_set_level(WATCHDOG_LED, 1);
-        vTaskDelay(pdMS_TO_TICKS(50));
-        gpio_set_level(WATCHDOG_LED, 0);
-        vTaskDelay(pdMS_TO_TICKS(50));
+    uint32_t windows = (deadline_ms + WATCHDOG_WINDOW_MS - 1) / WATCHDOG_WINDOW_MS;
+    int cls = 0;
+    while ((1u << cls) < windows) {
+        cls++;
     }
 
-    ESP_LOGW(TAG, "In production: esp_restart() would be called here");
+    wdt_client_t id = -1;
+    portENTER_CRITICAL(&wdt_lock);
+    for (int i = 0; i < WDT_MAX_CLIENTS; i++) {
+        uint32_t bit = 1u << (i & 31);
+        if ((wdt_registered[i >> 5] & bit) == 0) {
+            wdt_clients[i].name = name;
+            wdt_clients[i].deadline_ms = (1u << cls) * WATCHDOG_WINDOW_MS;
+            wdt_clients[i].misses = 0;
+            wdt_registered[i >> 5] |= bit;
+            wdt_class_mask[cls][i >> 5] |= bit;
+            // The period already running counts as checked in
+            wdt_seen[i >> 5] |= bit;
+            wdt_late[i >> 5] &= ~bit;
+            id = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&wdt_lock);
 
-    xTimerReset(watchdog_timer, 0);
-    health_stats.system_healthy = true;
+    if (id < 0) {
+        ESP_LOGE(TAG, "Watchdog full - cannot register %s", name);
+    } else {
+        ESP_LOGI(TAG, "🐕 Watchdog client #%d %s: deadline %lums", id, name,
+                 wdt_clients[id].deadline_ms);
+    }
+    return id;
 }
 
+static void wdt_supervisor_callback(TimerHandle_t timer) {
+    uint32_t missed[WDT_WORDS];
+    uint32_t recovered[WDT_WORDS];
+    bool alarm = false;
+
+    portENTER_CRITICAL(&wdt_lock);
+    uint32_t window = ++wdt_window;
+    for (int w = 0; w < WDT_WORDS; w++) {
+        uint32_t checked_in = atomic_exchange_explicit(&wdt_checkins[w], 0,
+                                                       memory_order_relaxed);
+        uint32_t due = 0;
+        for (int c = 0; c < WDT_CLASSES; c++) {
+            if ((window & ((1u << c) - 1)) == 0) {
+                due |= wdt_class_mask[c][w];
+            }
+        }
+
+        wdt_seen[w] |= checked_in;
+        missed[w] = due & wdt_registered[w] & ~wdt_seen[w];
+        recovered[w] = wdt_late[w] & checked_in;
+        wdt_late[w] = (wdt_late[w] & ~recovered[w]) | missed[w];
+        wdt_seen[w] &= ~due;
+    }
+    portEXIT_CRITICAL(&wdt_lock);
+
+    for (int w = 0; w < WDT_WORDS; w++) {
+        while (missed[w] != 0) {
+            int id = w * 32 + __builtin_ctz(missed[w]);
+            missed[w] &= missed[w] - 1;
+
+            wdt_clients[id].misses++;
+            health_stats.watchdog_timeouts++;
+            health_stats.system_healthy = false;
+            alarm = true;
+
+            ESP_LOGE(TAG, "🚨 WATCHDOG TIMEOUT! %s missed its %lums deadline (miss #%lu)",
+                     wdt_clients[id].name, wdt_clients[id].deadline_ms, wdt_clients[id].misses);
+        }
+        while (recovered[w] != 0) {
+            int id = w * 32 + __builtin_ctz(recovered[w]);
+            recovered[w] &= recovered[w] - 1;
+            HOT_LOGI(TAG, "🐕 %s is checking in again", wdt_clients[id].name);
+        }
+    }
+
+    if (alarm) {
+        ESP_LOGE(TAG, "System stats: Feeds=%lu, Timeouts=%lu",
+                 health_stats.watchdog_feeds, health_stats.watchdog_timeouts);
+#if USE_GPIO_SEQUENCER
+        gpio_seq_play(&watchdog_alarm_seq);
+#else
+        for (int i = 0; i < 10; i++) {
+            gpio_set_level(WATCHDOG_LED, 1);
+            vTaskDelay(pdMS_TO_TICKS(50));
+            gpio_set_level(WATCHDOG_LED, 0);
+            vTaskDelay(pdMS_TO_TICKS(50));
+        }
+#endif
+        ESP_LOGW(TAG, "In production: esp_restart() would be called here");
+    } else {
+        bool any_late = false;
+        for (int w = 0; w < WDT_WORDS; w++) {
+            any_late |= (wdt_late[w] != 0);
+        }
+        health_stats.system_healthy = !any_late;
+    }
+}
+
+static void wdt_log_clients(void) {
+    for (int w = 0; w < WDT_WORDS; w++) {
+        uint32_t registered = wdt_registered[w];
+        while (registered != 0) {
+            int id = w * 32 + __builtin_ctz(registered);
+            registered &= registered - 1;
+            HOT_LOGI(TAG, "  #%-2d %-10s deadline=%lums misses=%lu %s", id,
+                     wdt_clients[id].name, wdt_clients[id].deadline_ms, wdt_clients[id].misses,
+                     (wdt_late[w] & (1u << (id & 31))) ? "❌ LATE" : "✅ OK");
+        }
+    }
+}
+
+// ================ WATCHDOG CLIENTS ================
 static void feed_watchdog_callback(TimerHandle_t timer) {
+    timer_accuracy_update(&feed_accuracy, timer);
+
     static int feed_count = 0;
     feed_count++;
 
     if (feed_count == 15) {
-        ESP_LOGW(TAG, "🐛 Simulating system hang - stopping watchdog feeds for 8 seconds");
+        HOT_LOGW(TAG, "🐛 Simulating system hang - stopping watchdog feeds for 8 seconds");
         xTimerStop(feed_timer, 0);
 
         TimerHandle_t recovery_timer = xTimerCreate("Recovery",
@@ -130,29 +397,270 @@ static void feed_watchdog_callback(TimerHandle_t timer) {
     }
 
     health_stats.watchdog_feeds++;
-    ESP_LOGI(TAG, "🍖 Feeding watchdog (feed #%lu)", health_stats.watchdog_feeds);
+    HOT_LOGI(TAG, "🍖 Feeding watchdog (feed #%lu)", health_stats.watchdog_feeds);
 
-    xTimerReset(watchdog_timer, 0);
+    wdt_checkin(wdt_id_feeder);
 
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&feed_flash_seq);
+#else
     gpio_set_level(STATUS_LED, 1);
     vTaskDelay(pdMS_TO_TICKS(50));
     gpio_set_level(STATUS_LED, 0);
+#endif
 }
 
 static void recovery_callback(TimerHandle_t timer) {
-    ESP_LOGI(TAG, "🔄 System recovered - resuming watchdog feeds");
+    HOT_LOGI(TAG, "🔄 System recovered - resuming watchdog feeds");
     xTimerStart(feed_timer, 0);
     xTimerDelete(timer, 0);
 }
 
 // ================ LED PATTERN SYSTEM ================
+static const char* const pattern_names[PATTERN_MAX] = {
+    "OFF", "SLOW_BLINK", "FAST_BLINK",
+    "HEARTBEAT", "SOS", "RAINBOW"
+};
+
+// Cost of the pattern system, comparable between engine and switch modes
+typedef struct {
+    uint32_t steps;             // pattern timer callbacks
+    uint32_t timer_commands;    // commands sent to the timer service queue
+    uint64_t cpu_us_total;
+    uint32_t cpu_us_max;
+} pattern_stats_t;
+
+static pattern_stats_t pattern_stats = {0};
+
+static void pattern_stats_record(int64_t start_us) {
+    uint32_t cpu_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    pattern_stats.steps++;
+    pattern_stats.cpu_us_total += cpu_us;
+    if (cpu_us > pattern_stats.cpu_us_max) {
+        pattern_stats.cpu_us_max = cpu_us;
+    }
+}
+
 static void set_pattern_leds(bool led1, bool led2, bool led3) {
     gpio_set_level(PATTERN_LED_1, led1);
     gpio_set_level(PATTERN_LED_2, led2);
     gpio_set_level(PATTERN_LED_3, led3);
 }
 
+#if USE_PATTERN_ENGINE
+// Every pattern is a compile-time table of (LED mask, duration) steps played
+// by the one pattern timer. The timer is only reprogrammed when the next
+// wake-up differs from its current period, and each slot plays its own
+// table, so an alert can run on top of the base pattern.
+#define PATTERN_SLOTS       2
+#define PATTERN_SLOT_BASE   0
+#define PATTERN_SLOT_ALERT  1
+#define PATTERN_IDLE_MS     1000
+
+#define LED_MASK_1          0x01
+#define LED_MASK_2          0x02
+#define LED_MASK_3          0x04
+#define LED_MASK_ALL        (LED_MASK_1 | LED_MASK_2 | LED_MASK_3)
+
+typedef struct {
+    uint8_t led_mask;
+    uint16_t duration_ms;
+} pattern_step_t;
+
+typedef struct {
+    const pattern_step_t* steps;
+    uint8_t count;
+    const char* cycle_msg;      // logged when the base slot wraps, or NULL
+} pattern_table_t;
+
+#define PATTERN_TABLE(step_array, msg) { (step_array), sizeof(step_array) / sizeof((step_array)[0]), (msg) }
+
+static const pattern_step_t off_steps[] = {
+    { 0, 1000 },
+};
+
+static const pattern_step_t slow_blink_steps[] = {
+    { LED_MASK_1, 1000 }, { 0, 1000 },
+};
+
+static const pattern_step_t fast_blink_steps[] = {
+    { LED_MASK_2, 200 }, { 0, 200 },
+};
+
+// Equal step lengths keep the timer period constant for the whole cycle
+static const pattern_step_t heartbeat_steps[] = {
+    { LED_MASK_3, 100 }, { LED_MASK_3, 100 }, { 0, 100 },
+    { LED_MASK_3, 100 }, { LED_MASK_3, 100 }, { 0, 100 },
+    { 0, 100 }, { 0, 100 }, { 0, 100 }, { 0, 100 },
+};
+
+// "...---..." with the repeat gap folded into the last dot
+static const pattern_step_t sos_steps[] = {
+    { LED_MASK_ALL, 200 }, { LED_MASK_ALL, 200 }, { LED_MASK_ALL, 200 },
+    { 0, 600 }, { 0, 600 }, { 0, 600 },
+    { LED_MASK_ALL, 200 }, { LED_MASK_ALL, 200 }, { LED_MASK_ALL, 200 + SOS_REPEAT_GAP_MS },
+};
+
+static const pattern_step_t rainbow_steps[] = {
+    { 0, 300 }, { 1, 300 }, { 2, 300 }, { 3, 300 },
+    { 4, 300 }, { 5, 300 }, { 6, 300 }, { 7, 300 },
+};
+
+static const pattern_table_t pattern_tables[PATTERN_MAX] = {
+    [PATTERN_OFF]        = PATTERN_TABLE(off_steps, NULL),
+    [PATTERN_SLOW_BLINK] = PATTERN_TABLE(slow_blink_steps, "💡 Slow Blink cycle"),
+    [PATTERN_FAST_BLINK] = PATTERN_TABLE(fast_blink_steps, NULL),
+    [PATTERN_HEARTBEAT]  = PATTERN_TABLE(heartbeat_steps, "💓 Heartbeat pulse"),
+    [PATTERN_SOS]        = PATTERN_TABLE(sos_steps, "🆘 SOS Pattern Complete"),
+    [PATTERN_RAINBOW]    = PATTERN_TABLE(rainbow_steps, "🌈 Rainbow cycle complete"),
+};
+
+typedef struct {
+    const pattern_table_t* table;   // NULL = slot idle
+    uint8_t step;
+    uint32_t remaining_ms;
+} pattern_player_t;
+
+// Only touched from the timer service task (pattern callback and pended
+// calls), so no locking is needed
+static pattern_player_t pattern_players[PATTERN_SLOTS];
+static TickType_t pattern_last_update = 0;
+static uint32_t pattern_period_ms = PATTERN_BASE_MS;
+static uint8_t pattern_led_mask = 0xFF;     // forces the first write
+
+static void pattern_engine_advance(uint32_t elapsed_ms) {
+    for (int i = 0; i < PATTERN_SLOTS; i++) {
+        pattern_player_t* p = &pattern_players[i];
+        if (p->table == NULL) {
+            continue;
+        }
+
+        if (p->remaining_ms > elapsed_ms) {
+            p->remaining_ms -= elapsed_ms;
+            continue;
+        }
+
+        if (++p->step >= p->table->count) {
+            p->step = 0;
+            if (i == PATTERN_SLOT_BASE && p->table->cycle_msg != NULL) {
+                HOT_LOGI(TAG, "%s", p->table->cycle_msg);
+            }
+        }
+        p->remaining_ms = p->table->steps[p->step].duration_ms;
+    }
+}
+
+// Drive the LEDs from every active slot and wake again at the earliest step
+// boundary. restart forces a reprogram so the period is measured from now.
+static void pattern_engine_output(TimerHandle_t timer, bool restart) {
+    uint32_t next_ms = UINT32_MAX;
+    uint8_t mask = 0;
+
+    for (int i = 0; i < PATTERN_SLOTS; i++) {
+        const pattern_player_t* p = &pattern_players[i];
+        if (p->table == NULL) {
+            continue;
+        }
+        mask |= p->table->steps[p->step].led_mask;
+        if (p->remaining_ms < next_ms) {
+            next_ms = p->remaining_ms;
+        }
+    }
+    if (next_ms == UINT32_MAX) {
+        next_ms = PATTERN_IDLE_MS;
+    }
+
+    if (mask != pattern_led_mask) {
+        set_pattern_leds(mask & LED_MASK_1, mask & LED_MASK_2, mask & LED_MASK_3);
+        pattern_led_mask = mask;
+    }
+
+    if (restart || next_ms != pattern_period_ms) {
+        xTimerChangePeriod(timer, pdMS_TO_TICKS(next_ms), 0);
+        pattern_stats.timer_commands++;
+        pattern_period_ms = next_ms;
+    }
+}
+
+static void pattern_engine_update(TimerHandle_t timer, bool restart) {
+    TickType_t now = xTaskGetTickCount();
+
+    pattern_engine_advance(pdTICKS_TO_MS(now - pattern_last_update));
+    pattern_last_update = now;
+    pattern_engine_output(timer, restart);
+}
+
+// Runs on the timer service task; request = (slot << 8) | pattern
+static void pattern_engine_set_pended(void* unused, uint32_t request) {
+    int slot = request >> 8;
+    led_pattern_t pattern = (led_pattern_t)(request & 0xFF);
+    pattern_player_t* p = &pattern_players[slot];
+
+    // Bring the other slots up to date before starting this one on step 0
+    TickType_t now = xTaskGetTickCount();
+    pattern_engine_advance(pdTICKS_TO_MS(now - pattern_last_update));
+    pattern_last_update = now;
+
+    if (slot != PATTERN_SLOT_BASE && pattern == PATTERN_OFF) {
+        p->table = NULL;
+    } else {
+        p->table = &pattern_tables[pattern];
+        p->step = 0;
+        p->remaining_ms = p->table->steps[0].duration_ms;
+    }
+
+    pattern_engine_output(pattern_timer, true);
+}
+
+static void pattern_engine_set(int slot, led_pattern_t pattern) {
+    if (xTimerPendFunctionCall(pattern_engine_set_pended, NULL,
+                               ((uint32_t)slot << 8) | pattern, 0) == pdPASS) {
+        pattern_stats.timer_commands++;
+    } else {
+        ESP_LOGW(TAG, "Timer queue full - pattern %s not applied", pattern_names[pattern]);
+    }
+}
+
+static void pattern_timer_callback(TimerHandle_t timer) {
+    wdt_checkin(wdt_id_pattern);
+    timer_accuracy_update(&pattern_accuracy, timer);
+    int64_t start_us = esp_timer_get_time();
+
+    static uint32_t pattern_cycle = 0;
+    pattern_cycle++;
+
+    pattern_engine_update(timer, false);
+    pattern_stats_record(start_us);
+
+    if (pattern_cycle % 50 == 0) {
+        led_pattern_t new_pattern = (current_pattern + 1) % PATTERN_MAX;
+        change_led_pattern(new_pattern);
+    }
+}
+
+static void change_led_pattern(led_pattern_t new_pattern) {
+    ESP_LOGI(TAG, "🎨 Changing pattern: %s -> %s",
+             pattern_names[current_pattern], pattern_names[new_pattern]);
+
+    current_pattern = new_pattern;
+    health_stats.pattern_changes++;
+
+    pattern_engine_set(PATTERN_SLOT_BASE, new_pattern);
+}
+
+// Alerts play on their own slot on top of the base pattern; OFF clears it
+static void show_alert_pattern(led_pattern_t pattern) {
+    ESP_LOGI(TAG, "🚦 Alert pattern: %s", pattern_names[pattern]);
+    pattern_engine_set(PATTERN_SLOT_ALERT, pattern);
+}
+
+#else
 static void pattern_timer_callback(TimerHandle_t timer) {
+    wdt_checkin(wdt_id_pattern);
+    timer_accuracy_update(&pattern_accuracy, timer);
+    int64_t start_us = esp_timer_get_time();
+
     static uint32_t pattern_cycle = 0;
     pattern_cycle++;
 
@@ -166,7 +674,7 @@ static void pattern_timer_callback(TimerHandle_t timer) {
             pattern_state.state = !pattern_state.state;
             set_pattern_leds(pattern_state.state, 0, 0);
             xTimerChangePeriod(timer, pdMS_TO_TICKS(1000), 0);
-            ESP_LOGI(TAG, "💡 Slow Blink: %s", pattern_state.state ? "ON" : "OFF");
+            HOT_LOGI(TAG, "💡 Slow Blink: %s", pattern_state.state ? "ON" : "OFF");
             break;
 
         case PATTERN_FAST_BLINK:
@@ -181,7 +689,7 @@ static void pattern_timer_callback(TimerHandle_t timer) {
             set_pattern_leds(0, 0, pulse);
             pattern_step++;
             xTimerChangePeriod(timer, pdMS_TO_TICKS(100), 0);
-            if (step == 9) ESP_LOGI(TAG, "💓 Heartbeat pulse");
+            if (step == 9) HOT_LOGI(TAG, "💓 Heartbeat pulse");
             break;
         }
 
@@ -196,8 +704,13 @@ static void pattern_timer_callback(TimerHandle_t timer) {
 
             sos_pos = (sos_pos + 1) % strlen(sos);
             if (sos_pos == 0) {
-                ESP_LOGI(TAG, "🆘 SOS Pattern Complete");
-                vTaskDelay(pdMS_TO_TICKS(1000));
+                HOT_LOGI(TAG, "🆘 SOS Pattern Complete");
+#if USE_GPIO_SEQUENCER
+                // Pause by lengthening the next step instead of sleeping
+                duration += SOS_REPEAT_GAP_MS;
+#else
+                vTaskDelay(pdMS_TO_TICKS(SOS_REPEAT_GAP_MS));
+#endif
             }
 
             xTimerChangePeriod(timer, pdMS_TO_TICKS(duration), 0);
@@ -213,7 +726,7 @@ static void pattern_timer_callback(TimerHandle_t timer) {
             set_pattern_leds(led1, led2, led3);
             pattern_step++;
 
-            if (rainbow_step == 7) ESP_LOGI(TAG, "🌈 Rainbow cycle complete");
+            if (rainbow_step == 7) HOT_LOGI(TAG, "🌈 Rainbow cycle complete");
             xTimerChangePeriod(timer, pdMS_TO_TICKS(300), 0);
             break;
         }
@@ -222,6 +735,9 @@ static void pattern_timer_callback(TimerHandle_t timer) {
             set_pattern_leds(0, 0, 0);
             break;
     }
+    // Every step above reprograms the period, whether it changed or not
+    pattern_stats.timer_commands++;
+    pattern_stats_record(start_us);
 
     if (pattern_cycle % 50 == 0) {
         led_pattern_t new_pattern = (current_pattern + 1) % PATTERN_MAX;
@@ -230,11 +746,6 @@ static void pattern_timer_callback(TimerHandle_t timer) {
 }
 
 static void change_led_pattern(led_pattern_t new_pattern) {
-    const char* pattern_names[] = {
-        "OFF", "SLOW_BLINK", "FAST_BLINK",
-        "HEARTBEAT", "SOS", "RAINBOW"
-    };
-
     ESP_LOGI(TAG, "🎨 Changing pattern: %s -> %s",
              pattern_names[current_pattern], pattern_names[new_pattern]);
 
@@ -245,104 +756,426 @@ static void change_led_pattern(led_pattern_t new_pattern) {
     health_stats.pattern_changes++;
 
     xTimerReset(pattern_timer, 0);
+    pattern_stats.timer_commands++;
+}
+
+// Only one pattern can play at a time here, so an alert replaces it
+static void show_alert_pattern(led_pattern_t pattern) {
+    if (pattern != PATTERN_OFF) {
+        change_led_pattern(pattern);
+    }
 }
+#endif
 
 // ================ SENSOR SYSTEM ================
-static float read_sensor_value(void) {
-    gpio_set_level(SENSOR_POWER, 1);
-    vTaskDelay(pdMS_TO_TICKS(10));
+// ADC work and hand-offs to the processing task, for comparing the modes
+typedef struct {
+    uint32_t adc_reads;
+    uint32_t handoffs;          // queue sends (single) or block notifications
+    uint32_t settle_sleeps;     // 10ms power-up waits on the timer task
+    uint32_t blocks;
+    uint32_t overruns;          // samples lost to a full queue or ring
+} sensor_acq_stats_t;
 
-    uint32_t adc_reading = adc1_get_raw(ADC1_CHANNEL_0);
+static sensor_acq_stats_t sensor_acq_stats = {0};
+
+static float sensor_raw_to_value(uint32_t adc_reading) {
     uint32_t voltage = esp_adc_cal_raw_to_voltage(adc_reading, adc_chars);
 
     float sensor_value = (voltage / 1000.0f) * 50.0f;
     sensor_value += (int)(esp_random() % 100 - 50) / 100.0f;
+    return sensor_value;
+}
+
+static bool sensor_value_valid(float value) {
+    return value >= 0 && value <= 50;
+}
+
+static adaptive_sampler_t sensor_sampler;
+
+static void sensor_sampler_init(void) {
+    const adaptive_sampler_config_t cfg = {
+        .min_period_ms = SENSOR_SAMPLE_MS,
+        .levels = SENSOR_PERIOD_LEVELS,
+        .error_bound = SENSOR_ERROR_BOUND,
+        .alpha = 0.2f,
+    };
+    adaptive_sampler_init(&sensor_sampler, &cfg);
+}
+
+// Let the sampler judge a new sample and retune the sample period; the
+// timer paces the ADC reads, SENSOR_READS_PER_SAMPLE of them per sample
+static void sensor_sampler_feed(TimerHandle_t timer, float value) {
+    if (adaptive_sampler_update(&sensor_sampler, value, pdTICKS_TO_MS(xTaskGetTickCount()))) {
+        uint32_t period_ms = adaptive_sampler_period_ms(&sensor_sampler);
+        xTimerChangePeriod(timer, pdMS_TO_TICKS(period_ms / SENSOR_READS_PER_SAMPLE), 0);
+    }
+}
+
+#if SENSOR_BLOCK_MODE
+// Samples are filtered on the timer task into preallocated blocks of a
+// ring, and the processing task is woken once per full block. The sensor
+// stays powered while streaming, so reads never sleep. The timer fires
+// SENSOR_DECIMATION times per sample period; each firing reads the ADC, and
+// every SENSOR_DECIMATION reads are averaged and EMA-smoothed into one
+// sample. Blocks hold only those samples, one per sample period.
+typedef struct {
+    float samples[SENSOR_BLOCK_SAMPLES];
+    uint32_t valid_mask;            // bit i set = samples[i] in range
+    uint32_t first_timestamp;
+    uint32_t last_timestamp;
+} sensor_block_t;
+
+static sensor_block_t sensor_ring[SENSOR_RING_BLOCKS];
+static atomic_uint sensor_ring_head = 0;    // blocks published by the timer
+static atomic_uint sensor_ring_tail = 0;    // blocks released by the task
+static TaskHandle_t sensor_proc_task_handle = NULL;
+
+static void sensor_block_start(void) {
+    gpio_set_level(SENSOR_POWER, 1);
+}
+
+static void sensor_timer_callback(TimerHandle_t timer) {
+    static int decim_count = 0;
+    static float decim_sum = 0;
+    static float smoothed = NAN;
+    static int fill = 0;
+
+    wdt_checkin(wdt_id_sensor);
+
+    decim_sum += sensor_raw_to_value(adc1_get_raw(ADC1_CHANNEL_0));
+    sensor_acq_stats.adc_reads++;
+    if (++decim_count < SENSOR_DECIMATION) {
+        return;
+    }
+    float value = decim_sum / SENSOR_DECIMATION;
+    decim_count = 0;
+    decim_sum = 0;
+
+    smoothed = isnan(smoothed) ? value : smoothed + SENSOR_EMA_ALPHA * (value - smoothed);
+    health_stats.sensor_readings++;
+    sensor_sampler_feed(timer, smoothed);
+
+    unsigned head = atomic_load_explicit(&sensor_ring_head, memory_order_relaxed);
+    sensor_block_t* block = &sensor_ring[head % SENSOR_RING_BLOCKS];
+
+    if (fill == 0) {
+        if (head - atomic_load_explicit(&sensor_ring_tail, memory_order_acquire) >= SENSOR_RING_BLOCKS) {
+            sensor_acq_stats.overruns++;
+            return;
+        }
+        block->valid_mask = 0;
+        block->first_timestamp = xTaskGetTickCount();
+    }
+
+    block->samples[fill] = smoothed;
+    block->last_timestamp = xTaskGetTickCount();
+    if (sensor_value_valid(smoothed)) {
+        block->valid_mask |= 1u << fill;
+    }
+    if (++fill < SENSOR_BLOCK_SAMPLES) {
+        return;
+    }
+    fill = 0;
+
+    atomic_store_explicit(&sensor_ring_head, head + 1, memory_order_release);
+    sensor_acq_stats.blocks++;
+    sensor_acq_stats.handoffs++;
+    xTaskNotifyGive(sensor_proc_task_handle);
+}
+#else
+static float read_sensor_value(void) {
+    gpio_set_level(SENSOR_POWER, 1);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    sensor_acq_stats.settle_sleeps++;
+
+    uint32_t adc_reading = adc1_get_raw(ADC1_CHANNEL_0);
+    sensor_acq_stats.adc_reads++;
 
     gpio_set_level(SENSOR_POWER, 0);
-    return sensor_value;
+    return sensor_raw_to_value(adc_reading);
 }
 
 static void sensor_timer_callback(TimerHandle_t timer) {
+    wdt_checkin(wdt_id_sensor);
+
     sensor_data_t sensor_data;
 
     sensor_data.value = read_sensor_value();
     sensor_data.timestamp = xTaskGetTickCount();
-    sensor_data.valid = (sensor_data.value >= 0 && sensor_data.value <= 50);
+    sensor_data.valid = sensor_value_valid(sensor_data.value);
 
     health_stats.sensor_readings++;
 
     // ใช้เวอร์ชัน non-ISR (เพราะ callback ของ software timer ไม่ใช่ ISR)
+    sensor_acq_stats.handoffs++;
+#if SENSOR_SPSC_RING
+    if (!spsc_ring_send(&sensor_handoff, &sensor_data)) {
+#else
     if (xQueueSend(sensor_queue, &sensor_data, 0) != pdTRUE) {
-        ESP_LOGW(TAG, "Sensor queue full - dropping sample");
+#endif
+        sensor_acq_stats.overruns++;
+        HOT_LOGW(TAG, "Sensor queue full - dropping sample");
     }
 
-    TickType_t new_period;
-    if (sensor_data.value > 40.0f) {
-        new_period = pdMS_TO_TICKS(500);
-    } else if (sensor_data.value > 25.0f) {
-        new_period = pdMS_TO_TICKS(1000);
-    } else {
-        new_period = pdMS_TO_TICKS(2000);
-    }
-    xTimerChangePeriod(sensor_timer, new_period, 0);
+    sensor_sampler_feed(timer, sensor_data.value);
+}
+#endif
+
+// ================ STREAMING STATISTICS ================
+// Written only by sensor_processing_task; the status report reads it
+typedef struct {
+    stream_stats_t total;       // since boot
+    stream_stats_t window;      // current averaging window
+    stream_median_t median;     // last SENSOR_MEDIAN_WINDOW samples
+    stream_ema_t trend;
+} sensor_stream_t;
+
+static sensor_stream_t sensor_stream;
+
+static void sensor_stream_init(void) {
+    stream_stats_reset(&sensor_stream.total);
+    stream_stats_reset(&sensor_stream.window);
+    stream_median_init(&sensor_stream.median, SENSOR_MEDIAN_WINDOW);
+    stream_ema_init(&sensor_stream.trend, SENSOR_TREND_ALPHA);
+}
+
+static void sensor_stream_add(float value) {
+    stream_stats_add(&sensor_stream.total, value);
+    stream_stats_add(&sensor_stream.window, value);
+    stream_median_add(&sensor_stream.median, value);
+    stream_ema_add(&sensor_stream.trend, value);
 }
 
 // ================ STATUS SYSTEM ================
 static void status_timer_callback(TimerHandle_t timer) {
+    wdt_checkin(wdt_id_status);
+    timer_accuracy_update(&status_accuracy, timer);
+
     health_stats.system_uptime_sec = pdTICKS_TO_MS(xTaskGetTickCount()) / 1000;
 
-    ESP_LOGI(TAG, "\n═══════ SYSTEM STATUS ═══════");
-    ESP_LOGI(TAG, "Uptime: %lu seconds", health_stats.system_uptime_sec);
-    ESP_LOGI(TAG, "System Health: %s", health_stats.system_healthy ? "✅ HEALTHY" : "❌ ISSUES");
-    ESP_LOGI(TAG, "Watchdog Feeds: %lu", health_stats.watchdog_feeds);
-    ESP_LOGI(TAG, "Watchdog Timeouts: %lu", health_stats.watchdog_timeouts);
-    ESP_LOGI(TAG, "Pattern Changes: %lu", health_stats.pattern_changes);
-    ESP_LOGI(TAG, "Sensor Readings: %lu", health_stats.sensor_readings);
-    ESP_LOGI(TAG, "Current Pattern: %d", current_pattern);
-
-    ESP_LOGI(TAG, "Timer States:");
-    ESP_LOGI(TAG, "  Watchdog: %s", xTimerIsTimerActive(watchdog_timer) ? "ACTIVE" : "INACTIVE");
-    ESP_LOGI(TAG, "  Feed: %s", xTimerIsTimerActive(feed_timer) ? "ACTIVE" : "INACTIVE");
-    ESP_LOGI(TAG, "  Pattern: %s", xTimerIsTimerActive(pattern_timer) ? "ACTIVE" : "INACTIVE");
-    ESP_LOGI(TAG, "  Sensor: %s", xTimerIsTimerActive(sensor_timer) ? "ACTIVE" : "INACTIVE");
-    ESP_LOGI(TAG, "════════════════════════════\n");
+    HOT_LOGI(TAG, "\n═══════ SYSTEM STATUS ═══════");
+    HOT_LOGI(TAG, "Uptime: %lu seconds", health_stats.system_uptime_sec);
+    HOT_LOGI(TAG, "System Health: %s", health_stats.system_healthy ? "✅ HEALTHY" : "❌ ISSUES");
+    HOT_LOGI(TAG, "Watchdog Feeds: %lu", health_stats.watchdog_feeds);
+    HOT_LOGI(TAG, "Watchdog Timeouts: %lu", health_stats.watchdog_timeouts);
+    HOT_LOGI(TAG, "Pattern Changes: %lu", health_stats.pattern_changes);
+    HOT_LOGI(TAG, "Sensor Readings: %lu", health_stats.sensor_readings);
+    if (health_stats.system_uptime_sec > 0) {
+        float secs = health_stats.system_uptime_sec;
+        HOT_LOGI(TAG, "Sensor Acquisition (%s): %.2f ADC reads/s, %.2f hand-offs/s, %.2f settle sleeps/s",
+                 SENSOR_BLOCK_MODE ? "block" : "single",
+                 sensor_acq_stats.adc_reads / secs, sensor_acq_stats.handoffs / secs,
+                 sensor_acq_stats.settle_sleeps / secs);
+        HOT_LOGI(TAG, "  Blocks: %lu, overruns: %lu", sensor_acq_stats.blocks, sensor_acq_stats.overruns);
+    }
+    adaptive_sampler_log(&sensor_sampler, TAG, "Sensor", pdTICKS_TO_MS(xTaskGetTickCount()));
+    if (sensor_stream.total.n > 0) {
+        HOT_LOGI(TAG, "Sensor Stats: n=%lu mean=%.2f sd=%.2f range=%.2f..%.2f median(%d)=%.2f trend=%.2f",
+                 sensor_stream.total.n, sensor_stream.total.mean,
+                 stream_stats_stddev(&sensor_stream.total),
+                 sensor_stream.total.min, sensor_stream.total.max, SENSOR_MEDIAN_WINDOW,
+                 stream_median_get(&sensor_stream.median), sensor_stream.trend.value);
+    }
+    HOT_LOGI(TAG, "Current Pattern: %s", pattern_names[current_pattern]);
+
+    HOT_LOGI(TAG, "Timer States:");
+    HOT_LOGI(TAG, "  Watchdog: %s", xTimerIsTimerActive(wdt_supervisor_timer) ? "ACTIVE" : "INACTIVE");
+    HOT_LOGI(TAG, "  Feed: %s", xTimerIsTimerActive(feed_timer) ? "ACTIVE" : "INACTIVE");
+    HOT_LOGI(TAG, "  Pattern: %s", xTimerIsTimerActive(pattern_timer) ? "ACTIVE" : "INACTIVE");
+    HOT_LOGI(TAG, "  Sensor: %s", xTimerIsTimerActive(sensor_timer) ? "ACTIVE" : "INACTIVE");
+
+    HOT_LOGI(TAG, "Watchdog Clients:");
+    wdt_log_clients();
+
+    HOT_LOGI(TAG, "Timer Accuracy (%s):", USE_GPIO_SEQUENCER ? "sequencer" : "blocking");
+    log_accuracy("Feed", &feed_accuracy);
+    log_accuracy("Pattern", &pattern_accuracy);
+    log_accuracy("Status", &status_accuracy);
+    uint32_t seq_played, seq_dropped;
+    gpio_seq_get_stats(&seq_played, &seq_dropped);
+    HOT_LOGI(TAG, "  Sequences played: %lu, dropped: %lu", seq_played, seq_dropped);
+    HOT_LOGI(TAG, "Pattern System (%s):", USE_PATTERN_ENGINE ? "table engine" : "switch");
+    HOT_LOGI(TAG, "  Steps: %lu, timer commands: %lu (%.2f per step)",
+             pattern_stats.steps, pattern_stats.timer_commands,
+             pattern_stats.steps ? (float)pattern_stats.timer_commands / pattern_stats.steps : 0.0f);
+    HOT_LOGI(TAG, "  CPU per step: avg=%.1fus max=%luus",
+             pattern_stats.steps ? (float)pattern_stats.cpu_us_total / pattern_stats.steps : 0.0f,
+             pattern_stats.cpu_us_max);
+#if USE_DEFERRED_LOG
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        dlog_stats_t dlog;
+        deferred_log_get_stats(core, &dlog);
+        HOT_LOGI(TAG, "Deferred Log core %d: %lu records, %lu dropped, peak %lu/%d",
+                 core, dlog.written, dlog.dropped, dlog.high_water, DLOG_RING_RECORDS);
+    }
+#endif
+    HOT_LOGI(TAG, "════════════════════════════\n");
 
+#if USE_GPIO_SEQUENCER
+    gpio_seq_play(&status_flash_seq);
+#else
     gpio_set_level(STATUS_LED, 1);
     vTaskDelay(pdMS_TO_TICKS(200));
     gpio_set_level(STATUS_LED, 0);
+#endif
+}
+
+#if RUN_STATS_BENCHMARK
+#define STATS_BENCH_SAMPLES     1000
+
+// Per-sample cost of the streaming update versus recomputing the same
+// statistics over a SENSOR_MEDIAN_WINDOW buffer (median by insertion sort)
+static void benchmark_streaming_stats(void) {
+    static float input[STATS_BENCH_SAMPLES];
+    float ring[SENSOR_MEDIAN_WINDOW];
+    float sorted[SENSOR_MEDIAN_WINDOW];
+    volatile float sink = 0;
+
+    for (int i = 0; i < STATS_BENCH_SAMPLES; i++) {
+        input[i] = 25.0f + (esp_random() % 1000) / 100.0f;
+    }
+
+    stream_stats_t stats;
+    stream_median_t median;
+    stream_ema_t ema;
+    stream_stats_reset(&stats);
+    stream_median_init(&median, SENSOR_MEDIAN_WINDOW);
+    stream_ema_init(&ema, SENSOR_TREND_ALPHA);
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < STATS_BENCH_SAMPLES; i++) {
+        stream_stats_add(&stats, input[i]);
+        stream_median_add(&median, input[i]);
+        stream_ema_add(&ema, input[i]);
+        sink = stats.mean + stream_stats_variance(&stats) + stream_median_get(&median) + ema.value;
+    }
+    int64_t streaming_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < STATS_BENCH_SAMPLES; i++) {
+        ring[i % SENSOR_MEDIAN_WINDOW] = input[i];
+        int n = i + 1 < SENSOR_MEDIAN_WINDOW ? i + 1 : SENSOR_MEDIAN_WINDOW;
+
+        float sum = 0, min = INFINITY, max = -INFINITY;
+        for (int k = 0; k < n; k++) {
+            sum += ring[k];
+            if (ring[k] < min) min = ring[k];
+            if (ring[k] > max) max = ring[k];
+        }
+        float mean = sum / n;
+        float sq = 0;
+        for (int k = 0; k < n; k++) {
+            sq += (ring[k] - mean) * (ring[k] - mean);
+        }
+
+        for (int k = 0; k < n; k++) {
+            float v = ring[k];
+            int j = k;
+            while (j > 0 && sorted[j - 1] > v) {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = v;
+        }
+        float med = (n & 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0f;
+
+        sink = mean + (n > 1 ? sq / (n - 1) : 0) + med + min + max;
+    }
+    int64_t recompute_us = esp_timer_get_time() - start;
+    (void)sink;
+
+    ESP_LOGI(TAG, "📐 Stats benchmark (%d samples, window %d):",
+             STATS_BENCH_SAMPLES, SENSOR_MEDIAN_WINDOW);
+    ESP_LOGI(TAG, "  Streaming: %.2fus/sample, recompute: %.2fus/sample (%.1fx)",
+             (float)streaming_us / STATS_BENCH_SAMPLES, (float)recompute_us / STATS_BENCH_SAMPLES,
+             streaming_us ? (float)recompute_us / streaming_us : 0.0f);
 }
+#endif
 
 // ================ PROCESSING TASKS ================
+static void check_temperature_average(float average, led_pattern_t* active_alert) {
+    ESP_LOGI(TAG, "📊 Temperature Average: %.2f°C", average);
+
+    led_pattern_t alert = PATTERN_OFF;
+    if (average > 35.0f) {
+        ESP_LOGW(TAG, "🔥 High temperature warning!");
+        alert = PATTERN_FAST_BLINK;
+    } else if (average < 15.0f) {
+        ESP_LOGW(TAG, "🧊 Low temperature warning!");
+        alert = PATTERN_SOS;
+    }
+    if (alert != *active_alert) {
+        show_alert_pattern(alert);
+        *active_alert = alert;
+    }
+}
+
+#if SENSOR_BLOCK_MODE
+static void sensor_processing_task(void *parameter) {
+    led_pattern_t active_alert = PATTERN_OFF;
+
+    ESP_LOGI(TAG, "Sensor processing task started (block mode: %d samples, decimation %d)",
+             SENSOR_BLOCK_SAMPLES, SENSOR_DECIMATION);
+
+    while (1) {
+        // Wake at least once a second so the watchdog sees the task alive
+        // while a block is still filling
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        wdt_checkin(wdt_id_sensor_proc);
+
+        unsigned tail = atomic_load_explicit(&sensor_ring_tail, memory_order_relaxed);
+        while (tail != atomic_load_explicit(&sensor_ring_head, memory_order_acquire)) {
+            const sensor_block_t* block = &sensor_ring[tail % SENSOR_RING_BLOCKS];
+            const stream_stats_t* window = &sensor_stream.window;
+
+            stream_stats_reset(&sensor_stream.window);
+            for (int i = 0; i < SENSOR_BLOCK_SAMPLES; i++) {
+                float value = block->samples[i];
+                if ((block->valid_mask & (1u << i)) == 0) {
+                    ESP_LOGW(TAG, "Invalid sensor reading: %.2f", value);
+                    continue;
+                }
+                sensor_stream_add(value);
+            }
+
+            ESP_LOGI(TAG, "🌡️ Sensor block: %lu/%d valid, %.2f..%.2f°C, sd=%.2f, median=%.2f, trend=%.2f from %lu to %lu ms",
+                     window->n, SENSOR_BLOCK_SAMPLES, window->min, window->max,
+                     stream_stats_stddev(window), stream_median_get(&sensor_stream.median),
+                     sensor_stream.trend.value, block->first_timestamp, block->last_timestamp);
+            if (window->n > 0) {
+                check_temperature_average(window->mean, &active_alert);
+            }
+
+            atomic_store_explicit(&sensor_ring_tail, ++tail, memory_order_release);
+        }
+    }
+}
+#else
 static void sensor_processing_task(void *parameter) {
     sensor_data_t sensor_data;
-    float temp_sum = 0;
-    int sample_count = 0;
+    led_pattern_t active_alert = PATTERN_OFF;
 
     ESP_LOGI(TAG, "Sensor processing task started");
 
     while (1) {
+#if SENSOR_SPSC_RING
+        if (spsc_ring_receive(&sensor_handoff, &sensor_data, portMAX_DELAY)) {
+#else
         if (xQueueReceive(sensor_queue, &sensor_data, portMAX_DELAY) == pdTRUE) {
+#endif
+            wdt_checkin(wdt_id_sensor_proc);
+
             if (sensor_data.valid) {
-                temp_sum += sensor_data.value;
-                sample_count++;
-
-                ESP_LOGI(TAG, "🌡️ Sensor: %.2f°C at %lu ms",
-                         sensor_data.value, sensor_data.timestamp);
-
-                if (sample_count >= 10) {
-                    float average = temp_sum / sample_count;
-                    ESP_LOGI(TAG, "📊 Temperature Average: %.2f°C", average);
-
-                    if (average > 35.0f) {
-                        ESP_LOGW(TAG, "🔥 High temperature warning!");
-                        change_led_pattern(PATTERN_FAST_BLINK);
-                    } else if (average < 15.0f) {
-                        ESP_LOGW(TAG, "🧊 Low temperature warning!");
-                        change_led_pattern(PATTERN_SOS);
-                    }
-
-                    temp_sum = 0;
-                    sample_count = 0;
+                sensor_stream_add(sensor_data.value);
+
+                ESP_LOGI(TAG, "🌡️ Sensor: %.2f°C at %lu ms (median %.2f, trend %.2f)",
+                         sensor_data.value, sensor_data.timestamp,
+                         stream_median_get(&sensor_stream.median), sensor_stream.trend.value);
+
+                if (sensor_stream.window.n >= SENSOR_AVERAGE_SAMPLES) {
+                    check_temperature_average(sensor_stream.window.mean, &active_alert);
+                    stream_stats_reset(&sensor_stream.window);
                 }
             } else {
                 ESP_LOGW(TAG, "Invalid sensor reading: %.2f", sensor_data.value);
@@ -350,6 +1183,7 @@ static void sensor_processing_task(void *parameter) {
         }
     }
 }
+#endif
 
 static void system_monitor_task(void *parameter) {
     ESP_LOGI(TAG, "System monitor task started");
@@ -393,6 +1227,10 @@ static void init_hardware(void) {
     gpio_set_level(PATTERN_LED_3, 0);
     gpio_set_level(SENSOR_POWER, 0);
 
+    gpio_seq_init();
+    sensor_sampler_init();
+    sensor_stream_init();
+
     adc1_config_width(ADC_WIDTH_BIT_12);
     adc1_config_channel_atten(ADC1_CHANNEL_0, ADC_ATTEN_DB_11);
 
@@ -403,10 +1241,10 @@ static void init_hardware(void) {
 }
 
 static void create_timers(void) {
-    watchdog_timer = xTimerCreate("WatchdogTimer",
-                                 pdMS_TO_TICKS(WATCHDOG_TIMEOUT_MS),
-                                 pdFALSE, (void*)1,
-                                 watchdog_timeout_callback);
+    wdt_supervisor_timer = xTimerCreate("WdtSupervisor",
+                                       pdMS_TO_TICKS(WATCHDOG_WINDOW_MS),
+                                       pdTRUE, (void*)1,
+                                       wdt_supervisor_callback);
 
     feed_timer = xTimerCreate("FeedTimer",
                              pdMS_TO_TICKS(WATCHDOG_FEED_MS),
@@ -419,7 +1257,7 @@ static void create_timers(void) {
                                 pattern_timer_callback);
 
     sensor_timer = xTimerCreate("SensorTimer",
-                               pdMS_TO_TICKS(SENSOR_SAMPLE_MS),
+                               pdMS_TO_TICKS(SENSOR_SAMPLE_MS / SENSOR_READS_PER_SAMPLE),
                                pdTRUE, (void*)4,
                                sensor_timer_callback);
 
@@ -428,7 +1266,7 @@ static void create_timers(void) {
                                pdTRUE, (void*)5,
                                status_timer_callback);
 
-    if (!watchdog_timer || !feed_timer || !pattern_timer || !sensor_timer || !status_timer) {
+    if (!wdt_supervisor_timer || !feed_timer || !pattern_timer || !sensor_timer || !status_timer) {
         ESP_LOGE(TAG, "Failed to create one or more timers");
         return;
     }
@@ -437,10 +1275,16 @@ static void create_timers(void) {
 }
 
 static void create_queues(void) {
+#if SENSOR_SPSC_RING
+    bool sensor_ok = spsc_ring_init(&sensor_handoff, sensor_handoff_storage,
+                                    SENSOR_HANDOFF_LEN, sizeof(sensor_data_t));
+#else
     sensor_queue = xQueueCreate(20, sizeof(sensor_data_t));
+    bool sensor_ok = sensor_queue != NULL;
+#endif
     pattern_queue = xQueueCreate(10, sizeof(led_pattern_t));
 
-    if (!sensor_queue || !pattern_queue) {
+    if (!sensor_ok || !pattern_queue) {
         ESP_LOGE(TAG, "Failed to create queues");
         return;
     }
@@ -451,15 +1295,30 @@ static void create_queues(void) {
 static void start_system(void) {
     ESP_LOGI(TAG, "Starting timer system...");
 
-    xTimerStart(watchdog_timer, 0);
+    wdt_id_feeder = wdt_register("Feeder", WATCHDOG_TIMEOUT_MS);
+    wdt_id_pattern = wdt_register("Pattern", 4000);
+    wdt_id_sensor = wdt_register("Sensor", 2 * SENSOR_MAX_PERIOD_MS);
+    wdt_id_sensor_proc = wdt_register("SensorProc", 2 * SENSOR_MAX_PERIOD_MS);
+    wdt_id_status = wdt_register("Status", 2 * STATUS_UPDATE_MS);
+
+    // The block producer notifies SensorProc, so it must exist first
+#if SENSOR_BLOCK_MODE
+    xTaskCreate(sensor_processing_task, "SensorProc", 2048, NULL, 6, &sensor_proc_task_handle);
+    sensor_block_start();
+#else
+    xTaskCreate(sensor_processing_task, "SensorProc", 2048, NULL, 6, NULL);
+#endif
+    xTaskCreate(system_monitor_task, "SysMonitor", 2048, NULL, 3, NULL);
+#if USE_DEFERRED_LOG
+    deferred_log_start(DEFERRED_LOG_PRIORITY, tskNO_AFFINITY, false);
+#endif
+
+    xTimerStart(wdt_supervisor_timer, 0);
     xTimerStart(feed_timer, 0);
     xTimerStart(pattern_timer, 0);
     xTimerStart(sensor_timer, 0);
     xTimerStart(status_timer, 0);
 
-    xTaskCreate(sensor_processing_task, "SensorProc", 2048, NULL, 6, NULL);
-    xTaskCreate(system_monitor_task, "SysMonitor", 2048, NULL, 3, NULL);
-
     ESP_LOGI(TAG, "🚀 Timer Applications System Started!");
     ESP_LOGI(TAG, "Watch the LEDs for different patterns and system status");
 }
@@ -468,6 +1327,9 @@ void app_main(void) {
     ESP_LOGI(TAG, "Timer Applications Lab Starting...");
 
     init_hardware();
+#if RUN_STATS_BENCHMARK
+    benchmark_streaming_stats();
+#endif
     create_queues();
     create_timers();
     start_system();
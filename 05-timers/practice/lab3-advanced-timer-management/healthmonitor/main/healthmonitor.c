@@ -14,6 +14,8 @@
 #include "esp_timer.h"
 #include "esp_system.h"
 #include "esp_random.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
 #include "driver/gpio.h"
 
 static const char *TAG = "ADV_TIMERS";
@@ -28,6 +30,25 @@ static const char *TAG = "ADV_TIMERS";
 #define PERFORMANCE_BUFFER_SIZE      100
 #define HEALTH_CHECK_INTERVAL        1000
 
+// Callback offload: timers whose callbacks overrun repeatedly are moved off
+// the timer service task onto a small worker pool (0 = always run inline)
+#define OFFLOAD_ENABLED              1
+#define OFFLOAD_WORKER_COUNT         2
+#define OFFLOAD_QUEUE_LENGTH         8
+#define OFFLOAD_OVERRUN_US           1000
+#define OFFLOAD_AFTER_OVERRUNS       3
+#define OFFLOAD_DRAIN_TIMEOUT_MS     500     // release waits this long, then the last job frees the slot
+
+// Service task profiler: windows of HEALTH_CHECK_INTERVAL, averaged over
+// PROFILER_WINDOWS. A callback using PROFILER_HOG_PERCENT of wall time, or
+// the top callback while the task is PROFILER_SATURATION_PERCENT busy, is
+// flagged as saturating the service task.
+#define PROFILER_MAX_CALLBACKS       32
+#define PROFILER_WINDOWS             10
+#define PROFILER_HOG_PERCENT         25
+#define PROFILER_SATURATION_PERCENT  70
+#define PROFILER_CYCLES_PER_US       CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+
 // LEDs for visual feedback
 #define PERFORMANCE_LED     GPIO_NUM_2
 #define HEALTH_LED          GPIO_NUM_4
@@ -36,6 +57,20 @@ static const char *TAG = "ADV_TIMERS";
 
 // ================ DATA STRUCTURES ================
 
+// Per-callback service task time
+typedef struct {
+    bool used;
+    TimerHandle_t handle;
+    uint32_t timer_id;
+    char name[16];
+    TimerCallbackFunction_t callback;   // NULL for pool timers (own dispatcher)
+    uint32_t calls;
+    uint64_t total_cycles;
+    uint32_t window_cycles;             // current window
+    uint32_t last_window_cycles;        // last closed window
+    uint32_t max_cycles;
+} callback_profile_t;
+
 // Timer Pool Entry
 typedef struct {
     TimerHandle_t handle;
@@ -49,6 +84,13 @@ typedef struct {
     uint32_t creation_time;
     uint32_t start_count;
     uint32_t callback_count;
+    uint32_t last_callback_us;      // per-timer interval for accuracy checks
+    uint32_t consecutive_overruns;
+    bool offloaded;                 // callback runs on an offload worker
+    bool releasing;                 // no new jobs; release waits for pending_jobs
+    bool free_on_drain;             // release timed out; the last job frees the slot
+    uint32_t pending_jobs;          // queued or running on a worker (offload_lock)
+    callback_profile_t* profile;
 } timer_pool_entry_t;
 
 // Performance Metrics
@@ -72,9 +114,30 @@ typedef struct {
     uint32_t command_failures;
     float average_accuracy;
     uint32_t service_task_load_percent;
+    uint32_t service_task_load_avg_percent;     // over PROFILER_WINDOWS
+    uint32_t top_callback_id;
+    uint32_t top_callback_percent;              // of wall time, last window
+    char top_callback_name[16];
     uint32_t free_heap_bytes;
 } timer_health_t;
 
+// Job handed from the timer service task to an offload worker
+typedef struct {
+    timer_pool_entry_t* entry;
+    uint32_t timer_id;
+} offload_job_t;
+
+// Offload statistics
+typedef struct {
+    uint32_t offloaded_timers;
+    uint32_t queued_jobs;
+    uint32_t executed_jobs;
+    uint32_t dropped_jobs;
+    uint32_t deferred_frees;        // releases that left the slot to the last job
+    uint32_t window_accurate;       // accuracy of inline timers since last report
+    uint32_t window_samples;
+} offload_stats_t;
+
 // ================ GLOBAL VARIABLES ================
 
 // Timer Pool Management
@@ -96,13 +159,211 @@ TimerHandle_t performance_timer;
 TimerHandle_t dynamic_timers[DYNAMIC_TIMER_MAX];
 uint32_t dynamic_timer_count = 0;
 
+// Callback Offload Workers
+QueueHandle_t offload_queues[OFFLOAD_WORKER_COUNT];
+offload_stats_t offload_stats = {0};
+// Guards offload_stats and every entry's releasing/pending_jobs: the
+// counters are bumped from the timer service task and the workers
+static portMUX_TYPE offload_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Service Task Profiler
+callback_profile_t callback_profiles[PROFILER_MAX_CALLBACKS];
+static portMUX_TYPE profiler_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t profiler_window_start_us = 0;
+static uint32_t profiler_window_busy_us[PROFILER_WINDOWS];
+static uint32_t profiler_window_elapsed_us[PROFILER_WINDOWS];
+static uint32_t profiler_window_index = 0;
+
 // Test Infrastructure
 QueueHandle_t test_result_queue;
 TaskHandle_t stress_test_task_handle;
 
-// (Exp4) เก็บ handle heavy timers ให้ task recovery เข้าถึงได้
-static TimerHandle_t g_heavy_h1 = NULL;
-static TimerHandle_t g_heavy_h2 = NULL;
+// (Exp4) เก็บ heavy timers ให้ task recovery เข้าถึงได้
+static timer_pool_entry_t* g_heavy_h1 = NULL;
+static timer_pool_entry_t* g_heavy_h2 = NULL;
+
+void timer_dispatch_callback(TimerHandle_t timer);
+
+// ================ SERVICE TASK PROFILER ================
+// Every profiled callback is timed in CPU cycles and charged to its profile
+// slot. Pool timers are timed by timer_dispatch_callback. Other timers are
+// created with profiler_dispatch as their callback, which finds the slot by
+// handle. health_monitor_callback closes a window once per
+// HEALTH_CHECK_INTERVAL and turns the cycles into busy fractions.
+//
+// The timer service task has no core affinity. If it migrates mid-callback,
+// the two cycle counters are unrelated, so that run is timed with
+// esp_timer instead. Time spent preempted inside a callback is charged to
+// it, as is the time the dispatcher spends queueing offloaded jobs.
+
+typedef struct {
+    uint32_t cycles;
+    int64_t us;
+    BaseType_t core;
+} profile_mark_t;
+
+static inline void profiler_begin(profile_mark_t* mark) {
+    mark->core = xPortGetCoreID();
+    mark->us = esp_timer_get_time();
+    mark->cycles = esp_cpu_get_cycle_count();
+}
+
+static inline uint32_t profiler_elapsed_cycles(const profile_mark_t* mark) {
+    uint32_t cycles = esp_cpu_get_cycle_count() - mark->cycles;
+    if (xPortGetCoreID() != mark->core) {
+        cycles = (uint32_t)(esp_timer_get_time() - mark->us) * PROFILER_CYCLES_PER_US;
+    }
+    return cycles;
+}
+
+static inline void profiler_record(callback_profile_t* profile, uint32_t cycles) {
+    if (profile == NULL) return;
+    profile->calls++;
+    profile->total_cycles += cycles;
+    profile->window_cycles += cycles;
+    if (cycles > profile->max_cycles) {
+        profile->max_cycles = cycles;
+    }
+}
+
+callback_profile_t* profiler_register(TimerHandle_t handle, uint32_t timer_id,
+                                      const char* name, TimerCallbackFunction_t callback) {
+    callback_profile_t* profile = NULL;
+
+    portENTER_CRITICAL(&profiler_lock);
+    for (int i = 0; i < PROFILER_MAX_CALLBACKS; i++) {
+        if (!callback_profiles[i].used) {
+            profile = &callback_profiles[i];
+            memset(profile, 0, sizeof(*profile));
+            profile->handle = handle;
+            profile->timer_id = timer_id;
+            profile->callback = callback;
+            strncpy(profile->name, name, sizeof(profile->name) - 1);
+            profile->used = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&profiler_lock);
+
+    if (profile == NULL) {
+        ESP_LOGW(TAG, "Profiler full - %s runs unprofiled", name);
+    }
+    return profile;
+}
+
+void profiler_unregister(callback_profile_t* profile) {
+    if (profile == NULL) return;
+    portENTER_CRITICAL(&profiler_lock);
+    profile->used = false;
+    profile->handle = NULL;
+    portEXIT_CRITICAL(&profiler_lock);
+}
+
+callback_profile_t* profiler_find(TimerHandle_t handle) {
+    for (int i = 0; i < PROFILER_MAX_CALLBACKS; i++) {
+        if (callback_profiles[i].used && callback_profiles[i].handle == handle) {
+            return &callback_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+// Timer callback for non-pool timers: times the registered callback
+void profiler_dispatch(TimerHandle_t timer) {
+    callback_profile_t* profile = profiler_find(timer);
+    if (profile == NULL || profile->callback == NULL) {
+        return;
+    }
+
+    profile_mark_t mark;
+    profiler_begin(&mark);
+    profile->callback(timer);
+    profiler_record(profile, profiler_elapsed_cycles(&mark));
+}
+
+TimerHandle_t create_profiled_timer(const char* name, TickType_t period, bool auto_reload,
+                                    uint32_t timer_id, TimerCallbackFunction_t callback) {
+    TimerHandle_t timer = xTimerCreate(name, period, auto_reload, (void*)timer_id,
+                                       profiler_dispatch);
+    if (timer != NULL) {
+        profiler_register(timer, timer_id, name, callback);
+    }
+    return timer;
+}
+
+// Close the current window: publish the service task load and the heaviest
+// callback into health_data. Runs on the timer service task.
+void profiler_roll_window(void) {
+    int64_t now = esp_timer_get_time();
+    uint32_t elapsed_us = (uint32_t)(now - profiler_window_start_us);
+    if (profiler_window_start_us == 0 || elapsed_us == 0) {
+        profiler_window_start_us = now;
+        return;
+    }
+    profiler_window_start_us = now;
+
+    uint64_t busy_cycles = 0;
+    callback_profile_t* top = NULL;
+    for (int i = 0; i < PROFILER_MAX_CALLBACKS; i++) {
+        callback_profile_t* p = &callback_profiles[i];
+        p->last_window_cycles = p->window_cycles;
+        p->window_cycles = 0;
+        if (!p->used) continue;
+
+        busy_cycles += p->last_window_cycles;
+        if (top == NULL || p->last_window_cycles > top->last_window_cycles) {
+            top = p;
+        }
+    }
+
+    uint32_t busy_us = (uint32_t)(busy_cycles / PROFILER_CYCLES_PER_US);
+    int slot = profiler_window_index++ % PROFILER_WINDOWS;
+    profiler_window_busy_us[slot] = busy_us;
+    profiler_window_elapsed_us[slot] = elapsed_us;
+
+    uint64_t sum_busy = 0, sum_elapsed = 0;
+    for (int i = 0; i < PROFILER_WINDOWS; i++) {
+        sum_busy += profiler_window_busy_us[i];
+        sum_elapsed += profiler_window_elapsed_us[i];
+    }
+
+    uint32_t load = (uint32_t)((uint64_t)busy_us * 100 / elapsed_us);
+    health_data.service_task_load_percent = load > 100 ? 100 : load;
+    health_data.service_task_load_avg_percent =
+        sum_elapsed ? (uint32_t)(sum_busy * 100 / sum_elapsed) : 0;
+
+    if (top != NULL && top->last_window_cycles > 0) {
+        health_data.top_callback_id = top->timer_id;
+        health_data.top_callback_percent =
+            (uint32_t)((uint64_t)top->last_window_cycles / PROFILER_CYCLES_PER_US * 100 / elapsed_us);
+        strncpy(health_data.top_callback_name, top->name, sizeof(health_data.top_callback_name) - 1);
+    } else {
+        health_data.top_callback_id = 0;
+        health_data.top_callback_percent = 0;
+        health_data.top_callback_name[0] = '\0';
+    }
+}
+
+void profiler_report(void) {
+    uint64_t total = 0;
+    for (int i = 0; i < PROFILER_MAX_CALLBACKS; i++) {
+        if (callback_profiles[i].used) total += callback_profiles[i].total_cycles;
+    }
+
+    ESP_LOGI(TAG, "⏱️ Timer Service Profile (load %lu%% now, %lu%% over %ds):",
+             health_data.service_task_load_percent, health_data.service_task_load_avg_percent,
+             PROFILER_WINDOWS * HEALTH_CHECK_INTERVAL / 1000);
+    for (int i = 0; i < PROFILER_MAX_CALLBACKS; i++) {
+        const callback_profile_t* p = &callback_profiles[i];
+        if (!p->used || p->calls == 0) continue;
+
+        ESP_LOGI(TAG, "  %-14s #%-5lu calls=%-6lu avg=%5luμs max=%5luμs share=%.1f%%",
+                 p->name, p->timer_id, p->calls,
+                 (uint32_t)(p->total_cycles / p->calls / PROFILER_CYCLES_PER_US),
+                 p->max_cycles / PROFILER_CYCLES_PER_US,
+                 total ? (float)p->total_cycles * 100.0f / total : 0.0f);
+    }
+}
 
 // ================ TIMER POOL MANAGEMENT ================
 void init_timer_pool(void) {
@@ -116,6 +377,13 @@ void init_timer_pool(void) {
         timer_pool[i].creation_time = 0;
         timer_pool[i].start_count = 0;
         timer_pool[i].callback_count = 0;
+        timer_pool[i].last_callback_us = 0;
+        timer_pool[i].consecutive_overruns = 0;
+        timer_pool[i].offloaded = false;
+        timer_pool[i].releasing = false;
+        timer_pool[i].free_on_drain = false;
+        timer_pool[i].pending_jobs = 0;
+        timer_pool[i].profile = NULL;
     }
 
     ESP_LOGI(TAG, "Timer pool initialized with %d slots", TIMER_POOL_SIZE);
@@ -146,16 +414,24 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
             entry->creation_time = xTaskGetTickCount();
             entry->start_count = 0;
             entry->callback_count = 0;
-
-            // Create actual timer
+            entry->last_callback_us = 0;
+            entry->consecutive_overruns = 0;
+            entry->offloaded = false;
+            entry->releasing = false;
+            entry->free_on_drain = false;
+            entry->pending_jobs = 0;
+
+            // Create actual timer; every pool timer goes through the
+            // dispatcher so its run time can be measured
             entry->handle = xTimerCreate(name, period, auto_reload,
-                                       (void*)entry->id, callback);
+                                       (void*)entry->id, timer_dispatch_callback);
 
             if (entry->handle == NULL) {
                 entry->in_use = false;
                 entry = NULL;
                 health_data.failed_creations++;
             } else {
+                entry->profile = profiler_register(entry->handle, entry->id, entry->name, NULL);
                 health_data.total_timers_created++;
             }
             break;
@@ -171,24 +447,252 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
     return entry;
 }
 
+static bool drain_offload_jobs(timer_pool_entry_t* entry);
+
+// Deletes the timer and frees the slot once no job refers to it
+static void pool_slot_free(timer_pool_entry_t* entry) {
+    uint32_t timer_id = entry->id;
+
+    xSemaphoreTake(pool_mutex, portMAX_DELAY);
+    if (entry->handle) {
+        xTimerDelete(entry->handle, 0);
+    }
+    profiler_unregister(entry->profile);
+    entry->profile = NULL;
+    entry->in_use = false;
+    entry->handle = NULL;
+    xSemaphoreGive(pool_mutex);
+
+    ESP_LOGI(TAG, "Released timer %lu from pool", timer_id);
+}
+
 void release_to_pool(uint32_t timer_id) {
     if (xSemaphoreTake(pool_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
         return;
     }
 
+    // releasing only goes true under pool_mutex, so a second release of the
+    // same timer sees it and leaves the slot to the first
+    timer_pool_entry_t* entry = NULL;
     for (int i = 0; i < TIMER_POOL_SIZE; i++) {
-        if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
-            if (timer_pool[i].handle) {
-                xTimerDelete(timer_pool[i].handle, 0);
-            }
-            timer_pool[i].in_use = false;
-            timer_pool[i].handle = NULL;
-            ESP_LOGI(TAG, "Released timer %lu from pool", timer_id);
+        if (timer_pool[i].in_use && timer_pool[i].id == timer_id && !timer_pool[i].releasing) {
+            entry = &timer_pool[i];
+            portENTER_CRITICAL(&offload_lock);
+            entry->releasing = true;
+            portEXIT_CRITICAL(&offload_lock);
             break;
         }
     }
 
     xSemaphoreGive(pool_mutex);
+
+    // Workers may still hold jobs for this slot; keep it (and its handle)
+    // alive until they are done. The wait runs without pool_mutex.
+    if (entry != NULL && drain_offload_jobs(entry)) {
+        pool_slot_free(entry);
+    }
+}
+
+// ================ CALLBACK OFFLOAD ================
+// Pool timers are dispatched through timer_dispatch_callback, which times the
+// real callback. After OFFLOAD_AFTER_OVERRUNS consecutive runs longer than
+// OFFLOAD_OVERRUN_US the timer is marked offloaded: from then on the service
+// task only queues a job. A timer always maps to the same worker (slot %
+// OFFLOAD_WORKER_COUNT) and never returns to inline execution, so its
+// callbacks keep their order.
+
+// A queued job holds a reference (pending_jobs) on its entry until the
+// worker has run or skipped it. Release first sets `releasing`, so no new
+// jobs are queued, stops the timer and waits for the count to reach zero
+// before deleting the timer and freeing the slot. If the jobs outlast
+// OFFLOAD_DRAIN_TIMEOUT_MS the slot is marked free_on_drain and whoever
+// drops the last reference frees it.
+
+// Caller holds no lock; true if the caller must free the slot now
+static bool drain_offload_jobs(timer_pool_entry_t* entry) {
+    if (entry->handle) {
+        xTimerStop(entry->handle, pdMS_TO_TICKS(100));
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    while (1) {
+        portENTER_CRITICAL(&offload_lock);
+        bool drained = entry->pending_jobs == 0;
+        bool timed_out = !drained &&
+            xTaskGetTickCount() - start >= pdMS_TO_TICKS(OFFLOAD_DRAIN_TIMEOUT_MS);
+        if (timed_out) {
+            entry->free_on_drain = true;
+            offload_stats.deferred_frees++;
+        }
+        portEXIT_CRITICAL(&offload_lock);
+
+        if (drained) {
+            return true;
+        }
+        if (timed_out) {
+            ESP_LOGW(TAG, "Timer %lu still has offloaded jobs - freed after the last one",
+                     entry->id);
+            return false;
+        }
+        vTaskDelay(1);
+    }
+}
+
+// Drop one job reference; the last one out of a timed-out release frees the slot
+static void offload_job_put(timer_pool_entry_t* entry) {
+    portENTER_CRITICAL(&offload_lock);
+    bool free_slot = --entry->pending_jobs == 0 && entry->free_on_drain;
+    portEXIT_CRITICAL(&offload_lock);
+
+    if (free_slot) {
+        pool_slot_free(entry);
+    }
+}
+
+static timer_pool_entry_t* find_pool_entry(uint32_t timer_id) {
+    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
+        if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
+            return &timer_pool[i];
+        }
+    }
+    return NULL;
+}
+
+static void dispatch_pool_callback(TimerHandle_t timer, timer_pool_entry_t* entry,
+                                   uint32_t timer_id) {
+    if (entry->offloaded) {
+        offload_job_t job = { .entry = entry, .timer_id = timer_id };
+        int worker = (entry - timer_pool) % OFFLOAD_WORKER_COUNT;
+
+        portENTER_CRITICAL(&offload_lock);
+        bool releasing = entry->releasing;
+        if (!releasing) {
+            entry->pending_jobs++;
+        }
+        portEXIT_CRITICAL(&offload_lock);
+        if (releasing) {
+            return;
+        }
+
+        bool queued = xQueueSend(offload_queues[worker], &job, 0) == pdTRUE;
+        portENTER_CRITICAL(&offload_lock);
+        if (queued) {
+            offload_stats.queued_jobs++;
+        } else {
+            offload_stats.dropped_jobs++;
+        }
+        portEXIT_CRITICAL(&offload_lock);
+        if (!queued) {
+            offload_job_put(entry);
+        }
+        return;
+    }
+
+    uint32_t start_time = esp_timer_get_time();
+    entry->callback(timer);
+    uint32_t duration_us = (uint32_t)esp_timer_get_time() - start_time;
+
+    if (duration_us <= OFFLOAD_OVERRUN_US) {
+        entry->consecutive_overruns = 0;
+        return;
+    }
+
+    entry->consecutive_overruns++;
+    if (OFFLOAD_ENABLED && entry->consecutive_overruns >= OFFLOAD_AFTER_OVERRUNS &&
+        offload_queues[0] != NULL) {
+        entry->offloaded = true;
+        portENTER_CRITICAL(&offload_lock);
+        offload_stats.offloaded_timers++;
+        portEXIT_CRITICAL(&offload_lock);
+        ESP_LOGW(TAG, "🚚 Timer %s (%lu) overran %lu times (last %luμs) - offloading to worker %d",
+                 entry->name, timer_id, entry->consecutive_overruns, duration_us,
+                 (int)((entry - timer_pool) % OFFLOAD_WORKER_COUNT));
+    }
+}
+
+void timer_dispatch_callback(TimerHandle_t timer) {
+    uint32_t timer_id = (uint32_t)pvTimerGetTimerID(timer);
+    timer_pool_entry_t* entry = find_pool_entry(timer_id);
+
+    if (entry == NULL || entry->callback == NULL) {
+        return;
+    }
+
+    profile_mark_t mark;
+    profiler_begin(&mark);
+    dispatch_pool_callback(timer, entry, timer_id);
+    profiler_record(entry->profile, profiler_elapsed_cycles(&mark));
+}
+
+static void offload_worker_task(void *parameter) {
+    QueueHandle_t queue = (QueueHandle_t)parameter;
+    offload_job_t job;
+
+    while (1) {
+        if (xQueueReceive(queue, &job, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        // The job's reference keeps the slot and handle valid; skip it if
+        // a release is waiting
+        timer_pool_entry_t* entry = job.entry;
+        portENTER_CRITICAL(&offload_lock);
+        bool run = !entry->releasing && entry->id == job.timer_id;
+        portEXIT_CRITICAL(&offload_lock);
+
+        if (run) {
+            entry->callback(entry->handle);
+        }
+
+        if (run) {
+            portENTER_CRITICAL(&offload_lock);
+            offload_stats.executed_jobs++;
+            portEXIT_CRITICAL(&offload_lock);
+        }
+        offload_job_put(entry);
+    }
+}
+
+void init_offload_workers(void) {
+    // Run workers just below the timer service task so offloaded work never
+    // delays timer expiry processing
+    UBaseType_t service_priority = uxTaskPriorityGet(xTimerGetTimerDaemonTaskHandle());
+    UBaseType_t worker_priority = (service_priority > 1) ? service_priority - 1 : 1;
+
+    for (int i = 0; i < OFFLOAD_WORKER_COUNT; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "TmrWorker%d", i);
+
+        offload_queues[i] = xQueueCreate(OFFLOAD_QUEUE_LENGTH, sizeof(offload_job_t));
+        if (offload_queues[i] == NULL ||
+            xTaskCreate(offload_worker_task, name, 3072, offload_queues[i],
+                        worker_priority, NULL) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to start offload worker %d", i);
+        }
+    }
+
+    ESP_LOGI(TAG, "Offload workers: %d (priority %u, offload %s)",
+             OFFLOAD_WORKER_COUNT, worker_priority, OFFLOAD_ENABLED ? "enabled" : "disabled");
+}
+
+void report_offload_effect(void) {
+    portENTER_CRITICAL(&offload_lock);
+    offload_stats_t s = offload_stats;
+    offload_stats.window_samples = 0;
+    offload_stats.window_accurate = 0;
+    portEXIT_CRITICAL(&offload_lock);
+
+    uint32_t samples = s.window_samples;
+    uint32_t accurate = s.window_accurate;
+
+    ESP_LOGI(TAG, "🚚 Callback Offload:");
+    ESP_LOGI(TAG, "  Offloaded Timers: %lu", s.offloaded_timers);
+    ESP_LOGI(TAG, "  Jobs: queued=%lu executed=%lu dropped=%lu, deferred frees=%lu",
+             s.queued_jobs, s.executed_jobs, s.dropped_jobs, s.deferred_frees);
+    if (samples > 0) {
+        ESP_LOGI(TAG, "  Other Timers Accuracy (last window): %.1f%% (%lu/%lu)",
+                 (float)accurate / samples * 100.0f, accurate, samples);
+    }
 }
 
 // ================ PERFORMANCE MONITORING ================
@@ -276,27 +780,33 @@ void performance_test_callback(TimerHandle_t timer) {
     uint32_t end_time = esp_timer_get_time();
     uint32_t duration_us = end_time - start_time;
 
-    // Check accuracy (simplified)
+    // Check accuracy (simplified); pool timers track their own interval
     static uint32_t last_callback_time = 0;
+    timer_pool_entry_t* entry = find_pool_entry(timer_id);
+    uint32_t* last_time = entry ? &entry->last_callback_us : &last_callback_time;
     uint32_t expected_interval = pdTICKS_TO_MS(xTimerGetPeriod(timer)) * 1000; // μs
-    uint32_t actual_interval = start_time - last_callback_time;
+    uint32_t actual_interval = start_time - *last_time;
     bool accuracy_ok = true;
 
-    if (last_callback_time > 0) {
+    if (*last_time > 0) {
         uint32_t accuracy_percent = (actual_interval * 100) / expected_interval;
         accuracy_ok = (accuracy_percent >= 95 && accuracy_percent <= 105);
+
+        portENTER_CRITICAL(&offload_lock);
+        offload_stats.window_samples++;
+        if (accuracy_ok) {
+            offload_stats.window_accurate++;
+        }
+        portEXIT_CRITICAL(&offload_lock);
     }
 
-    last_callback_time = start_time;
+    *last_time = start_time;
 
     record_performance_sample(timer_id, duration_us, accuracy_ok);
 
     // Update timer stats
-    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
-        if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
-            timer_pool[i].callback_count++;
-            break;
-        }
+    if (entry != NULL) {
+        entry->callback_count++;
     }
 }
 
@@ -314,6 +824,7 @@ void stress_test_callback(TimerHandle_t timer) {
 void health_monitor_callback(TimerHandle_t timer) {
     // Update health metrics
     health_data.free_heap_bytes = esp_get_free_heap_size();
+    profiler_roll_window();
 
     uint32_t active_count = 0;
     uint32_t pool_used = 0;
@@ -334,8 +845,13 @@ void health_monitor_callback(TimerHandle_t timer) {
     health_data.pool_utilization = (pool_used * 100) / TIMER_POOL_SIZE;
     health_data.dynamic_timers = dynamic_timer_count;
 
+    bool saturating = health_data.top_callback_id != 0 &&
+                      (health_data.top_callback_percent >= PROFILER_HOG_PERCENT ||
+                       health_data.service_task_load_percent >= PROFILER_SATURATION_PERCENT);
+
     // Health status LED
-    gpio_set_level(HEALTH_LED, (health_data.pool_utilization > 80 || health_data.callback_overruns > 10) ? 1 : 0);
+    gpio_set_level(HEALTH_LED, (health_data.pool_utilization > 80 || health_data.callback_overruns > 10 ||
+                                saturating) ? 1 : 0);
 
     ESP_LOGI(TAG, "🏥 Health Monitor:");
     ESP_LOGI(TAG, "  Active Timers: %lu/%lu", active_count, pool_used);
@@ -343,6 +859,14 @@ void health_monitor_callback(TimerHandle_t timer) {
     ESP_LOGI(TAG, "  Dynamic Timers: %lu/%d", health_data.dynamic_timers, DYNAMIC_TIMER_MAX);
     ESP_LOGI(TAG, "  Free Heap: %lu bytes", health_data.free_heap_bytes);
     ESP_LOGI(TAG, "  Failed Creations: %lu", health_data.failed_creations);
+    ESP_LOGI(TAG, "  Service Task Load: %lu%% (last %dms), %lu%% (avg)",
+             health_data.service_task_load_percent, HEALTH_CHECK_INTERVAL,
+             health_data.service_task_load_avg_percent);
+    if (saturating) {
+        ESP_LOGW(TAG, "  ⚠️ %s (#%lu) is saturating the timer service task: %lu%% of the last window",
+                 health_data.top_callback_name, health_data.top_callback_id,
+                 health_data.top_callback_percent);
+    }
 }
 
 // ==== (เพิ่มเพื่อ Exp4 เท่านั้น) Heavy callback เพื่อกระตุ้น overrun ====
@@ -369,8 +893,8 @@ TimerHandle_t create_dynamic_timer(const char* name, uint32_t period_ms,
         return NULL;
     }
 
-    TimerHandle_t timer = xTimerCreate(name, pdMS_TO_TICKS(period_ms),
-                                     auto_reload, (void*)next_timer_id++, callback);
+    TimerHandle_t timer = create_profiled_timer(name, pdMS_TO_TICKS(period_ms),
+                                                auto_reload, next_timer_id++, callback);
 
     if (timer != NULL) {
         dynamic_timers[dynamic_timer_count] = timer;
@@ -384,6 +908,7 @@ TimerHandle_t create_dynamic_timer(const char* name, uint32_t period_ms,
 void cleanup_dynamic_timers(void) {
     for (uint32_t i = 0; i < dynamic_timer_count; i++) {
         if (dynamic_timers[i] != NULL) {
+            profiler_unregister(profiler_find(dynamic_timers[i]));
             xTimerDelete(dynamic_timers[i], pdMS_TO_TICKS(100));
             dynamic_timers[i] = NULL;
         }
@@ -461,6 +986,9 @@ void performance_analysis_task(void *parameter) {
         ESP_LOGI(TAG, "Command Failures: %lu", health_data.command_failures);
         ESP_LOGI(TAG, "═════════════════════════\n");
 
+        report_offload_effect();
+        profiler_report();
+
         // Memory usage check
         if (health_data.free_heap_bytes < 20000) {
             ESP_LOGW(TAG, "⚠️ Low memory warning: %lu bytes", health_data.free_heap_bytes);
@@ -496,18 +1024,18 @@ void init_monitoring(void) {
 
 void create_system_timers(void) {
     // Health monitor timer
-    health_monitor_timer = xTimerCreate("HealthMonitor",
-                                       pdMS_TO_TICKS(HEALTH_CHECK_INTERVAL),
-                                       pdTRUE, // Auto-reload
-                                       (void*)1,
-                                       health_monitor_callback);
+    health_monitor_timer = create_profiled_timer("HealthMonitor",
+                                                pdMS_TO_TICKS(HEALTH_CHECK_INTERVAL),
+                                                pdTRUE, // Auto-reload
+                                                1,
+                                                health_monitor_callback);
 
     // Performance test timer
-    performance_timer = xTimerCreate("PerfTest",
-                                    pdMS_TO_TICKS(500),
-                                    pdTRUE, // Auto-reload
-                                    (void*)2,
-                                    performance_test_callback);
+    performance_timer = create_profiled_timer("PerfTest",
+                                             pdMS_TO_TICKS(500),
+                                             pdTRUE, // Auto-reload
+                                             2,
+                                             performance_test_callback);
 
     if (health_monitor_timer && performance_timer) {
         xTimerStart(health_monitor_timer, 0);
@@ -527,11 +1055,12 @@ void app_main(void) {
     init_hardware();
     init_timer_pool();
     init_monitoring();
+    init_offload_workers();
 
     // สำหรับทุกโหมด: เปิด health monitor เสมอ
-    health_monitor_timer = xTimerCreate("HealthMonitor",
-                                       pdMS_TO_TICKS(HEALTH_CHECK_INTERVAL),
-                                       pdTRUE, (void*)1, health_monitor_callback);
+    health_monitor_timer = create_profiled_timer("HealthMonitor",
+                                                pdMS_TO_TICKS(HEALTH_CHECK_INTERVAL),
+                                                pdTRUE, 1, health_monitor_callback);
     if (health_monitor_timer) xTimerStart(health_monitor_timer, 0);
 
 #if (EXPERIMENT == 1)
@@ -562,10 +1091,10 @@ void app_main(void) {
     ESP_LOGI(TAG, "[EXP2] Performance Analysis");
 
     // โฟกัส performance timer + analysis; ไม่รัน stress test
-    performance_timer = xTimerCreate("PerfOnly",
-                                    pdMS_TO_TICKS(500),
-                                    pdTRUE, (void*)2,
-                                    performance_test_callback);
+    performance_timer = create_profiled_timer("PerfOnly",
+                                             pdMS_TO_TICKS(500),
+                                             pdTRUE, 2,
+                                             performance_test_callback);
     if (performance_timer) xTimerStart(performance_timer, 0);
 
     xTaskCreate(performance_analysis_task, "PerfAnalysis", 3072, NULL, 8, NULL);
@@ -590,10 +1119,11 @@ void app_main(void) {
     }
 
     // 2) Inject heavy timers ให้เกิด overrun / warning
-    g_heavy_h1 = xTimerCreate("Heavy1", pdMS_TO_TICKS(250), pdTRUE, (void*)next_timer_id++, heavy_overrun_callback);
-    g_heavy_h2 = xTimerCreate("Heavy2", pdMS_TO_TICKS(250), pdTRUE, (void*)next_timer_id++, heavy_overrun_callback);
-    if (g_heavy_h1) xTimerStart(g_heavy_h1, 0);
-    if (g_heavy_h2) xTimerStart(g_heavy_h2, 0);
+    //    (สร้างจาก pool เพื่อให้ dispatcher วัดเวลาและ offload ได้)
+    g_heavy_h1 = allocate_from_pool("Heavy1", pdMS_TO_TICKS(250), true, heavy_overrun_callback, NULL);
+    g_heavy_h2 = allocate_from_pool("Heavy2", pdMS_TO_TICKS(250), true, heavy_overrun_callback, NULL);
+    if (g_heavy_h1) xTimerStart(g_heavy_h1->handle, 0);
+    if (g_heavy_h2) xTimerStart(g_heavy_h2->handle, 0);
 
     // 3) เปิด analysis task เพื่อติดตามรายงาน
     xTaskCreate(performance_analysis_task, "PerfAnalysis", 3072, NULL, 8, NULL);
@@ -621,8 +1151,8 @@ static void recovery_task(void *pv)
     vTaskDelay(pdMS_TO_TICKS(8000));
 
     ESP_LOGW(TAG, "[EXP4] Recovery: stopping heavy timers...");
-    if (g_heavy_h1) { xTimerStop(g_heavy_h1, 0); xTimerDelete(g_heavy_h1, 0); g_heavy_h1 = NULL; }
-    if (g_heavy_h2) { xTimerStop(g_heavy_h2, 0); xTimerDelete(g_heavy_h2, 0); g_heavy_h2 = NULL; }
+    if (g_heavy_h1) { xTimerStop(g_heavy_h1->handle, 0); release_to_pool(g_heavy_h1->id); g_heavy_h1 = NULL; }
+    if (g_heavy_h2) { xTimerStop(g_heavy_h2->handle, 0); release_to_pool(g_heavy_h2->id); g_heavy_h2 = NULL; }
 
     // Reset ตัวชี้วัดบางส่วนให้อ่านค่าหลัง recover ได้ง่าย
     health_data.callback_overruns = 0;
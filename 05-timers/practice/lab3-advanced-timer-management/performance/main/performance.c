@@ -12,9 +12,11 @@
 #include "freertos/queue.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#include "timer_cmd.h"
 #include "esp_system.h"
 #include "esp_random.h"
 #include "driver/gpio.h"
+#include "sdkconfig.h"
 
 static const char *TAG = "ADV_TIMERS";
 
@@ -174,7 +176,7 @@ void release_to_pool(uint32_t timer_id) {
     for (int i = 0; i < TIMER_POOL_SIZE; i++) {
         if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
             if (timer_pool[i].handle) {
-                xTimerDelete(timer_pool[i].handle, 0);
+                timer_cmd_delete(timer_pool[i].handle, 0);
             }
             timer_pool[i].in_use = false;
             timer_pool[i].handle = NULL;
@@ -196,7 +198,7 @@ void record_performance_sample(uint32_t timer_id, uint32_t duration_us, bool acc
         sample->accuracy_ok = accuracy_ok;
         sample->callback_start_time = esp_timer_get_time() / 1000; // Convert to ms
         sample->service_task_priority = uxTaskPriorityGet(NULL);
-        sample->queue_length = 0; // Would need special access to get this
+        sample->queue_length = timer_cmd_in_flight(); // upper bound, see timer_cmd.h
 
         perf_buffer_index = (perf_buffer_index + 1) % PERFORMANCE_BUFFER_SIZE;
 
@@ -315,6 +317,10 @@ void health_monitor_callback(TimerHandle_t timer) {
     // Update health metrics
     health_data.free_heap_bytes = esp_get_free_heap_size();
 
+    timer_cmd_snapshot_t cmd;
+    timer_cmd_get_snapshot(&cmd);
+    health_data.command_failures = timer_cmd_failures(&cmd);
+
     uint32_t active_count = 0;
     uint32_t pool_used = 0;
 
@@ -388,7 +394,7 @@ TimerHandle_t create_dynamic_timer(const char* name, uint32_t period_ms,
 void cleanup_dynamic_timers(void) {
     for (uint32_t i = 0; i < dynamic_timer_count; i++) {
         if (dynamic_timers[i] != NULL) {
-            xTimerDelete(dynamic_timers[i], pdMS_TO_TICKS(100));
+            timer_cmd_delete(dynamic_timers[i], pdMS_TO_TICKS(100));
             dynamic_timers[i] = NULL;
         }
     }
@@ -412,7 +418,7 @@ void stress_test_task(void *parameter) {
                                             true, stress_test_callback, NULL);
 
         if (stress_timers[i] != NULL) {
-            xTimerStart(stress_timers[i]->handle, 0);
+            timer_cmd_start(stress_timers[i]->handle, 0);
         }
 
         vTaskDelay(pdMS_TO_TICKS(100)); // Stagger creation
@@ -424,7 +430,7 @@ void stress_test_task(void *parameter) {
     // Clean up stress timers
     for (int i = 0; i < 10; i++) {
         if (stress_timers[i] != NULL) {
-            xTimerStop(stress_timers[i]->handle, pdMS_TO_TICKS(100));
+            timer_cmd_stop(stress_timers[i]->handle, pdMS_TO_TICKS(100));
             release_to_pool(stress_timers[i]->id);
         }
     }
@@ -439,7 +445,7 @@ void stress_test_task(void *parameter) {
         TimerHandle_t dt = create_dynamic_timer(name, 200 + (i * 100),
                                               true, performance_test_callback);
         if (dt != NULL) {
-            xTimerStart(dt, 0);
+            timer_cmd_start(dt, 0);
         }
     }
 
@@ -465,6 +471,8 @@ void performance_analysis_task(void *parameter) {
         ESP_LOGI(TAG, "Command Failures: %lu", health_data.command_failures);
         ESP_LOGI(TAG, "═════════════════════════\n");
 
+        timer_cmd_print_snapshot(TAG);
+
         // Memory usage check
         if (health_data.free_heap_bytes < 20000) {
             ESP_LOGW(TAG, "⚠️ Low memory warning: %lu bytes", health_data.free_heap_bytes);
@@ -514,8 +522,8 @@ void create_system_timers(void) {
                                     performance_test_callback);
 
     if (health_monitor_timer && performance_timer) {
-        xTimerStart(health_monitor_timer, 0);
-        xTimerStart(performance_timer, 0);
+        timer_cmd_start(health_monitor_timer, 0);
+        timer_cmd_start(performance_timer, 0);
         ESP_LOGI(TAG, "System timers started");
     } else {
         ESP_LOGE(TAG, "Failed to create system timers");
@@ -533,7 +541,7 @@ void app_main(void) {
     health_monitor_timer = xTimerCreate("HealthMonitor",
                                        pdMS_TO_TICKS(HEALTH_CHECK_INTERVAL),
                                        pdTRUE, (void*)1, health_monitor_callback);
-    if (health_monitor_timer) xTimerStart(health_monitor_timer, 0);
+    if (health_monitor_timer) timer_cmd_start(health_monitor_timer, 0);
 
 #if (EXPERIMENT == 1)
     // ── Experiment 1: Timer Pool Management ──
@@ -543,15 +551,15 @@ void app_main(void) {
     timer_pool_entry_t* a = allocate_from_pool("PoolA", pdMS_TO_TICKS(200), true, performance_test_callback, NULL);
     timer_pool_entry_t* b = allocate_from_pool("PoolB", pdMS_TO_TICKS(300), true, performance_test_callback, NULL);
     timer_pool_entry_t* c = allocate_from_pool("PoolC", pdMS_TO_TICKS(500), true, performance_test_callback, NULL);
-    if (a) xTimerStart(a->handle, 0);
-    if (b) xTimerStart(b->handle, 0);
-    if (c) xTimerStart(c->handle, 0);
+    if (a) timer_cmd_start(a->handle, 0);
+    if (b) timer_cmd_start(b->handle, 0);
+    if (c) timer_cmd_start(c->handle, 0);
 
     // ทดสอบ dynamic timers
     TimerHandle_t d1 = create_dynamic_timer("Dyn1", 250, true, performance_test_callback);
     TimerHandle_t d2 = create_dynamic_timer("Dyn2", 400, true, performance_test_callback);
-    if (d1) xTimerStart(d1, 0);
-    if (d2) xTimerStart(d2, 0);
+    if (d1) timer_cmd_start(d1, 0);
+    if (d2) timer_cmd_start(d2, 0);
 
     // วิเคราะห์เป็นระยะ
     xTaskCreate(performance_analysis_task, "PerfAnalysis", 3072, NULL, 8, NULL);
@@ -565,7 +573,7 @@ void app_main(void) {
                                     pdMS_TO_TICKS(500),
                                     pdTRUE, (void*)2,
                                     performance_test_callback);
-    if (performance_timer) xTimerStart(performance_timer, 0);
+    if (performance_timer) timer_cmd_start(performance_timer, 0);
 
     xTaskCreate(performance_analysis_task, "PerfAnalysis", 3072, NULL, 8, NULL);
 
@@ -583,14 +591,14 @@ void app_main(void) {
     // 1) เปิดชุดปกติ
     timer_pool_entry_t* n1 = allocate_from_pool("N1", pdMS_TO_TICKS(200), true, performance_test_callback, NULL);
     timer_pool_entry_t* n2 = allocate_from_pool("N2", pdMS_TO_TICKS(300), true, performance_test_callback, NULL);
-    if (n1) xTimerStart(n1->handle, 0);
-    if (n2) xTimerStart(n2->handle, 0);
+    if (n1) timer_cmd_start(n1->handle, 0);
+    if (n2) timer_cmd_start(n2->handle, 0);
 
     // 2) Inject heavy timers ให้เกิด overrun / warning
     TimerHandle_t h1 = xTimerCreate("Heavy1", pdMS_TO_TICKS(250), pdTRUE, (void*)next_timer_id++, heavy_overrun_callback);
     TimerHandle_t h2 = xTimerCreate("Heavy2", pdMS_TO_TICKS(250), pdTRUE, (void*)next_timer_id++, heavy_overrun_callback);
-    if (h1) xTimerStart(h1, 0);
-    if (h2) xTimerStart(h2, 0);
+    if (h1) timer_cmd_start(h1, 0);
+    if (h2) timer_cmd_start(h2, 0);
 
     // 3) เปิด analysis task เพื่อติดตามรายงาน
     xTaskCreate(performance_analysis_task, "PerfAnalysis", 3072, NULL, 8, NULL);
@@ -600,15 +608,15 @@ void app_main(void) {
         [](void*){
             vTaskDelay(pdMS_TO_TICKS(8000));
             ESP_LOGW(TAG, "[EXP4] Recovery: stopping heavy timers...");
-            if (h1) xTimerStop(h1, 0), xTimerDelete(h1, 0);
-            if (h2) xTimerStop(h2, 0), xTimerDelete(h2, 0);
+            if (h1) timer_cmd_stop(h1, 0), timer_cmd_delete(h1, 0);
+            if (h2) timer_cmd_stop(h2, 0), timer_cmd_delete(h2, 0);
 
             // Reset ตัวชี้วัดบางส่วน (แค่ตัวช่วยอ่านค่า)
             health_data.callback_overruns = 0;
 
             // สร้างชุดปกติใหม่
             timer_pool_entry_t* r1 = allocate_from_pool("R1", pdMS_TO_TICKS(300), true, performance_test_callback, NULL);
-            if (r1) xTimerStart(r1->handle, 0);
+            if (r1) timer_cmd_start(r1->handle, 0);
 
             ESP_LOGI(TAG, "[EXP4] Recovery done.");
             vTaskDelete(NULL);
@@ -0,0 +1,16 @@
+// Linux (POSIX) target entry point: the GPIO and coalescing experiments in
+// stresstest.c need the ESP32, so the host build runs the stress ramp only.
+//   idf.py --preview set-target linux && idf.py build monitor
+
+#include <stdio.h>
+#include "stress_ramp.h"
+
+void app_main(void) {
+    stress_ramp_result_t by_timers, by_rate;
+
+    stress_ramp_run(&by_timers, &by_rate);
+    printf("Max sustainable load: %lu timers @ %d cmds/s (limited by %s), "
+           "%lu cmds/s @ %d timers (limited by %s)\n",
+           (unsigned long)by_timers.max_timers, STRESS_RAMP_FIXED_CMD_RATE, by_timers.limited_by,
+           (unsigned long)by_rate.max_cmd_rate, STRESS_RAMP_FIXED_TIMERS, by_rate.limited_by);
+}
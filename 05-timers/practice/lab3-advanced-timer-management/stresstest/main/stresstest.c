@@ -15,6 +15,7 @@
 #include "esp_system.h"
 #include "esp_random.h"
 #include "driver/gpio.h"
+#include "stress_ramp.h"
 
 static const char *TAG = "ADV_TIMERS";
 
@@ -28,6 +29,16 @@ static const char *TAG = "ADV_TIMERS";
 #define PERFORMANCE_BUFFER_SIZE      100
 #define HEALTH_CHECK_INTERVAL        1000
 
+// Timer coalescing: a timer may fire up to slack_ms late so that expirations
+// falling in a shared window are delivered in one service-task wakeup
+#define COALESCE_DEFAULT_SLACK_MS    50
+#define COALESCE_PHASE_MS            15000
+#define COALESCE_BACKSTOP_MS         500     // lost re-arm check; its idle wakeups are not counted
+
+// 1 = after the coalescing demo, ramp the timer count and then the command
+// rate (components/stress_ramp) to find the service task's limits
+#define STRESS_RAMP_ENABLED          1
+
 // LEDs for visual feedback
 #define PERFORMANCE_LED     GPIO_NUM_2
 #define HEALTH_LED          GPIO_NUM_4
@@ -49,6 +60,7 @@ typedef struct {
     uint32_t creation_time;
     uint32_t start_count;
     uint32_t callback_count;
+    uint32_t slack_ms;          // 0 = exact expiry, >0 = may be coalesced
 } timer_pool_entry_t;
 
 // Performance Metrics
@@ -75,6 +87,26 @@ typedef struct {
     uint32_t free_heap_bytes;
 } timer_health_t;
 
+// Coalesced timer slot (driven by the single coalescing engine timer)
+typedef struct {
+    timer_pool_entry_t* entry;
+    int64_t due_us;
+    uint32_t period_us;
+    uint32_t slack_us;
+    bool active;
+} coalesced_timer_t;
+
+// Coalescing statistics (reset at the start of every measurement phase)
+typedef struct {
+    uint32_t wakeups;
+    uint32_t expirations;
+    uint64_t total_lateness_us;
+    uint32_t max_lateness_us;
+    uint32_t rearm_failures;    // engine commands the daemon queue refused
+    uint32_t backstop_runs;     // engine passes run by the backstop instead
+    int64_t phase_start_us;
+} coalesce_stats_t;
+
 // ================ GLOBAL VARIABLES ================
 
 // Timer Pool Management
@@ -96,6 +128,15 @@ TimerHandle_t performance_timer;
 TimerHandle_t dynamic_timers[DYNAMIC_TIMER_MAX];
 uint32_t dynamic_timer_count = 0;
 
+// Timer Coalescing
+coalesced_timer_t coalesced_timers[TIMER_POOL_SIZE];
+coalesce_stats_t coalesce_stats = {0};
+TimerHandle_t coalesce_engine_timer;
+TimerHandle_t coalesce_backstop_timer;
+bool coalescing_enabled = true;
+static bool coalesce_rearm_missed = false;
+static portMUX_TYPE coalesce_lock = portMUX_INITIALIZER_UNLOCKED;
+
 // Test Infrastructure
 QueueHandle_t test_result_queue;
 TaskHandle_t stress_test_task_handle;
@@ -112,6 +153,7 @@ void init_timer_pool(void) {
         timer_pool[i].creation_time = 0;
         timer_pool[i].start_count = 0;
         timer_pool[i].callback_count = 0;
+        timer_pool[i].slack_ms = 0;
     }
 
     ESP_LOGI(TAG, "Timer pool initialized with %d slots", TIMER_POOL_SIZE);
@@ -141,6 +183,7 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
             entry->creation_time = xTaskGetTickCount();
             entry->start_count = 0;
             entry->callback_count = 0;
+            entry->slack_ms = 0;
 
             // Create actual timer
             entry->handle = xTimerCreate(name, period, auto_reload,
@@ -186,6 +229,214 @@ void release_to_pool(uint32_t timer_id) {
     xSemaphoreGive(pool_mutex);
 }
 
+// ================ TIMER COALESCING ================
+// All coalesced timers share one FreeRTOS timer. The engine wakes at the
+// earliest (due + slack) among them and fires every timer already due, so
+// timers whose deadlines fall inside each other's slack window are delivered
+// in a single wakeup. A timer fires at most one tick early (kernel resolution)
+// and at most slack_ms late.
+//
+// Every re-arm computes the next wakeup and queues the timer command under
+// coalesce_lock, so commands reach the daemon in the order their deadlines
+// were computed and an older, later deadline can never overwrite a newer
+// one. Commands are queued without blocking; if the daemon queue refuses
+// one, the auto-reload backstop timer runs the engine until a re-arm lands.
+
+#define COALESCE_TICK_US  (portTICK_PERIOD_MS * 1000)
+
+// Caller must hold coalesce_lock
+static int64_t coalesce_next_wakeup_us(void) {
+    int64_t next = INT64_MAX;
+
+    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
+        coalesced_timer_t* ct = &coalesced_timers[i];
+        if (!ct->active) {
+            continue;
+        }
+        int64_t latest = ct->due_us + (coalescing_enabled ? ct->slack_us : 0);
+        if (latest < next) {
+            next = latest;
+        }
+    }
+
+    return next;
+}
+
+// Caller must hold coalesce_lock
+static void coalesce_rearm_locked(void) {
+    int64_t next_us = coalesce_next_wakeup_us();
+    BaseType_t queued;
+
+    if (next_us == INT64_MAX) {
+        queued = xTimerStop(coalesce_engine_timer, 0);
+    } else {
+        int64_t delta_us = next_us - esp_timer_get_time();
+        TickType_t ticks = (delta_us <= 0) ? 1 :
+                           (TickType_t)((delta_us + COALESCE_TICK_US - 1) / COALESCE_TICK_US);
+
+        // xTimerChangePeriod also (re)starts a dormant timer
+        queued = xTimerChangePeriod(coalesce_engine_timer, ticks, 0);
+    }
+
+    // A later command that lands carries a newer deadline, so it clears the miss
+    coalesce_rearm_missed = (queued != pdPASS);
+    if (coalesce_rearm_missed) {
+        coalesce_stats.rearm_failures++;
+        health_data.command_failures++;
+    }
+}
+
+void coalesce_engine_callback(TimerHandle_t timer) {
+    timer_pool_entry_t* due[TIMER_POOL_SIZE];
+    int due_count = 0;
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&coalesce_lock);
+    coalesce_stats.wakeups++;
+
+    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
+        coalesced_timer_t* ct = &coalesced_timers[i];
+        // Anything due within the current tick counts as due: the kernel
+        // cannot wake us any closer to the deadline than that.
+        if (!ct->active || ct->due_us > now + COALESCE_TICK_US) {
+            continue;
+        }
+
+        uint32_t lateness = (now > ct->due_us) ? (uint32_t)(now - ct->due_us) : 0;
+        coalesce_stats.expirations++;
+        coalesce_stats.total_lateness_us += lateness;
+        if (lateness > coalesce_stats.max_lateness_us) {
+            coalesce_stats.max_lateness_us = lateness;
+        }
+
+        due[due_count++] = ct->entry;
+
+        if (ct->entry->auto_reload) {
+            // Keep the original cadence; skip periods that were missed entirely
+            do {
+                ct->due_us += ct->period_us;
+            } while (ct->due_us <= now);
+        } else {
+            ct->active = false;
+        }
+    }
+    portEXIT_CRITICAL(&coalesce_lock);
+
+    // Callbacks run outside the lock, all in this one wakeup
+    for (int i = 0; i < due_count; i++) {
+        due[i]->callback_count++;
+        due[i]->callback(due[i]->handle);
+    }
+
+    // Re-read the deadlines: a callback or task may have changed them
+    portENTER_CRITICAL(&coalesce_lock);
+    coalesce_rearm_locked();
+    portEXIT_CRITICAL(&coalesce_lock);
+}
+
+// Wakes every COALESCE_BACKSTOP_MS but does nothing unless the engine lost
+// a re-arm, in which case it runs the engine pass itself
+static void coalesce_backstop_callback(TimerHandle_t timer) {
+    portENTER_CRITICAL(&coalesce_lock);
+    bool missed = coalesce_rearm_missed;
+    if (missed) {
+        coalesce_stats.backstop_runs++;
+    }
+    portEXIT_CRITICAL(&coalesce_lock);
+
+    if (missed) {
+        coalesce_engine_callback(coalesce_engine_timer);
+    }
+}
+
+void init_coalescing(void) {
+    memset(coalesced_timers, 0, sizeof(coalesced_timers));
+
+    coalesce_engine_timer = xTimerCreate("Coalesce", 1, pdFALSE, (void*)0,
+                                         coalesce_engine_callback);
+    coalesce_backstop_timer = xTimerCreate("CoalesceBack", pdMS_TO_TICKS(COALESCE_BACKSTOP_MS),
+                                           pdTRUE, (void*)0, coalesce_backstop_callback);
+    if (coalesce_engine_timer == NULL || coalesce_backstop_timer == NULL) {
+        ESP_LOGE(TAG, "Failed to create coalescing engine timers");
+        return;
+    }
+    xTimerStart(coalesce_backstop_timer, pdMS_TO_TICKS(100));
+}
+
+// Same as allocate_from_pool, but the timer is driven by the coalescing
+// engine and may fire up to slack_ms late. The pool entry's own FreeRTOS
+// timer is kept dormant so callbacks still receive a valid handle/ID.
+timer_pool_entry_t* allocate_coalesced_from_pool(const char* name, TickType_t period,
+                                                 bool auto_reload, TimerCallbackFunction_t callback,
+                                                 void* context, uint32_t slack_ms) {
+    timer_pool_entry_t* entry = allocate_from_pool(name, period, auto_reload, callback, context);
+    if (entry != NULL) {
+        entry->slack_ms = slack_ms;
+    }
+    return entry;
+}
+
+bool coalesced_timer_start(timer_pool_entry_t* entry) {
+    if (entry == NULL || coalesce_engine_timer == NULL) {
+        return false;
+    }
+
+    int slot = entry - timer_pool;
+
+    portENTER_CRITICAL(&coalesce_lock);
+    coalesced_timer_t* ct = &coalesced_timers[slot];
+    ct->entry = entry;
+    ct->period_us = pdTICKS_TO_MS(entry->period) * 1000;
+    ct->slack_us = entry->slack_ms * 1000;
+    ct->due_us = esp_timer_get_time() + ct->period_us;
+    ct->active = true;
+    coalesce_rearm_locked();
+    portEXIT_CRITICAL(&coalesce_lock);
+
+    entry->start_count++;
+    return true;
+}
+
+void coalesced_timer_stop(timer_pool_entry_t* entry) {
+    if (entry == NULL) {
+        return;
+    }
+
+    portENTER_CRITICAL(&coalesce_lock);
+    coalesced_timers[entry - timer_pool].active = false;
+    coalesce_rearm_locked();
+    portEXIT_CRITICAL(&coalesce_lock);
+}
+
+void coalesce_reset_stats(bool enable) {
+    portENTER_CRITICAL(&coalesce_lock);
+    coalescing_enabled = enable;
+    memset(&coalesce_stats, 0, sizeof(coalesce_stats));
+    coalesce_stats.phase_start_us = esp_timer_get_time();
+    coalesce_rearm_locked();
+    portEXIT_CRITICAL(&coalesce_lock);
+}
+
+void coalesce_report(const char* label) {
+    portENTER_CRITICAL(&coalesce_lock);
+    coalesce_stats_t snap = coalesce_stats;
+    portEXIT_CRITICAL(&coalesce_lock);
+
+    float elapsed_s = (esp_timer_get_time() - snap.phase_start_us) / 1000000.0f;
+    float mean_lateness_ms = snap.expirations ?
+        (float)snap.total_lateness_us / snap.expirations / 1000.0f : 0.0f;
+
+    ESP_LOGI(TAG, "⏱️ Coalescing %s:", label);
+    ESP_LOGI(TAG, "  Expirations: %lu, Wakeups: %lu (%.2f timers/wakeup)",
+             snap.expirations, snap.wakeups,
+             snap.wakeups ? (float)snap.expirations / snap.wakeups : 0.0f);
+    ESP_LOGI(TAG, "  Wakeups/s: %.1f", elapsed_s > 0 ? snap.wakeups / elapsed_s : 0.0f);
+    ESP_LOGI(TAG, "  Lateness: mean=%.2fms, max=%.2fms",
+             mean_lateness_ms, snap.max_lateness_us / 1000.0f);
+    ESP_LOGI(TAG, "  Re-arm failures: %lu, backstop runs: %lu",
+             snap.rearm_failures, snap.backstop_runs);
+}
+
 // ================ PERFORMANCE MONITORING ================
 void record_performance_sample(uint32_t timer_id, uint32_t duration_us, bool accuracy_ok) {
     if (xSemaphoreTake(perf_mutex, 0) == pdTRUE) { // Non-blocking
@@ -322,7 +573,8 @@ void health_monitor_callback(TimerHandle_t timer) {
         for (int i = 0; i < TIMER_POOL_SIZE; i++) {
             if (timer_pool[i].in_use) {
                 pool_used++;
-                if (xTimerIsTimerActive(timer_pool[i].handle)) {
+                if (xTimerIsTimerActive(timer_pool[i].handle) ||
+                    coalesced_timers[i].active) {
                     active_count++;
                 }
             }
@@ -408,29 +660,47 @@ void stress_test_task(void *parameter) {
         snprintf(name, sizeof(name), "Stress%d", i);
 
         uint32_t period = 100 + (i * 50); // 100ms to 550ms
-        stress_timers[i] = allocate_from_pool(name, pdMS_TO_TICKS(period),
-                                            true, stress_test_callback, NULL);
+        stress_timers[i] = allocate_coalesced_from_pool(name, pdMS_TO_TICKS(period),
+                                                      true, stress_test_callback, NULL,
+                                                      COALESCE_DEFAULT_SLACK_MS);
 
         if (stress_timers[i] != NULL) {
-            xTimerStart(stress_timers[i]->handle, 0);
+            coalesced_timer_start(stress_timers[i]);
         }
 
         vTaskDelay(pdMS_TO_TICKS(100)); // Stagger creation
     }
 
-    // Run stress test for 30 seconds
-    vTaskDelay(pdMS_TO_TICKS(30000));
+    // Run stress test for 30 seconds: first half exact, second half coalesced
+    coalesce_reset_stats(false);
+    vTaskDelay(pdMS_TO_TICKS(COALESCE_PHASE_MS));
+    coalesce_report("OFF (exact expiry)");
+
+    coalesce_reset_stats(true);
+    vTaskDelay(pdMS_TO_TICKS(COALESCE_PHASE_MS));
+    coalesce_report("ON (per-timer slack)");
 
     // Clean up stress timers
     for (int i = 0; i < 10; i++) {
         if (stress_timers[i] != NULL) {
-            xTimerStop(stress_timers[i]->handle, pdMS_TO_TICKS(100));
+            coalesced_timer_stop(stress_timers[i]);
             release_to_pool(stress_timers[i]->id);
         }
     }
 
     ESP_LOGI(TAG, "Stress test completed");
 
+#if STRESS_RAMP_ENABLED
+    // Before the dynamic timers below so they don't load the service task
+    stress_ramp_result_t by_timers, by_rate;
+    stress_ramp_run(&by_timers, &by_rate);
+    health_data.command_failures += by_timers.command_failures + by_rate.command_failures;
+    ESP_LOGI(TAG, "📈 Max sustainable load: %lu timers @ %d cmds/s (limited by %s), "
+             "%lu cmds/s @ %d timers (limited by %s)",
+             by_timers.max_timers, STRESS_RAMP_FIXED_CMD_RATE, by_timers.limited_by,
+             by_rate.max_cmd_rate, STRESS_RAMP_FIXED_TIMERS, by_rate.limited_by);
+#endif
+
     // Create some dynamic timers for testing
     for (int i = 0; i < 5; i++) {
         char name[16];
@@ -528,6 +798,7 @@ void app_main(void) {
     init_hardware();
     init_timer_pool();
     init_monitoring();
+    init_coalescing();
 
     // สำหรับทุกโหมด: เปิด health monitor เสมอ
     health_monitor_timer = xTimerCreate("HealthMonitor",
@@ -14,7 +14,9 @@
 #include "esp_timer.h"
 #include "esp_system.h"
 #include "esp_random.h"
+#include "esp_err.h"
 #include "driver/gpio.h"
+#include "sdkconfig.h"
 
 static const char *TAG = "ADV_TIMERS";
 
@@ -28,6 +30,17 @@ static const char *TAG = "ADV_TIMERS";
 #define PERFORMANCE_BUFFER_SIZE      100
 #define HEALTH_CHECK_INTERVAL        1000
 
+// Static allocation: timers live in pre-allocated StaticTimer_t storage and
+// are created with xTimerCreateStatic, so no timer touches the heap after
+// start-up (0 = heap-allocated xTimerCreate). esp_timer has no static
+// create call, so TIMER_BACKEND_HIGH_RES timers still allocate their handle.
+#define TIMER_POOL_STATIC            1
+#define CREATION_BENCH_TIMERS        10
+
+// High-resolution backend demo: 25ms is not a multiple of the 10ms tick, so
+// the FreeRTOS timer runs (and is judged) at the rounded tick period
+#define HR_DEMO_PERIOD_US            25000
+
 // LEDs for visual feedback
 #define PERFORMANCE_LED     GPIO_NUM_2
 #define HEALTH_LED          GPIO_NUM_4
@@ -36,9 +49,17 @@ static const char *TAG = "ADV_TIMERS";
 
 // ================ DATA STRUCTURES ================
 
+// Timer Backend (chosen per timer at allocation)
+typedef enum {
+    TIMER_BACKEND_FREERTOS = 0,     // tick resolution, runs on timer service task
+    TIMER_BACKEND_HIGH_RES          // microsecond resolution, esp_timer
+} timer_backend_t;
+
+typedef esp_timer_handle_t hr_timer_handle_t;
+
 // Timer Pool Entry
 typedef struct {
-    TimerHandle_t handle;
+    TimerHandle_t handle;           // always valid: FreeRTOS backend timer or ID holder
     bool in_use;
     uint32_t id;
     char name[16];
@@ -49,6 +70,13 @@ typedef struct {
     uint32_t creation_time;
     uint32_t start_count;
     uint32_t callback_count;
+    timer_backend_t backend;
+    hr_timer_handle_t hr_handle;    // TIMER_BACKEND_HIGH_RES only
+    uint64_t period_us;
+    uint32_t last_callback_us;
+    uint32_t accurate_count;
+    uint32_t checked_count;
+    bool reclaim_pending;           // static storage still referenced by a queued delete
 } timer_pool_entry_t;
 
 // Performance Metrics
@@ -75,6 +103,14 @@ typedef struct {
     uint32_t free_heap_bytes;
 } timer_health_t;
 
+// Timer Creation Statistics (pool + dynamic timers)
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t max_us;
+    int32_t heap_bytes;             // heap consumed by timer control blocks
+} timer_creation_stats_t;
+
 // ================ GLOBAL VARIABLES ================
 
 // Timer Pool Management
@@ -94,12 +130,160 @@ TimerHandle_t performance_timer;
 
 // Dynamic Timer Tracking
 TimerHandle_t dynamic_timers[DYNAMIC_TIMER_MAX];
+char dynamic_timer_names[DYNAMIC_TIMER_MAX][16];   // FreeRTOS keeps the name pointer
 uint32_t dynamic_timer_count = 0;
 
+// Timer Storage
+#if TIMER_POOL_STATIC
+static StaticTimer_t timer_pool_storage[TIMER_POOL_SIZE];
+static StaticTimer_t dynamic_timer_storage[DYNAMIC_TIMER_MAX];
+#endif
+timer_creation_stats_t creation_stats = {0};
+
 // Test Infrastructure
 QueueHandle_t test_result_queue;
 TaskHandle_t stress_test_task_handle;
 
+// ================ HIGH-RESOLUTION BACKEND ================
+// Thin layer over esp_timer so pool timers can run with microsecond periods.
+
+static esp_err_t hr_timer_create(void (*callback)(void*), void* arg, const char* name,
+                                 hr_timer_handle_t* out) {
+    const esp_timer_create_args_t args = {
+        .callback = callback,
+        .arg = arg,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = name,
+    };
+    return esp_timer_create(&args, out);
+}
+
+static esp_err_t hr_timer_start(hr_timer_handle_t timer, uint64_t period_us, bool periodic) {
+    return periodic ? esp_timer_start_periodic(timer, period_us)
+                    : esp_timer_start_once(timer, period_us);
+}
+
+static esp_err_t hr_timer_stop(hr_timer_handle_t timer) {
+    return esp_timer_stop(timer);
+}
+
+static esp_err_t hr_timer_delete(hr_timer_handle_t timer) {
+    return esp_timer_delete(timer);
+}
+
+static bool hr_timer_is_active(hr_timer_handle_t timer) {
+    return esp_timer_is_active(timer);
+}
+
+// esp_timer callbacks get the pool entry; the pool callback still receives a
+// TimerHandle_t so the same callbacks work with either backend
+static void hr_timer_dispatch(void* arg) {
+    timer_pool_entry_t* entry = (timer_pool_entry_t*)arg;
+    entry->callback(entry->handle);
+}
+
+// ================ TIMER STORAGE ================
+// Every pool/dynamic timer is created here. With TIMER_POOL_STATIC the
+// control block comes from the caller's StaticTimer_t slot; a slot may only
+// be reused once the service task has processed the delete for it (see
+// pool_slot_reclaim and timer_service_barrier).
+
+static TimerHandle_t create_timer_in_storage(const char* name, TickType_t period,
+                                            bool auto_reload, void* id,
+                                            TimerCallbackFunction_t callback,
+                                            StaticTimer_t* storage) {
+    uint32_t heap_before = esp_get_free_heap_size();
+    uint32_t start_time = esp_timer_get_time();
+
+#if TIMER_POOL_STATIC
+    TimerHandle_t timer = xTimerCreateStatic(name, period, auto_reload, id, callback, storage);
+#else
+    (void)storage;
+    TimerHandle_t timer = xTimerCreate(name, period, auto_reload, id, callback);
+#endif
+
+    uint32_t duration_us = (uint32_t)esp_timer_get_time() - start_time;
+
+    if (timer != NULL) {
+        creation_stats.count++;
+        creation_stats.total_us += duration_us;
+        if (duration_us > creation_stats.max_us) {
+            creation_stats.max_us = duration_us;
+        }
+        creation_stats.heap_bytes += (int32_t)(heap_before - esp_get_free_heap_size());
+    }
+
+    return timer;
+}
+
+// Runs on the timer service task after the slot's delete command
+static void pool_slot_reclaim(void* param, uint32_t unused) {
+    ((timer_pool_entry_t*)param)->reclaim_pending = false;
+}
+
+static void timer_barrier_notify(void* task, uint32_t unused) {
+    xTaskNotifyGive((TaskHandle_t)task);
+}
+
+// Block until the service task has processed every command queued so far.
+// Task context only - never call from a timer callback.
+static bool timer_service_barrier(TickType_t wait) {
+    if (xTimerPendFunctionCall(timer_barrier_notify, xTaskGetCurrentTaskHandle(),
+                               0, wait) != pdPASS) {
+        return false;
+    }
+    return ulTaskNotifyTake(pdTRUE, wait) > 0;
+}
+
+// Compare heap xTimerCreate with xTimerCreateStatic (latency + RAM)
+void benchmark_timer_creation(void) {
+    static StaticTimer_t bench_storage[CREATION_BENCH_TIMERS];
+    TimerHandle_t bench[CREATION_BENCH_TIMERS];
+
+    // Heap path
+    uint32_t heap_before = esp_get_free_heap_size();
+    uint32_t start_time = esp_timer_get_time();
+    for (int i = 0; i < CREATION_BENCH_TIMERS; i++) {
+        bench[i] = xTimerCreate("BenchHeap", pdMS_TO_TICKS(1000), pdFALSE, (void*)i, NULL);
+    }
+    uint32_t heap_us = (uint32_t)esp_timer_get_time() - start_time;
+    int32_t heap_used = (int32_t)(heap_before - esp_get_free_heap_size());
+
+    for (int i = 0; i < CREATION_BENCH_TIMERS; i++) {
+        if (bench[i]) xTimerDelete(bench[i], pdMS_TO_TICKS(100));
+    }
+    timer_service_barrier(pdMS_TO_TICKS(1000));
+
+    // Static path
+    heap_before = esp_get_free_heap_size();
+    start_time = esp_timer_get_time();
+    for (int i = 0; i < CREATION_BENCH_TIMERS; i++) {
+        bench[i] = xTimerCreateStatic("BenchStatic", pdMS_TO_TICKS(1000), pdFALSE,
+                                      (void*)i, NULL, &bench_storage[i]);
+    }
+    uint32_t static_us = (uint32_t)esp_timer_get_time() - start_time;
+    int32_t static_heap_used = (int32_t)(heap_before - esp_get_free_heap_size());
+
+    for (int i = 0; i < CREATION_BENCH_TIMERS; i++) {
+        if (bench[i]) xTimerDelete(bench[i], pdMS_TO_TICKS(100));
+    }
+    timer_service_barrier(pdMS_TO_TICKS(1000));
+
+    ESP_LOGI(TAG, "🧱 Timer Creation Benchmark (%d timers):", CREATION_BENCH_TIMERS);
+    ESP_LOGI(TAG, "  xTimerCreate      : %luμs/timer, heap %ld bytes/timer",
+             heap_us / CREATION_BENCH_TIMERS, heap_used / CREATION_BENCH_TIMERS);
+    ESP_LOGI(TAG, "  xTimerCreateStatic: %luμs/timer, heap %ld bytes/timer, static %u bytes/timer",
+             static_us / CREATION_BENCH_TIMERS, static_heap_used / CREATION_BENCH_TIMERS,
+             (unsigned)sizeof(StaticTimer_t));
+#if TIMER_POOL_STATIC
+    ESP_LOGI(TAG, "  Pool mode: STATIC (%u bytes reserved in .bss for %d+%d timers)",
+             (unsigned)(sizeof(timer_pool_storage) + sizeof(dynamic_timer_storage)),
+             TIMER_POOL_SIZE, DYNAMIC_TIMER_MAX);
+#else
+    ESP_LOGI(TAG, "  Pool mode: HEAP");
+#endif
+}
+
 // ================ TIMER POOL MANAGEMENT ================
 void init_timer_pool(void) {
     pool_mutex = xSemaphoreCreateMutex();
@@ -112,14 +296,38 @@ void init_timer_pool(void) {
         timer_pool[i].creation_time = 0;
         timer_pool[i].start_count = 0;
         timer_pool[i].callback_count = 0;
+        timer_pool[i].backend = TIMER_BACKEND_FREERTOS;
+        timer_pool[i].hr_handle = NULL;
+        timer_pool[i].period_us = 0;
+        timer_pool[i].last_callback_us = 0;
+        timer_pool[i].accurate_count = 0;
+        timer_pool[i].checked_count = 0;
+        timer_pool[i].reclaim_pending = false;
     }
 
     ESP_LOGI(TAG, "Timer pool initialized with %d slots", TIMER_POOL_SIZE);
 }
 
-timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
-                                      bool auto_reload, TimerCallbackFunction_t callback,
-                                      void* context) {
+// Allocate a pool timer on the given backend. period_us is honoured exactly
+// by TIMER_BACKEND_HIGH_RES and rounded to ticks by TIMER_BACKEND_FREERTOS;
+// the entry records the period the timer really runs at, which is what the
+// accuracy check compares against.
+timer_pool_entry_t* allocate_from_pool_backend(const char* name, uint64_t period_us,
+                                              bool auto_reload, TimerCallbackFunction_t callback,
+                                              void* context, timer_backend_t backend) {
+    TickType_t period = pdMS_TO_TICKS(period_us / 1000);
+    if (period == 0) {
+        period = 1;
+    }
+    if (backend == TIMER_BACKEND_FREERTOS) {
+        uint64_t tick_period_us = (uint64_t)period * portTICK_PERIOD_MS * 1000;
+        if (tick_period_us != period_us) {
+            ESP_LOGW(TAG, "%s: %lluμs is not a whole number of ticks, runs at %lluμs",
+                     name, period_us, tick_period_us);
+        }
+        period_us = tick_period_us;
+    }
+
     if (xSemaphoreTake(pool_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
         ESP_LOGW(TAG, "Failed to acquire pool mutex");
         return NULL;
@@ -129,7 +337,7 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
 
     // Find free slot
     for (int i = 0; i < TIMER_POOL_SIZE; i++) {
-        if (!timer_pool[i].in_use) {
+        if (!timer_pool[i].in_use && !timer_pool[i].reclaim_pending) {
             entry = &timer_pool[i];
             entry->in_use = true;
             entry->id = next_timer_id++;
@@ -141,10 +349,36 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
             entry->creation_time = xTaskGetTickCount();
             entry->start_count = 0;
             entry->callback_count = 0;
+            entry->backend = backend;
+            entry->hr_handle = NULL;
+            entry->period_us = period_us;
+            entry->last_callback_us = 0;
+            entry->accurate_count = 0;
+            entry->checked_count = 0;
+
+            // The esp_timer goes first: deleting it is synchronous, while a
+            // FreeRTOS timer delete is only queued and would tie up the
+            // static storage until the service task runs it
+            bool created = backend != TIMER_BACKEND_HIGH_RES ||
+                           hr_timer_create(hr_timer_dispatch, entry, entry->name,
+                                           &entry->hr_handle) == ESP_OK;
+
+            // Create actual timer (for the high-res backend it is never
+            // started and only carries the name/ID seen by callbacks)
+            entry->handle = !created ? NULL :
+                            create_timer_in_storage(entry->name, period, auto_reload,
+                                                    (void*)entry->id, callback,
+#if TIMER_POOL_STATIC
+                                                    &timer_pool_storage[i]
+#else
+                                                    NULL
+#endif
+                                                    );
 
-            // Create actual timer
-            entry->handle = xTimerCreate(name, period, auto_reload,
-                                       (void*)entry->id, callback);
+            if (entry->handle == NULL && entry->hr_handle != NULL) {
+                hr_timer_delete(entry->hr_handle);
+                entry->hr_handle = NULL;
+            }
 
             if (entry->handle == NULL) {
                 entry->in_use = false;
@@ -166,6 +400,47 @@ timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
     return entry;
 }
 
+timer_pool_entry_t* allocate_from_pool(const char* name, TickType_t period,
+                                      bool auto_reload, TimerCallbackFunction_t callback,
+                                      void* context) {
+    return allocate_from_pool_backend(name, (uint64_t)pdTICKS_TO_MS(period) * 1000,
+                                      auto_reload, callback, context, TIMER_BACKEND_FREERTOS);
+}
+
+// Backend-independent start/stop for pool timers
+bool pool_timer_start(timer_pool_entry_t* entry, TickType_t wait) {
+    bool ok;
+
+    if (entry->backend == TIMER_BACKEND_HIGH_RES) {
+        ok = hr_timer_start(entry->hr_handle, entry->period_us, entry->auto_reload) == ESP_OK;
+    } else {
+        ok = xTimerStart(entry->handle, wait) == pdPASS;
+    }
+
+    if (ok) {
+        entry->start_count++;
+    } else {
+        health_data.command_failures++;
+    }
+    return ok;
+}
+
+bool pool_timer_stop(timer_pool_entry_t* entry, TickType_t wait) {
+    if (entry->backend == TIMER_BACKEND_HIGH_RES) {
+        // esp_timer_stop reports ESP_ERR_INVALID_STATE for an idle timer
+        hr_timer_stop(entry->hr_handle);
+        return true;
+    }
+    return xTimerStop(entry->handle, wait) == pdPASS;
+}
+
+bool pool_timer_is_active(timer_pool_entry_t* entry) {
+    if (entry->backend == TIMER_BACKEND_HIGH_RES) {
+        return hr_timer_is_active(entry->hr_handle);
+    }
+    return xTimerIsTimerActive(entry->handle);
+}
+
 void release_to_pool(uint32_t timer_id) {
     if (xSemaphoreTake(pool_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
         return;
@@ -173,8 +448,25 @@ void release_to_pool(uint32_t timer_id) {
 
     for (int i = 0; i < TIMER_POOL_SIZE; i++) {
         if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
+            if (timer_pool[i].hr_handle) {
+                hr_timer_stop(timer_pool[i].hr_handle);
+                hr_timer_delete(timer_pool[i].hr_handle);
+                timer_pool[i].hr_handle = NULL;
+            }
             if (timer_pool[i].handle) {
-                xTimerDelete(timer_pool[i].handle, 0);
+                bool deleted = xTimerDelete(timer_pool[i].handle, 0) == pdPASS;
+#if TIMER_POOL_STATIC
+                // Storage stays reserved until the service task has run the
+                // delete; if either command is lost the slot stays retired
+                timer_pool[i].reclaim_pending = true;
+                if (!deleted ||
+                    xTimerPendFunctionCall(pool_slot_reclaim, &timer_pool[i], 0, 0) != pdPASS) {
+                    ESP_LOGW(TAG, "Timer %lu slot retired (command queue full)", timer_id);
+                    health_data.command_failures++;
+                }
+#else
+                (void)deleted;
+#endif
             }
             timer_pool[i].in_use = false;
             timer_pool[i].handle = NULL;
@@ -250,6 +542,16 @@ void analyze_performance(void) {
                  health_data.average_accuracy, accurate_timers, sample_count);
         ESP_LOGI(TAG, "  Callback Overruns: %lu", health_data.callback_overruns);
 
+        for (int i = 0; i < TIMER_POOL_SIZE; i++) {
+            timer_pool_entry_t* e = &timer_pool[i];
+            if (e->in_use && e->checked_count > 0) {
+                ESP_LOGI(TAG, "  %-8s [%s] period=%lluμs accuracy=%.1f%% (%lu/%lu)",
+                         e->name, e->backend == TIMER_BACKEND_HIGH_RES ? "esp_timer" : "freertos",
+                         e->period_us, (float)e->accurate_count / e->checked_count * 100.0f,
+                         e->accurate_count, e->checked_count);
+            }
+        }
+
         // Visual feedback
         if (avg_duration > 500) {
             gpio_set_level(PERFORMANCE_LED, 1); // Warning
@@ -276,27 +578,41 @@ void performance_test_callback(TimerHandle_t timer) {
     uint32_t end_time = esp_timer_get_time();
     uint32_t duration_us = end_time - start_time;
 
+    // Find pool entry (pool timers keep their own interval and period_us)
+    timer_pool_entry_t* entry = NULL;
+    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
+        if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
+            entry = &timer_pool[i];
+            break;
+        }
+    }
+
     // Check accuracy (simplified)
     static uint32_t last_callback_time = 0;
-    uint32_t expected_interval = pdTICKS_TO_MS(xTimerGetPeriod(timer)) * 1000; // μs
-    uint32_t actual_interval = start_time - last_callback_time;
+    uint32_t* last_time = entry ? &entry->last_callback_us : &last_callback_time;
+    uint32_t expected_interval = entry ? (uint32_t)entry->period_us
+                                       : pdTICKS_TO_MS(xTimerGetPeriod(timer)) * 1000; // μs
+    uint32_t actual_interval = start_time - *last_time;
     bool accuracy_ok = true;
 
-    if (last_callback_time > 0) {
+    if (*last_time > 0 && expected_interval > 0) {
         uint32_t accuracy_percent = (actual_interval * 100) / expected_interval;
         accuracy_ok = (accuracy_percent >= 95 && accuracy_percent <= 105);
+        if (entry) {
+            entry->checked_count++;
+            if (accuracy_ok) {
+                entry->accurate_count++;
+            }
+        }
     }
 
-    last_callback_time = start_time;
+    *last_time = start_time;
 
     record_performance_sample(timer_id, duration_us, accuracy_ok);
 
     // Update timer stats
-    for (int i = 0; i < TIMER_POOL_SIZE; i++) {
-        if (timer_pool[i].in_use && timer_pool[i].id == timer_id) {
-            timer_pool[i].callback_count++;
-            break;
-        }
+    if (entry) {
+        entry->callback_count++;
     }
 }
 
@@ -322,7 +638,7 @@ void health_monitor_callback(TimerHandle_t timer) {
         for (int i = 0; i < TIMER_POOL_SIZE; i++) {
             if (timer_pool[i].in_use) {
                 pool_used++;
-                if (xTimerIsTimerActive(timer_pool[i].handle)) {
+                if (pool_timer_is_active(&timer_pool[i])) {
                     active_count++;
                 }
             }
@@ -373,8 +689,18 @@ TimerHandle_t create_dynamic_timer(const char* name, uint32_t period_ms,
         return NULL;
     }
 
-    TimerHandle_t timer = xTimerCreate(name, pdMS_TO_TICKS(period_ms),
-                                     auto_reload, (void*)next_timer_id++, callback);
+    char* stored_name = dynamic_timer_names[dynamic_timer_count];
+    strncpy(stored_name, name, sizeof(dynamic_timer_names[0]) - 1);
+    stored_name[sizeof(dynamic_timer_names[0]) - 1] = '\0';
+
+    TimerHandle_t timer = create_timer_in_storage(stored_name, pdMS_TO_TICKS(period_ms),
+                                                  auto_reload, (void*)next_timer_id++, callback,
+#if TIMER_POOL_STATIC
+                                                  &dynamic_timer_storage[dynamic_timer_count]
+#else
+                                                  NULL
+#endif
+                                                  );
 
     if (timer != NULL) {
         dynamic_timers[dynamic_timer_count] = timer;
@@ -392,6 +718,12 @@ void cleanup_dynamic_timers(void) {
             dynamic_timers[i] = NULL;
         }
     }
+#if TIMER_POOL_STATIC
+    // Static storage is reused from index 0, so wait for the deletes to land
+    if (!timer_service_barrier(pdMS_TO_TICKS(1000))) {
+        ESP_LOGW(TAG, "Timer service barrier timed out");
+    }
+#endif
     dynamic_timer_count = 0;
     ESP_LOGI(TAG, "Cleaned up all dynamic timers");
 }
@@ -463,6 +795,10 @@ void performance_analysis_task(void *parameter) {
         ESP_LOGI(TAG, "Average Accuracy: %.1f%%", health_data.average_accuracy);
         ESP_LOGI(TAG, "Callback Overruns: %lu", health_data.callback_overruns);
         ESP_LOGI(TAG, "Command Failures: %lu", health_data.command_failures);
+        ESP_LOGI(TAG, "Timer Creations (%s): %lu, Avg=%luμs, Max=%luμs, Heap=%ld bytes",
+                 TIMER_POOL_STATIC ? "static" : "heap", creation_stats.count,
+                 creation_stats.count ? creation_stats.total_us / creation_stats.count : 0,
+                 creation_stats.max_us, creation_stats.heap_bytes);
         ESP_LOGI(TAG, "═════════════════════════\n");
 
         // Memory usage check
@@ -539,13 +875,26 @@ void app_main(void) {
     // ── Experiment 1: Timer Pool Management ──
     ESP_LOGI(TAG, "[EXP1] Timer Pool Management");
 
+    // เทียบ RAM/latency ของ xTimerCreate กับ xTimerCreateStatic ก่อนเริ่ม
+    benchmark_timer_creation();
+
     // สร้างจาก pool หลายตัวเพื่อดู utilization
     timer_pool_entry_t* a = allocate_from_pool("PoolA", pdMS_TO_TICKS(200), true, performance_test_callback, NULL);
     timer_pool_entry_t* b = allocate_from_pool("PoolB", pdMS_TO_TICKS(300), true, performance_test_callback, NULL);
     timer_pool_entry_t* c = allocate_from_pool("PoolC", pdMS_TO_TICKS(500), true, performance_test_callback, NULL);
-    if (a) xTimerStart(a->handle, 0);
-    if (b) xTimerStart(b->handle, 0);
-    if (c) xTimerStart(c->handle, 0);
+    if (a) pool_timer_start(a, 0);
+    if (b) pool_timer_start(b, 0);
+    if (c) pool_timer_start(c, 0);
+
+    // 25ms บน backend ทั้งสองแบบ: FreeRTOS ปัดเป็น tick, esp_timer ได้ตรง μs
+    timer_pool_entry_t* t_rtos = allocate_from_pool_backend("Tick25", HR_DEMO_PERIOD_US, true,
+                                                            performance_test_callback, NULL,
+                                                            TIMER_BACKEND_FREERTOS);
+    timer_pool_entry_t* t_hr = allocate_from_pool_backend("HiRes25", HR_DEMO_PERIOD_US, true,
+                                                          performance_test_callback, NULL,
+                                                          TIMER_BACKEND_HIGH_RES);
+    if (t_rtos) pool_timer_start(t_rtos, 0);
+    if (t_hr) pool_timer_start(t_hr, 0);
 
     // ทดสอบ dynamic timers
     TimerHandle_t d1 = create_dynamic_timer("Dyn1", 250, true, performance_test_callback);
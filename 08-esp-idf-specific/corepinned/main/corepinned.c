@@ -7,6 +7,7 @@
 #include "esp_system.h"
 #include "esp_timer.h"
 #include "esp_log.h"
+#include "spsc_ring.h"
 
 static const char *TAG = "REALTIME";
 
@@ -37,6 +38,16 @@ static const char *TAG = "REALTIME";
 // ช่วงเวลารายงานผล (มิลลิวินาที)
 #define REPORT_MS          1000
 
+// ช่อง Control -> Comm: 1 = SPSC ring แบบ lock-free (ผู้ส่ง/ผู้รับอย่างละหนึ่ง)
+// 0 = FreeRTOS queue แบบเดิม
+#define USE_SPSC_RING      1
+#define CTRL_CHANNEL_LEN   32     // ต้องเป็นกำลังของสอง
+
+// วัด xQueue เทียบกับ SPSC ring (core เดียวกัน / ข้าม core) ก่อนเริ่ม demo
+#define RUN_SPSC_BENCHMARK 1
+#define BENCH_MSGS         20000
+#define PRIO_BENCH         10
+
 /* ============= โครงสร้าง/คิวสำหรับสื่อสาร ============ */
 typedef struct {
     int64_t t_send_us;      // เวลาส่ง (us)
@@ -44,7 +55,12 @@ typedef struct {
     float ctrl_output;      // ผลลัพธ์จาก control loop (ตัวอย่าง)
 } ctrl_msg_t;
 
+#if USE_SPSC_RING
+static spsc_ring_t ring_ctrl_to_comm;
+static ctrl_msg_t ring_ctrl_storage[CTRL_CHANNEL_LEN];
+#else
 static QueueHandle_t q_ctrl_to_comm;
+#endif
 
 /* ============= ตัวช่วยวัดความถี่/จิตเตอร์ ============= */
 typedef struct {
@@ -180,7 +196,11 @@ static void control_task_core0(void *arg)
             .seq = seq++,
             .ctrl_output = u
         };
+#if USE_SPSC_RING
+        spsc_ring_send(&ring_ctrl_to_comm, &m);   // เต็มแล้วทิ้ง นับใน .full
+#else
         xQueueSend(q_ctrl_to_comm, &m, 0);
+#endif
 
         // อัปเดตสถิติจังหวะ (จิตเตอร์)
         int64_t t1 = esp_timer_get_time();
@@ -239,7 +259,11 @@ static void comm_task_core1(void *arg)
     while (1) {
         ctrl_msg_t m;
         // รอข้อความจาก control (ให้เวลาบล็อกสั้น เพื่อยังทำงานอื่นได้)
+#if USE_SPSC_RING
+        if (spsc_ring_receive(&ring_ctrl_to_comm, &m, pdMS_TO_TICKS(10))) {
+#else
         if (xQueueReceive(q_ctrl_to_comm, &m, pdMS_TO_TICKS(10)) == pdTRUE) {
+#endif
             int64_t now = esp_timer_get_time();
             double lat_ms = (double)(now - m.t_send_us) / 1000.0;
             lat_sum_ms += lat_ms;
@@ -260,6 +284,11 @@ static void comm_task_core1(void *arg)
             } else {
                 ESP_LOGI(TAG, "Communication latency: no messages");
             }
+#if USE_SPSC_RING
+            ESP_LOGI(TAG, "Ctrl->Comm ring: dropped %lu, wakeups %lu, high-water %lu/%d",
+                     ring_ctrl_to_comm.full, ring_ctrl_to_comm.notifies,
+                     ring_ctrl_to_comm.high_water, CTRL_CHANNEL_LEN);
+#endif
             recv_count = 0;
             lat_sum_ms = 0.0;
             lat_max_ms = 0.0;
@@ -282,14 +311,140 @@ static void background_task(void *arg)
     }
 }
 
+/* ============ Benchmark: xQueue vs SPSC ring ============ */
+#if RUN_SPSC_BENCHMARK
+typedef struct {
+    bool use_ring;
+    QueueHandle_t queue;
+    spsc_ring_t ring;
+    ctrl_msg_t storage[CTRL_CHANNEL_LEN];
+    TaskHandle_t waiter;        // app_main รอสัญญาณจบจากทั้งสอง task
+    double lat_sum_us;
+    int64_t lat_max_us;
+} spsc_bench_t;
+
+static spsc_bench_t bench;
+
+static void bench_producer_task(void *arg)
+{
+    for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+        ctrl_msg_t m = { .t_send_us = esp_timer_get_time(), .seq = i, .ctrl_output = 0.f };
+        if (bench.use_ring) {
+            // ring ไม่บล็อก: เต็มก็ยก CPU ให้ผู้รับ (priority เท่ากัน)
+            while (!spsc_ring_send(&bench.ring, &m)) {
+                taskYIELD();
+            }
+        } else {
+            xQueueSend(bench.queue, &m, portMAX_DELAY);
+        }
+    }
+    xTaskNotifyGive(bench.waiter);
+    vTaskSuspend(NULL);         // รอ bench_run ลบ (join)
+}
+
+static void bench_consumer_task(void *arg)
+{
+    for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+        ctrl_msg_t m;
+        if (bench.use_ring) {
+            spsc_ring_receive(&bench.ring, &m, portMAX_DELAY);
+        } else {
+            xQueueReceive(bench.queue, &m, portMAX_DELAY);
+        }
+        int64_t lat = esp_timer_get_time() - m.t_send_us;
+        bench.lat_sum_us += (double)lat;
+        if (lat > bench.lat_max_us) bench.lat_max_us = lat;
+    }
+    xTaskNotifyGive(bench.waiter);
+    vTaskSuspend(NULL);         // รอ bench_run ลบ (join)
+}
+
+static void bench_run(bool use_ring, BaseType_t producer_core, BaseType_t consumer_core)
+{
+    memset(&bench, 0, sizeof(bench));
+    bench.use_ring = use_ring;
+    bench.waiter = xTaskGetCurrentTaskHandle();
+    if (use_ring) {
+        spsc_ring_init(&bench.ring, bench.storage, CTRL_CHANNEL_LEN, sizeof(ctrl_msg_t));
+    } else {
+        bench.queue = xQueueCreate(CTRL_CHANNEL_LEN, sizeof(ctrl_msg_t));
+        configASSERT(bench.queue != NULL);
+    }
+
+    TaskHandle_t rx = NULL, tx = NULL;
+    int64_t t0 = esp_timer_get_time();
+    xTaskCreatePinnedToCore(bench_consumer_task, "BenchRx", 3072, NULL, PRIO_BENCH, &rx, consumer_core);
+    xTaskCreatePinnedToCore(bench_producer_task, "BenchTx", 3072, NULL, PRIO_BENCH, &tx, producer_core);
+    configASSERT(rx != NULL && tx != NULL);
+
+    // ผู้ส่งและผู้รับแจ้งคนละครั้ง
+    uint32_t done = 0;
+    while (done < 2 && ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(10000)) != 0) {
+        done++;
+    }
+    int64_t elapsed = esp_timer_get_time() - t0;
+
+    // Join: task ที่จบแล้วรออยู่ใน vTaskSuspend, task ที่ค้าง (timeout) ถูกหยุดตรงนี้
+    // ลบผู้ส่งก่อน จะได้ไม่มีใคร notify ผู้รับหลังถูกลบ
+    vTaskDelete(tx);
+    vTaskDelete(rx);
+    // task ที่กำลังรันอยู่อีก core จะหยุดที่ yield ถัดไป และ idle task ต้องคืนหน่วยความจำ
+    // รอให้เสร็จก่อนรอบถัดไป memset bench ทับ
+    vTaskDelay(pdMS_TO_TICKS(10));
+    ulTaskNotifyTake(pdTRUE, 0);    // ทิ้ง notify ที่มาช้าหลัง timeout
+
+    if (done < 2) {
+        ESP_LOGE(TAG, "SPSC bench timed out");
+        if (!use_ring) {
+            vQueueDelete(bench.queue);
+        }
+        return;
+    }
+
+    ESP_LOGI(TAG, "  %-5s %-10s %7.0f msg/s  %5.2f us/msg  latency avg %.1f us, max %lld us",
+             use_ring ? "ring" : "queue",
+             producer_core == consumer_core ? "same-core" : "cross-core",
+             BENCH_MSGS * 1e6 / (double)elapsed, (double)elapsed / BENCH_MSGS,
+             bench.lat_sum_us / BENCH_MSGS, bench.lat_max_us);
+    if (use_ring) {
+        ESP_LOGI(TAG, "        full %lu, wakeups %lu, consumer sleeps %lu",
+                 bench.ring.full, bench.ring.notifies, bench.ring.sleeps);
+    } else {
+        vQueueDelete(bench.queue);
+    }
+}
+
+static void benchmark_spsc(void)
+{
+    ESP_LOGI(TAG, "SPSC benchmark: %d msgs x %u B, depth %d",
+             BENCH_MSGS, (unsigned)sizeof(ctrl_msg_t), CTRL_CHANNEL_LEN);
+    bench_run(false, CORE0, CORE0);
+    bench_run(true,  CORE0, CORE0);
+    bench_run(false, CORE0, CORE1);
+    bench_run(true,  CORE0, CORE1);
+}
+#endif
+
 /* ===================== app_main ===================== */
 void app_main(void)
 {
     ESP_LOGI(TAG, "ESP32 Core-Pinned Real-Time Demo; Main on Core %d", xPortGetCoreID());
 
+#if RUN_SPSC_BENCHMARK
+    benchmark_spsc();
+#endif
+
     // คิวสื่อสาร Control -> Comm
-    q_ctrl_to_comm = xQueueCreate(32, sizeof(ctrl_msg_t));
+#if USE_SPSC_RING
+    if (!spsc_ring_init(&ring_ctrl_to_comm, ring_ctrl_storage,
+                        CTRL_CHANNEL_LEN, sizeof(ctrl_msg_t))) {
+        ESP_LOGE(TAG, "CTRL_CHANNEL_LEN must be a power of two");
+        return;
+    }
+#else
+    q_ctrl_to_comm = xQueueCreate(CTRL_CHANNEL_LEN, sizeof(ctrl_msg_t));
     configASSERT(q_ctrl_to_comm != NULL);
+#endif
 
     // สร้าง tasks ด้วย priority ภายใต้ 0..24
     BaseType_t ok;
@@ -0,0 +1,216 @@
+// components/deferred_log/deferred_log.c
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "deferred_log.h"
+
+#define DLOG_LINE_MAX       256
+#define DLOG_POLL_MS        20      // formatter sleep when every ring is empty
+#define DLOG_KNOWN_STRINGS  128     // raw mode: addresses already announced
+
+static const char* TAG = "DLOG";
+
+typedef struct {
+    dlog_record_t records[DLOG_RING_RECORDS];
+    atomic_uint head;           // records published (free-running)
+    atomic_uint tail;           // records printed (free-running)
+    dlog_stats_t stats;         // written with interrupts masked on this core
+    uint32_t reported_drops;    // formatter only
+} dlog_ring_t;
+
+static dlog_ring_t rings[portNUM_PROCESSORS];
+static bool raw_output;
+static uint32_t known_strings[DLOG_KNOWN_STRINGS];
+
+// ================ WRITER ================
+// Pack the arguments as dlog_format() expects; returns false if one did not fit
+static bool pack_args(dlog_record_t* rec, uint32_t sig, va_list args) {
+    uint32_t count = DLOG_SIG_COUNT(sig);
+    uint32_t w = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        switch (DLOG_SIG_CLASS(sig, i)) {
+            case DLOG_ARG_INT: {
+                if (w + 1 > DLOG_ARG_WORDS) goto full;
+                rec->args[w++] = va_arg(args, uint32_t);
+                break;
+            }
+            case DLOG_ARG_INT64: {
+                if (w + 2 > DLOG_ARG_WORDS) goto full;
+                long long v = va_arg(args, long long);
+                memcpy(&rec->args[w], &v, sizeof(v));
+                w += 2;
+                break;
+            }
+            case DLOG_ARG_DOUBLE: {
+                if (w + 2 > DLOG_ARG_WORDS) goto full;
+                double v = va_arg(args, double);
+                memcpy(&rec->args[w], &v, sizeof(v));
+                w += 2;
+                break;
+            }
+            case DLOG_ARG_STRING: {
+                const char* s = va_arg(args, const char*);
+                size_t room = (DLOG_ARG_WORDS - w) * sizeof(uint32_t);
+                if (room == 0) goto full;
+                if (s == NULL) {
+                    s = "(null)";
+                }
+                // Cut long strings short rather than dropping the record
+                size_t len = strnlen(s, room - 1);
+                char* dst = (char*)&rec->args[w];
+                memcpy(dst, s, len);
+                dst[len] = '\0';
+                w += (uint32_t)(len + sizeof(uint32_t)) / sizeof(uint32_t);
+                break;
+            }
+        }
+        continue;
+full:
+        rec->words = (uint8_t)w;
+        rec->missing = (uint8_t)(count - i);
+        return false;
+    }
+    rec->words = (uint8_t)w;
+    rec->missing = 0;
+    return true;
+}
+
+void dlog_write(dlog_site_t* site, esp_log_level_t level, const char* tag, ...) {
+    uint32_t sig = atomic_load_explicit(&site->signature, memory_order_relaxed);
+    if (!(sig & DLOG_SIG_VALID)) {
+        // First call from this site; a race only parses the same format twice
+        sig = dlog_signature(site->fmt) | DLOG_SIG_VALID;
+        atomic_store_explicit(&site->signature, sig, memory_order_relaxed);
+    }
+    uint32_t now = (uint32_t)esp_timer_get_time();
+
+    // No preemption and no migration until the slot is published
+    UBaseType_t irq = portSET_INTERRUPT_MASK_FROM_ISR();
+    int core = xPortGetCoreID();
+    dlog_ring_t* ring = &rings[core];
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t used = head - atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (used >= DLOG_RING_RECORDS) {
+        ring->stats.dropped++;
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+        return;
+    }
+
+    dlog_record_t* rec = &ring->records[head & (DLOG_RING_RECORDS - 1)];
+    rec->fmt = (uint32_t)(uintptr_t)site->fmt;
+    rec->tag = (uint32_t)(uintptr_t)tag;
+    rec->time_us = now;
+    rec->level = (uint8_t)level;
+    rec->core = (uint8_t)core;
+
+    va_list args;
+    va_start(args, tag);
+    pack_args(rec, sig, args);
+    va_end(args);
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    ring->stats.written++;
+    if (used + 1 > ring->stats.high_water) {
+        ring->stats.high_water = used + 1;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+}
+
+// ================ FORMATTER ================
+// Raw mode: print each format / tag string once so the decoder can map addresses
+static void announce_string(uint32_t addr) {
+    uint32_t slot = (addr >> 2) % DLOG_KNOWN_STRINGS;
+
+    for (uint32_t i = 0; i < DLOG_KNOWN_STRINGS; i++) {
+        uint32_t* known = &known_strings[(slot + i) % DLOG_KNOWN_STRINGS];
+        if (*known == addr) {
+            return;
+        }
+        if (*known == 0) {
+            *known = addr;
+            break;
+        }
+    }
+    // Table full: announce every time, the decoder just overwrites
+
+    printf("DLOG S %08lx ", (unsigned long)addr);
+    for (const char* s = (const char*)(uintptr_t)addr; *s != '\0'; s++) {
+        if (*s == '\n') {
+            fputs("\\n", stdout);
+        } else if (*s == '\\') {
+            fputs("\\\\", stdout);
+        } else {
+            putchar(*s);
+        }
+    }
+    putchar('\n');
+}
+
+static void emit_record(const dlog_record_t* rec, char* line) {
+    const char* tag = (const char*)(uintptr_t)rec->tag;
+
+    if (raw_output) {
+        announce_string(rec->fmt);
+        announce_string(rec->tag);
+        const uint8_t* bytes = (const uint8_t*)rec;
+        size_t size = offsetof(dlog_record_t, args) + rec->words * sizeof(uint32_t);
+        printf("DLOG R ");
+        for (size_t i = 0; i < size; i++) {
+            printf("%02x", bytes[i]);
+        }
+        putchar('\n');
+        return;
+    }
+
+    dlog_format((const char*)(uintptr_t)rec->fmt, rec, line, DLOG_LINE_MAX);
+    // Same shape as ESP_LOGx output, with the time of the call
+    esp_log_write((esp_log_level_t)rec->level, tag, "%c (%lu) %s: %s\n",
+                  dlog_level_letter(rec->level), (unsigned long)(rec->time_us / 1000), tag, line);
+}
+
+static void dlog_formatter_task(void *pvParameters) {
+    static char line[DLOG_LINE_MAX];
+
+    while (1) {
+        bool idle = true;
+
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            dlog_ring_t* ring = &rings[core];
+            uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+            uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+            for (; tail != head; tail++) {
+                emit_record(&ring->records[tail & (DLOG_RING_RECORDS - 1)], line);
+                atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+                idle = false;
+            }
+
+            uint32_t dropped = ring->stats.dropped;
+            if (dropped != ring->reported_drops) {
+                ESP_LOGW(TAG, "core %d: %lu records dropped (ring full)",
+                         core, (unsigned long)(dropped - ring->reported_drops));
+                ring->reported_drops = dropped;
+            }
+        }
+
+        if (idle) {
+            vTaskDelay(pdMS_TO_TICKS(DLOG_POLL_MS));
+        }
+    }
+}
+
+bool deferred_log_start(UBaseType_t priority, BaseType_t core, bool raw) {
+    raw_output = raw;
+    return xTaskCreatePinnedToCore(dlog_formatter_task, "DLOG", 3072, NULL, priority,
+                                   NULL, core) == pdPASS;
+}
+
+// Each counter is read whole; together they may be a moment apart
+void deferred_log_get_stats(int core, dlog_stats_t* out) {
+    *out = rings[core].stats;
+}
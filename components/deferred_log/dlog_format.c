@@ -0,0 +1,224 @@
+// components/deferred_log/dlog_format.c
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "dlog_format.h"
+
+// Longest conversion spec copied for snprintf, e.g. "%-+08.3lld"
+#define SPEC_MAX    16
+
+typedef enum {
+    LEN_NONE,
+    LEN_LONG,                   // l
+    LEN_LLONG,                  // ll, j, L
+    LEN_SIZE,                   // z, t
+} length_mod_t;
+
+typedef struct {
+    char spec[SPEC_MAX];
+    size_t spec_len;            // characters of fmt consumed, '%' included
+    char conversion;            // 0 if the spec never ended
+    length_mod_t length;
+    int star_args;              // '*' width / precision
+} conversion_t;
+
+static bool is_conversion(char c) {
+    return c != '\0' && strchr("diouxXcsfFeEgGaApn%", c) != NULL;
+}
+
+// Parse one spec starting at the '%'
+static void parse_conversion(const char* p, conversion_t* conv) {
+    size_t n = 1;
+
+    memset(conv, 0, sizeof(*conv));
+    while (p[n] != '\0' && !is_conversion(p[n])) {
+        if (p[n] == '*') {
+            conv->star_args++;
+        } else if (p[n] == 'l') {
+            conv->length = conv->length == LEN_LONG ? LEN_LLONG : LEN_LONG;
+        } else if (p[n] == 'j' || p[n] == 'L') {
+            conv->length = LEN_LLONG;
+        } else if (p[n] == 'z' || p[n] == 't') {
+            conv->length = LEN_SIZE;
+        }
+        n++;
+    }
+    conv->conversion = p[n];
+    conv->spec_len = p[n] != '\0' ? n + 1 : n;
+
+    size_t copy = conv->spec_len < SPEC_MAX - 1 ? conv->spec_len : SPEC_MAX - 1;
+    memcpy(conv->spec, p, copy);
+    conv->spec[copy] = '\0';
+}
+
+static dlog_arg_class_t conversion_class(const conversion_t* conv) {
+    switch (conv->conversion) {
+        case 's':
+            return DLOG_ARG_STRING;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return DLOG_ARG_DOUBLE;
+        default:
+            return conv->length == LEN_LLONG ? DLOG_ARG_INT64 : DLOG_ARG_INT;
+    }
+}
+
+uint32_t dlog_signature(const char* fmt) {
+    uint32_t sig = 0;
+    uint32_t count = 0;
+
+    for (const char* p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        conversion_t conv;
+        parse_conversion(p, &conv);
+        p += conv.spec_len - 1;
+        if (conv.conversion == '%' || conv.conversion == 'n' || conv.conversion == '\0') {
+            continue;
+        }
+        for (int i = 0; i < conv.star_args && count < DLOG_MAX_ARGS; i++) {
+            sig |= (uint32_t)DLOG_ARG_INT << (2 * count++);
+        }
+        if (count < DLOG_MAX_ARGS) {
+            sig |= (uint32_t)conversion_class(&conv) << (2 * count++);
+        }
+    }
+    return sig | (count << 24);
+}
+
+// Reads the packed arguments back in order
+typedef struct {
+    const dlog_record_t* rec;
+    uint32_t word;
+} arg_reader_t;
+
+static bool read_words(arg_reader_t* r, void* out, uint32_t words) {
+    if (r->word + words > r->rec->words) {
+        return false;
+    }
+    memcpy(out, &r->rec->args[r->word], words * sizeof(uint32_t));
+    r->word += words;
+    return true;
+}
+
+static const char* read_string(arg_reader_t* r) {
+    if (r->word >= r->rec->words) {
+        return NULL;
+    }
+    const char* s = (const char*)&r->rec->args[r->word];
+    size_t max = (r->rec->words - r->word) * sizeof(uint32_t);
+    size_t len = strnlen(s, max);
+    if (len == max) {
+        return NULL;            // corrupt: no NUL inside the record
+    }
+    r->word += (uint32_t)(len + sizeof(uint32_t)) / sizeof(uint32_t);
+    return s;
+}
+
+// snprintf one conversion with the argument type the spec expects
+static int format_int(char* out, size_t size, const conversion_t* conv, int star[2],
+                      int nstar, uint32_t value) {
+    bool is_signed = conv->conversion == 'd' || conv->conversion == 'i';
+
+    if (conv->conversion == 'p') {
+        return snprintf(out, size, "0x%08lx", (unsigned long)value);
+    }
+    // Device longs are 32 bits; widen to whatever the host's long is
+    if (conv->length == LEN_LONG || conv->length == LEN_SIZE) {
+        char spec[SPEC_MAX];
+        memcpy(spec, conv->spec, SPEC_MAX);
+        for (char* s = spec; *s != '\0'; s++) {
+            if (*s == 'z' || *s == 't') {
+                *s = 'l';       // size_t is 32 bits on the device too
+            }
+        }
+        long v = is_signed ? (long)(int32_t)value : (long)value;
+        if (nstar == 2) return snprintf(out, size, spec, star[0], star[1], v);
+        if (nstar == 1) return snprintf(out, size, spec, star[0], v);
+        return snprintf(out, size, spec, v);
+    }
+    int v = (int)value;
+    if (nstar == 2) return snprintf(out, size, conv->spec, star[0], star[1], v);
+    if (nstar == 1) return snprintf(out, size, conv->spec, star[0], v);
+    return snprintf(out, size, conv->spec, v);
+}
+
+static int format_conversion(char* out, size_t size, const conversion_t* conv,
+                             arg_reader_t* r) {
+    int star[2] = {0, 0};
+    int nstar = conv->star_args < 2 ? conv->star_args : 2;
+    uint32_t word;
+
+    for (int i = 0; i < conv->star_args; i++) {
+        if (!read_words(r, &word, 1)) {
+            return snprintf(out, size, "?");
+        }
+        if (i < 2) {
+            star[i] = (int)word;
+        }
+    }
+
+    switch (conversion_class(conv)) {
+        case DLOG_ARG_STRING: {
+            const char* s = read_string(r);
+            if (s == NULL) break;
+            if (nstar == 2) return snprintf(out, size, conv->spec, star[0], star[1], s);
+            if (nstar == 1) return snprintf(out, size, conv->spec, star[0], s);
+            return snprintf(out, size, conv->spec, s);
+        }
+        case DLOG_ARG_DOUBLE: {
+            double d;
+            if (!read_words(r, &d, 2)) break;
+            if (nstar == 2) return snprintf(out, size, conv->spec, star[0], star[1], d);
+            if (nstar == 1) return snprintf(out, size, conv->spec, star[0], d);
+            return snprintf(out, size, conv->spec, d);
+        }
+        case DLOG_ARG_INT64: {
+            long long v;
+            if (!read_words(r, &v, 2)) break;
+            if (nstar == 2) return snprintf(out, size, conv->spec, star[0], star[1], v);
+            if (nstar == 1) return snprintf(out, size, conv->spec, star[0], v);
+            return snprintf(out, size, conv->spec, v);
+        }
+        case DLOG_ARG_INT:
+            if (!read_words(r, &word, 1)) break;
+            return format_int(out, size, conv, star, nstar, word);
+    }
+    return snprintf(out, size, "?");
+}
+
+size_t dlog_format(const char* fmt, const dlog_record_t* rec, char* out, size_t size) {
+    arg_reader_t reader = { .rec = rec, .word = 0 };
+    size_t pos = 0;
+
+    if (size == 0) {
+        return 0;
+    }
+    for (const char* p = fmt; *p != '\0' && pos + 1 < size; ) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        conversion_t conv;
+        parse_conversion(p, &conv);
+        p += conv.spec_len;
+        if (conv.conversion == '%') {
+            out[pos++] = '%';
+            continue;
+        }
+        if (conv.conversion == 'n' || conv.conversion == '\0') {
+            continue;
+        }
+        int n = format_conversion(out + pos, size - pos, &conv, &reader);
+        if (n > 0) {
+            pos += (size_t)n < size - pos ? (size_t)n : size - pos - 1;
+        }
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+char dlog_level_letter(uint8_t level) {
+    static const char letters[] = { 'N', 'E', 'W', 'I', 'D', 'V' };
+    return level < sizeof(letters) ? letters[level] : '?';
+}
@@ -0,0 +1,134 @@
+// components/deferred_log/host/dlog_decode.c
+//
+// Host decoder for deferred_log raw output (deferred_log_start(..., true)).
+// Reads a captured serial log, expands "DLOG R" records with the strings
+// announced by "DLOG S" lines and passes every other line through.
+//
+//   cc -O2 -I../include -o dlog_decode dlog_decode.c ../dlog_format.c
+//   ./dlog_decode < capture.txt
+//
+// Assumes a little-endian host, like the ESP32.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "dlog_format.h"
+
+#define LINE_MAX_LEN    2048
+#define OUT_MAX_LEN     512
+
+typedef struct {
+    uint32_t addr;
+    char* text;
+} known_string_t;
+
+static known_string_t* strings;
+static size_t string_count;
+static size_t string_capacity;
+
+static const char* lookup(uint32_t addr) {
+    for (size_t i = 0; i < string_count; i++) {
+        if (strings[i].addr == addr) {
+            return strings[i].text;
+        }
+    }
+    return NULL;
+}
+
+// "DLOG S <addr> <escaped string>"
+static void add_string(const char* p) {
+    char* end;
+    uint32_t addr = (uint32_t)strtoul(p, &end, 16);
+    if (*end == ' ') {
+        end++;
+    }
+
+    char* text = malloc(strlen(end) + 1);
+    char* out = text;
+    for (const char* s = end; *s != '\0' && *s != '\n' && *s != '\r'; s++) {
+        if (*s == '\\' && s[1] == 'n') {
+            *out++ = '\n';
+            s++;
+        } else if (*s == '\\' && s[1] == '\\') {
+            *out++ = '\\';
+            s++;
+        } else {
+            *out++ = *s;
+        }
+    }
+    *out = '\0';
+
+    for (size_t i = 0; i < string_count; i++) {
+        if (strings[i].addr == addr) {
+            free(strings[i].text);
+            strings[i].text = text;
+            return;
+        }
+    }
+    if (string_count == string_capacity) {
+        string_capacity = string_capacity ? 2 * string_capacity : 64;
+        strings = realloc(strings, string_capacity * sizeof(*strings));
+    }
+    strings[string_count++] = (known_string_t){ addr, text };
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// "DLOG R <hex bytes>"
+static void decode_record(const char* p) {
+    dlog_record_t rec;
+    uint8_t* bytes = (uint8_t*)&rec;
+    size_t n = 0;
+
+    memset(&rec, 0, sizeof(rec));
+    while (n < sizeof(rec) && hex_value(p[0]) >= 0 && hex_value(p[1]) >= 0) {
+        bytes[n++] = (uint8_t)(hex_value(p[0]) << 4 | hex_value(p[1]));
+        p += 2;
+    }
+    if (n < offsetof(dlog_record_t, args) ||
+        rec.words > DLOG_ARG_WORDS ||
+        n < offsetof(dlog_record_t, args) + rec.words * sizeof(uint32_t)) {
+        printf("dlog_decode: short record\n");
+        return;
+    }
+
+    const char* fmt = lookup(rec.fmt);
+    const char* tag = lookup(rec.tag);
+    char out[OUT_MAX_LEN];
+    if (fmt == NULL) {
+        snprintf(out, sizeof(out), "<unknown format %08lx>", (unsigned long)rec.fmt);
+    } else {
+        dlog_format(fmt, &rec, out, sizeof(out));
+    }
+    printf("%c (%lu) %s: %s%s [core %u]\n", dlog_level_letter(rec.level),
+           (unsigned long)(rec.time_us / 1000), tag ? tag : "?", out,
+           rec.missing ? " …" : "", rec.core);
+}
+
+int main(int argc, char** argv) {
+    FILE* in = stdin;
+    char line[LINE_MAX_LEN];
+
+    if (argc > 1 && (in = fopen(argv[1], "r")) == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        char* s = strstr(line, "DLOG S ");
+        char* r = strstr(line, "DLOG R ");
+        if (s != NULL) {
+            add_string(s + 7);
+        } else if (r != NULL) {
+            decode_record(r + 7);
+        } else {
+            fputs(line, stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+// components/deferred_log/include/deferred_log.h
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "dlog_format.h"
+
+// Deferred binary logging: DLOGx(tag, fmt, ...) takes the same arguments as
+// ESP_LOGx but only stores the format address, a timestamp and the raw
+// arguments in a per-core ring. A low-priority formatter task expands and
+// prints the records later, either as normal log lines or as raw records
+// for host/dlog_decode.
+//
+// The writer masks interrupts on its own core while it fills a slot, so
+// tasks and ISRs on that core are serialized without a lock and the task
+// cannot migrate halfway through. The formatter is the only reader. When a
+// ring is full the record is dropped and counted.
+//
+// The format and the tag must be string literals (or otherwise outlive the
+// record); %s arguments are copied.
+
+#define DLOG_RING_RECORDS   64      // per core, power of two
+
+typedef struct {
+    const char* fmt;
+    atomic_uint signature;      // dlog_signature(fmt) | DLOG_SIG_VALID, 0 until first use
+} dlog_site_t;
+
+typedef struct {
+    uint32_t written;
+    uint32_t dropped;           // ring full
+    uint32_t high_water;        // records waiting at once
+} dlog_stats_t;
+
+// Call sites below LOG_LOCAL_LEVEL compile away as with ESP_LOGx; the
+// runtime level of the tag is applied when the record is printed
+#define DLOG_LEVEL(level, tag, format, ...) do {                                \
+        if (LOG_LOCAL_LEVEL >= (level)) {                                       \
+            static dlog_site_t dlog_site_ = { .fmt = (format) };                \
+            dlog_write(&dlog_site_, (level), (tag), ##__VA_ARGS__);             \
+        }                                                                       \
+    } while (0)
+
+#define DLOGE(tag, format, ...) DLOG_LEVEL(ESP_LOG_ERROR,   tag, format, ##__VA_ARGS__)
+#define DLOGW(tag, format, ...) DLOG_LEVEL(ESP_LOG_WARN,    tag, format, ##__VA_ARGS__)
+#define DLOGI(tag, format, ...) DLOG_LEVEL(ESP_LOG_INFO,    tag, format, ##__VA_ARGS__)
+#define DLOGD(tag, format, ...) DLOG_LEVEL(ESP_LOG_DEBUG,   tag, format, ##__VA_ARGS__)
+#define DLOGV(tag, format, ...) DLOG_LEVEL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+// Task or ISR context. Records written before deferred_log_start() wait in
+// the ring, and are dropped once it fills.
+void dlog_write(dlog_site_t* site, esp_log_level_t level, const char* tag, ...);
+
+// raw = true prints "DLOG S <addr> <string>" once per format and tag, then
+// "DLOG R <hex record>" lines for host/dlog_decode instead of text
+bool deferred_log_start(UBaseType_t priority, BaseType_t core, bool raw);
+
+void deferred_log_get_stats(int core, dlog_stats_t* out);
+
+#endif
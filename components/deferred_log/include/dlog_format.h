@@ -0,0 +1,55 @@
+// components/deferred_log/include/dlog_format.h
+#ifndef DLOG_FORMAT_H
+#define DLOG_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Binary record layout and formatting, shared by the device formatter task
+// and the host decoder (host/dlog_decode.c), so no FreeRTOS here.
+//
+// A record holds the addresses of the format string and tag, never the
+// strings themselves, plus the raw arguments packed into 32-bit words:
+//   int, long, char, pointer    1 word
+//   long long, double           2 words, low word first
+//   string (%s)                 copied with its NUL, padded to a word,
+//                               cut short if the record is full
+
+#define DLOG_ARG_WORDS      16      // 80-byte records
+#define DLOG_MAX_ARGS       12
+
+typedef enum {
+    DLOG_ARG_INT,
+    DLOG_ARG_INT64,
+    DLOG_ARG_DOUBLE,
+    DLOG_ARG_STRING,
+} dlog_arg_class_t;
+
+typedef struct {
+    uint32_t fmt;               // address of the format string
+    uint32_t tag;               // address of the tag
+    uint32_t time_us;           // low 32 bits of esp_timer at the call
+    uint8_t level;              // esp_log_level_t
+    uint8_t core;
+    uint8_t words;              // args[] words in use
+    uint8_t missing;            // trailing arguments that did not fit
+    uint32_t args[DLOG_ARG_WORDS];
+} dlog_record_t;
+
+// Argument classes of fmt, 2 bits each from bit 0, and their count in
+// bits 24..28. Only the conversions printf understands are counted; '*'
+// width or precision counts as an int argument.
+#define DLOG_SIG_COUNT(sig)     (((sig) >> 24) & 0x1F)
+#define DLOG_SIG_CLASS(sig, i)  ((dlog_arg_class_t)(((sig) >> (2 * (i))) & 3))
+#define DLOG_SIG_VALID          (1u << 31)
+
+uint32_t dlog_signature(const char* fmt);
+
+// Expand fmt with the record's arguments into out; arguments that did not
+// fit print as '?'. Returns the length written, without the NUL.
+size_t dlog_format(const char* fmt, const dlog_record_t* rec, char* out, size_t size);
+
+// 'E', 'W', 'I', 'D' or 'V' as in ESP_LOG output
+char dlog_level_letter(uint8_t level);
+
+#endif
@@ -0,0 +1,99 @@
+// components/gpio_seq/gpio_seq.c
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "gpio_seq.h"
+
+typedef struct {
+    const gpio_sequence_t* seq;
+    uint8_t next_step;
+    int64_t due_us;
+} gpio_seq_channel_t;
+
+static gpio_seq_channel_t seq_channels[GPIO_SEQ_CHANNELS];
+static esp_timer_handle_t seq_timer;
+static portMUX_TYPE seq_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t seq_played = 0;
+static uint32_t seq_dropped = 0;
+
+// ================ PLAYER ================
+// Runs on the esp_timer task: apply every due step, then arm for the next one
+static void gpio_seq_timer_callback(void* arg) {
+    int64_t now = esp_timer_get_time();
+    int64_t next_due = INT64_MAX;
+
+    portENTER_CRITICAL(&seq_lock);
+    for (int i = 0; i < GPIO_SEQ_CHANNELS; i++) {
+        gpio_seq_channel_t* ch = &seq_channels[i];
+
+        while (ch->seq != NULL && ch->due_us <= now) {
+            const gpio_seq_step_t* step = &ch->seq->steps[ch->next_step];
+            gpio_set_level(step->pin, step->level);
+            ch->due_us += step->delay_us;
+
+            if (++ch->next_step >= ch->seq->count) {
+                ch->seq = NULL;
+                seq_played++;
+            }
+        }
+
+        if (ch->seq != NULL && ch->due_us < next_due) {
+            next_due = ch->due_us;
+        }
+    }
+    portEXIT_CRITICAL(&seq_lock);
+
+    if (next_due != INT64_MAX) {
+        int64_t wait_us = next_due - esp_timer_get_time();
+        // Fails harmlessly if gpio_seq_play() already re-armed us
+        esp_timer_start_once(seq_timer, wait_us > 0 ? wait_us : 1);
+    }
+}
+
+// ================ API ================
+bool gpio_seq_play(const gpio_sequence_t* seq) {
+    bool queued = false;
+
+    portENTER_CRITICAL(&seq_lock);
+    for (int i = 0; i < GPIO_SEQ_CHANNELS; i++) {
+        if (seq_channels[i].seq == NULL) {
+            seq_channels[i].seq = seq;
+            seq_channels[i].next_step = 0;
+            seq_channels[i].due_us = esp_timer_get_time();
+            queued = true;
+            break;
+        }
+    }
+    if (!queued) {
+        seq_dropped++;
+    }
+    portEXIT_CRITICAL(&seq_lock);
+
+    if (queued) {
+        // Kick the player now. If it re-armed itself between our stop and
+        // start, start fails; retry so the earliest deadline always wins.
+        do {
+            esp_timer_stop(seq_timer);
+        } while (esp_timer_start_once(seq_timer, 1) == ESP_ERR_INVALID_STATE);
+    }
+    return queued;
+}
+
+void gpio_seq_init(void) {
+    const esp_timer_create_args_t args = {
+        .callback = gpio_seq_timer_callback,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "gpio_seq",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&args, &seq_timer));
+    memset(seq_channels, 0, sizeof(seq_channels));
+}
+
+void gpio_seq_get_stats(uint32_t* played, uint32_t* dropped) {
+    portENTER_CRITICAL(&seq_lock);
+    *played = seq_played;
+    *dropped = seq_dropped;
+    portEXIT_CRITICAL(&seq_lock);
+}
@@ -0,0 +1,40 @@
+// components/gpio_seq/include/gpio_seq.h
+#ifndef GPIO_SEQ_H
+#define GPIO_SEQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver/gpio.h"
+
+// Plays compiled (pin, level, delay) step lists from one esp_timer so timer
+// callbacks only enqueue a sequence and return instead of blocking the timer
+// service task in vTaskDelay. Up to GPIO_SEQ_CHANNELS sequences play at once;
+// a play request with every channel busy is dropped and counted.
+
+#define GPIO_SEQ_CHANNELS   4
+#define SEQ_MS(ms)          ((uint32_t)(ms) * 1000)
+
+typedef struct {
+    gpio_num_t pin;
+    uint8_t level;
+    uint32_t delay_us;      // wait after setting the level
+} gpio_seq_step_t;
+
+typedef struct {
+    const gpio_seq_step_t* steps;
+    uint8_t count;
+} gpio_sequence_t;
+
+#define GPIO_SEQUENCE(step_array) { (step_array), sizeof(step_array) / sizeof((step_array)[0]) }
+
+// Create the player timer; call once before gpio_seq_play()
+void gpio_seq_init(void);
+
+// Non-blocking: safe from timer callbacks, returns in microseconds.
+// false if every channel was busy and the sequence was dropped
+bool gpio_seq_play(const gpio_sequence_t* seq);
+
+// Sequences played to the end and dropped since boot
+void gpio_seq_get_stats(uint32_t* played, uint32_t* dropped);
+
+#endif
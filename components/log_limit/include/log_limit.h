@@ -0,0 +1,86 @@
+// components/log_limit/include/log_limit.h
+#ifndef LOG_LIMIT_H
+#define LOG_LIMIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+// Logging layer over ESP_LOG_LEVEL with two filters in front of it:
+//
+// Compile time: each source file may set LOG_MODULE_LEVEL before including
+// this header. Calls above it are removed entirely; their arguments are
+// never evaluated and no tag lookup happens. The default follows
+// LOG_LOCAL_LEVEL, as ESP_LOGx does.
+//
+// Run time: the *_RATE macros give every call site its own token bucket
+// (rate per second, burst). A call without a token costs one tick read and
+// one compare; its arguments are not evaluated. The next call that passes
+// first reports how many were suppressed.
+//
+// Tag levels from esp_log_level_set() still apply behind both filters.
+
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_LOCAL_LEVEL
+#endif
+
+typedef struct {
+    atomic_uint tat;            // theoretical arrival time of the next call, ticks
+    atomic_uint suppressed;     // since the last call that passed
+    uint32_t interval;          // ticks per token
+    uint32_t burst_span;        // (burst - 1) * interval
+} log_limit_site_t;
+
+#define LOG_LIMIT_INTERVAL(per_sec) \
+    ((uint32_t)(configTICK_RATE_HZ / (per_sec) > 0 ? configTICK_RATE_HZ / (per_sec) : 1))
+
+#define LOG_LIMIT_SITE_INIT(per_sec, burst) {                                   \
+        .interval = LOG_LIMIT_INTERVAL(per_sec),                                \
+        .burst_span = ((burst) - 1) * LOG_LIMIT_INTERVAL(per_sec),              \
+    }
+
+// Token-bucket check (GCRA form: one timestamp per site). On success,
+// *suppressed receives the calls rejected since the previous success.
+bool log_limit_allow(log_limit_site_t* site, uint32_t* suppressed);
+
+// Calls rejected by every site since boot
+uint32_t log_limit_total_suppressed(void);
+
+#define MLOG_LEVEL(level, tag, format, ...) do {                                \
+        if (LOG_MODULE_LEVEL >= (level)) {                                      \
+            ESP_LOG_LEVEL((level), (tag), format, ##__VA_ARGS__);               \
+        }                                                                       \
+    } while (0)
+
+#define MLOG_RATE(level, tag, per_sec, burst, format, ...) do {                 \
+        if (LOG_MODULE_LEVEL >= (level)) {                                      \
+            static log_limit_site_t log_site_ = LOG_LIMIT_SITE_INIT(per_sec, burst); \
+            uint32_t log_suppressed_;                                           \
+            if (log_limit_allow(&log_site_, &log_suppressed_)) {                \
+                if (log_suppressed_ > 0) {                                      \
+                    ESP_LOG_LEVEL((level), (tag), "(%lu similar messages suppressed)", \
+                                  (unsigned long)log_suppressed_);              \
+                }                                                               \
+                ESP_LOG_LEVEL((level), (tag), format, ##__VA_ARGS__);           \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+#define MLOGE(tag, format, ...) MLOG_LEVEL(ESP_LOG_ERROR,   tag, format, ##__VA_ARGS__)
+#define MLOGW(tag, format, ...) MLOG_LEVEL(ESP_LOG_WARN,    tag, format, ##__VA_ARGS__)
+#define MLOGI(tag, format, ...) MLOG_LEVEL(ESP_LOG_INFO,    tag, format, ##__VA_ARGS__)
+#define MLOGD(tag, format, ...) MLOG_LEVEL(ESP_LOG_DEBUG,   tag, format, ##__VA_ARGS__)
+#define MLOGV(tag, format, ...) MLOG_LEVEL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+#define MLOGE_RATE(tag, per_sec, burst, format, ...) \
+    MLOG_RATE(ESP_LOG_ERROR, tag, per_sec, burst, format, ##__VA_ARGS__)
+#define MLOGW_RATE(tag, per_sec, burst, format, ...) \
+    MLOG_RATE(ESP_LOG_WARN,  tag, per_sec, burst, format, ##__VA_ARGS__)
+#define MLOGI_RATE(tag, per_sec, burst, format, ...) \
+    MLOG_RATE(ESP_LOG_INFO,  tag, per_sec, burst, format, ##__VA_ARGS__)
+#define MLOGD_RATE(tag, per_sec, burst, format, ...) \
+    MLOG_RATE(ESP_LOG_DEBUG, tag, per_sec, burst, format, ##__VA_ARGS__)
+
+#endif
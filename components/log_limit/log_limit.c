@@ -0,0 +1,32 @@
+// components/log_limit/log_limit.c
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "log_limit.h"
+
+static atomic_uint total_suppressed;
+
+// Tick arithmetic is modular: "a before b" is (int32_t)(a - b) < 0
+bool log_limit_allow(log_limit_site_t* site, uint32_t* suppressed) {
+    uint32_t now = (uint32_t)xTaskGetTickCount();
+    uint32_t tat = atomic_load_explicit(&site->tat, memory_order_relaxed);
+
+    do {
+        // A call may run up to burst_span ahead of the steady rate
+        if ((int32_t)(tat - now) > (int32_t)site->burst_span) {
+            atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&total_suppressed, 1, memory_order_relaxed);
+            return false;
+        }
+        // An idle site earns no more than a full bucket
+    } while (!atomic_compare_exchange_weak_explicit(
+                 &site->tat, &tat,
+                 ((int32_t)(tat - now) < 0 ? now : tat) + site->interval,
+                 memory_order_relaxed, memory_order_relaxed));
+
+    *suppressed = atomic_exchange_explicit(&site->suppressed, 0, memory_order_relaxed);
+    return true;
+}
+
+uint32_t log_limit_total_suppressed(void) {
+    return atomic_load_explicit(&total_suppressed, memory_order_relaxed);
+}
@@ -0,0 +1,68 @@
+// components/mpmc_queue/include/mpmc_queue.h
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Bounded multi-producer / multi-consumer queue of fixed-size items.
+//
+// Every cell carries a sequence number telling whose turn it is: a producer
+// owns cell i when seq == pos, a consumer when seq == pos + 1. Positions
+// are claimed with one compare-and-swap, so senders and receivers on both
+// cores never share a lock, only the cache line of the position counter.
+//
+// Blocking calls park the task in one of MPMC_QUEUE_MAX_WAITERS slots and
+// sleep on its task notification (index 0). Each send or receive that finds
+// an armed waiter on the other side wakes exactly one of them. Tasks that
+// also receive other notifications must tolerate spurious wakeups, which
+// the queue itself handles by re-checking and sleeping again.
+
+#define MPMC_QUEUE_MAX_WAITERS  32      // per direction; bits of a uint32_t
+
+// Cell = sequence number + item padded to 4 bytes
+#define MPMC_QUEUE_CELL_SIZE(item_size)     (sizeof(atomic_uint) + (((item_size) + 3u) & ~3u))
+#define MPMC_QUEUE_STORAGE_SIZE(capacity, item_size) ((capacity) * MPMC_QUEUE_CELL_SIZE(item_size))
+
+typedef struct {
+    atomic_uint claimed;        // slot ownership
+    atomic_uint armed;          // slots whose task is (about to be) asleep
+    portMUX_TYPE lock;          // a waker picks and notifies a slot under it
+    TaskHandle_t task[MPMC_QUEUE_MAX_WAITERS];
+} mpmc_waiters_t;
+
+typedef struct {
+    uint8_t* cells;             // capacity * cell_size bytes, caller-owned
+    uint32_t cell_size;
+    uint32_t item_size;
+    uint32_t mask;              // capacity - 1, capacity is a power of two
+    atomic_uint enqueue_pos;
+    atomic_uint dequeue_pos;
+    mpmc_waiters_t senders;     // blocked on a full queue
+    mpmc_waiters_t receivers;   // blocked on an empty queue
+
+    // Slow-path counters only; the fast path touches no shared statistics
+    atomic_uint full;           // try_send found the queue full
+    atomic_uint sleeps;         // blocking calls that actually slept
+    atomic_uint wakeups;        // notifications sent to a parked task
+} mpmc_queue_t;
+
+// capacity must be a power of two; storage must be MPMC_QUEUE_STORAGE_SIZE bytes
+bool mpmc_queue_init(mpmc_queue_t* q, void* storage, uint32_t capacity, uint32_t item_size);
+
+// Non-blocking; callable from ISRs only if no task ever blocks on the
+// other side (waking a parked task uses the task-level notify API)
+bool mpmc_queue_try_send(mpmc_queue_t* q, const void* item);
+bool mpmc_queue_try_receive(mpmc_queue_t* q, void* item);
+
+// Same wait semantics as xQueueSend / xQueueReceive
+bool mpmc_queue_send(mpmc_queue_t* q, const void* item, TickType_t wait);
+bool mpmc_queue_receive(mpmc_queue_t* q, void* item, TickType_t wait);
+
+// Snapshot; may be stale by the time it returns
+uint32_t mpmc_queue_count(mpmc_queue_t* q);
+
+#endif
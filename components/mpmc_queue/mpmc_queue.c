@@ -0,0 +1,250 @@
+// components/mpmc_queue/mpmc_queue.c
+#include <string.h>
+#include "mpmc_queue.h"
+
+static inline atomic_uint* cell_seq(mpmc_queue_t* q, uint32_t pos) {
+    return (atomic_uint*)(q->cells + (pos & q->mask) * q->cell_size);
+}
+
+static inline uint8_t* cell_data(mpmc_queue_t* q, uint32_t pos) {
+    return q->cells + (pos & q->mask) * q->cell_size + sizeof(atomic_uint);
+}
+
+bool mpmc_queue_init(mpmc_queue_t* q, void* storage, uint32_t capacity, uint32_t item_size) {
+    if (storage == NULL || capacity < 2 || (capacity & (capacity - 1)) != 0 || item_size == 0) {
+        return false;
+    }
+
+    memset(q, 0, sizeof(*q));
+    q->cells = (uint8_t*)storage;
+    q->cell_size = MPMC_QUEUE_CELL_SIZE(item_size);
+    q->item_size = item_size;
+    q->mask = capacity - 1;
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(cell_seq(q, i), i);
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    atomic_init(&q->dequeue_pos, 0);
+    portMUX_INITIALIZE(&q->senders.lock);
+    portMUX_INITIALIZE(&q->receivers.lock);
+    return true;
+}
+
+// ================ WAITERS ================
+// Wake one armed task, called after every successful push or pop. Whoever
+// clears an armed bit owns that wakeup, so a waiter is never notified twice
+// for one event. The bit is cleared and the task notified in one critical
+// section on w->lock; a waiter that finds its bit taken passes through the
+// same lock before giving up the slot (waiters_disarm), so the handle is
+// never notified after its task has left, or been deleted.
+static void waiters_wake_one(mpmc_queue_t* q, mpmc_waiters_t* w) {
+    // Pairs with the fence in waiters_arm: either the waiter re-checks and
+    // sees our item/slot, or we see its armed bit
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(&w->armed, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&w->lock);
+    uint32_t armed = atomic_load_explicit(&w->armed, memory_order_relaxed);
+    while (armed != 0) {
+        uint32_t bit = armed & (~armed + 1);
+        uint32_t prev = atomic_fetch_and_explicit(&w->armed, ~bit, memory_order_acq_rel);
+        if (prev & bit) {
+            atomic_fetch_add_explicit(&q->wakeups, 1, memory_order_relaxed);
+            xTaskNotifyGive(w->task[__builtin_ctz(bit)]);
+            break;
+        }
+        armed = prev & ~bit;
+    }
+    portEXIT_CRITICAL(&w->lock);
+}
+
+// -1 when every slot is taken; the caller then polls instead of sleeping
+static int waiters_claim(mpmc_waiters_t* w) {
+    uint32_t claimed = atomic_load_explicit(&w->claimed, memory_order_relaxed);
+    while (~claimed != 0) {
+        uint32_t bit = ~claimed & (claimed + 1);
+        if (atomic_compare_exchange_weak_explicit(&w->claimed, &claimed, claimed | bit,
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            int slot = __builtin_ctz(bit);
+            w->task[slot] = xTaskGetCurrentTaskHandle();
+            return slot;
+        }
+    }
+    return -1;
+}
+
+static void waiters_arm(mpmc_waiters_t* w, int slot) {
+    atomic_fetch_or_explicit(&w->armed, 1u << slot, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+// true if a waker already picked this slot, i.e. a notification is owed.
+// Returns only once that waker is done with the slot's task handle.
+static bool waiters_disarm(mpmc_waiters_t* w, int slot) {
+    uint32_t bit = 1u << slot;
+    if (atomic_fetch_and_explicit(&w->armed, ~bit, memory_order_acq_rel) & bit) {
+        return false;
+    }
+    portENTER_CRITICAL(&w->lock);
+    portEXIT_CRITICAL(&w->lock);
+    return true;
+}
+
+static void waiters_release(mpmc_waiters_t* w, int slot) {
+    atomic_fetch_and_explicit(&w->claimed, ~(1u << slot), memory_order_release);
+}
+
+// ================ FAST PATH ================
+static bool mpmc_push(mpmc_queue_t* q, const void* item) {
+    uint32_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(cell_seq(q, pos), memory_order_acquire);
+        int32_t dif = (int32_t)(seq - pos);
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return false;       // the cell still holds an item from one lap ago
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(cell_data(q, pos), item, q->item_size);
+    atomic_store_explicit(cell_seq(q, pos), pos + 1, memory_order_release);
+    return true;
+}
+
+static bool mpmc_pop(mpmc_queue_t* q, void* item) {
+    uint32_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(cell_seq(q, pos), memory_order_acquire);
+        int32_t dif = (int32_t)(seq - (pos + 1));
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return false;       // not yet published
+        } else {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(item, cell_data(q, pos), q->item_size);
+    atomic_store_explicit(cell_seq(q, pos), pos + q->mask + 1, memory_order_release);
+    return true;
+}
+
+bool mpmc_queue_try_send(mpmc_queue_t* q, const void* item) {
+    if (!mpmc_push(q, item)) {
+        atomic_fetch_add_explicit(&q->full, 1, memory_order_relaxed);
+        return false;
+    }
+    waiters_wake_one(q, &q->receivers);
+    return true;
+}
+
+bool mpmc_queue_try_receive(mpmc_queue_t* q, void* item) {
+    if (!mpmc_pop(q, item)) {
+        return false;
+    }
+    waiters_wake_one(q, &q->senders);
+    return true;
+}
+
+// ================ BLOCKING WRAPPERS ================
+typedef bool (*mpmc_op_t)(mpmc_queue_t* q, void* item);
+
+// Retry `op` until it succeeds or `wait` runs out, parking in `self` and
+// re-checking after arming so a wakeup between the failed try and the
+// sleep cannot be lost
+static bool mpmc_wait(mpmc_queue_t* q, mpmc_waiters_t* self, mpmc_waiters_t* peer,
+                      mpmc_op_t op, void* item, TickType_t wait) {
+    TimeOut_t timeout;
+    int slot = -1;
+    bool done = false;
+    bool picked = false;        // a waker chose this slot
+    bool pass_on = false;
+
+    vTaskSetTimeOutState(&timeout);
+    for (;;) {
+        if (op(q, item)) {
+            done = true;
+            break;
+        }
+        if (xTaskCheckForTimeOut(&timeout, &wait) == pdTRUE) {
+            break;
+        }
+        if (slot < 0) {
+            slot = waiters_claim(self);
+            if (slot < 0) {
+                vTaskDelay(1);  // more waiters than slots: fall back to polling
+                continue;
+            }
+        }
+
+        picked = false;
+        waiters_arm(self, slot);
+        if (op(q, item)) {
+            // A wakeup that chose us meanwhile was meant for another event
+            pass_on = waiters_disarm(self, slot);
+            done = true;
+            break;
+        }
+        atomic_fetch_add_explicit(&q->sleeps, 1, memory_order_relaxed);
+        ulTaskNotifyTake(pdTRUE, wait);
+        picked = waiters_disarm(self, slot);
+    }
+
+    if (slot >= 0) {
+        // Leaving with a wakeup we did not use: hand it to the next waiter
+        if (pass_on || (picked && !done)) {
+            waiters_wake_one(q, self);
+        }
+        waiters_release(self, slot);
+    }
+    if (done) {
+        waiters_wake_one(q, peer);
+    }
+    return done;
+}
+
+static bool mpmc_push_op(mpmc_queue_t* q, void* item) {
+    return mpmc_push(q, item);
+}
+
+bool mpmc_queue_send(mpmc_queue_t* q, const void* item, TickType_t wait) {
+    if (mpmc_queue_try_send(q, item)) {
+        return true;
+    }
+    if (wait == 0) {
+        return false;
+    }
+    return mpmc_wait(q, &q->senders, &q->receivers, mpmc_push_op, (void*)item, wait);
+}
+
+bool mpmc_queue_receive(mpmc_queue_t* q, void* item, TickType_t wait) {
+    if (mpmc_queue_try_receive(q, item)) {
+        return true;
+    }
+    if (wait == 0) {
+        return false;
+    }
+    return mpmc_wait(q, &q->receivers, &q->senders, mpmc_pop, item, wait);
+}
+
+uint32_t mpmc_queue_count(mpmc_queue_t* q) {
+    uint32_t head = atomic_load_explicit(&q->dequeue_pos, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&q->enqueue_pos, memory_order_acquire);
+    uint32_t n = tail - head;
+    return n > q->mask + 1 ? 0 : n;
+}
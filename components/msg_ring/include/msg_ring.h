@@ -0,0 +1,59 @@
+// components/msg_ring/include/msg_ring.h
+#ifndef MSG_RING_H
+#define MSG_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Variable-length records carved in FIFO order out of one byte ring.
+//
+// The producer reserves room for the largest record it may write, fills it
+// in place and commits the bytes it actually used; only those (plus a
+// 4-byte header) stay taken. The record pointer then travels through any
+// queue. Consumers release records in any order. The producer reclaims
+// released space from the tail on its next reserve, so the ring needs no
+// lock as long as one task at a time reserves and commits.
+//
+// A record never wraps: if it does not fit before the end, the rest of the
+// ring is skipped with a padding record.
+
+#define MSG_RING_HEADER     sizeof(atomic_uint)
+#define MSG_RING_RECORD_SIZE(len)   (MSG_RING_HEADER + (((len) + 3u) & ~3u))
+
+typedef struct {
+    uint8_t* storage;           // size bytes, 4-byte aligned, caller-owned
+    uint32_t size;              // power of two
+    uint32_t head;              // producer: next record starts here (free-running)
+    uint32_t tail;              // producer: oldest record not yet reclaimed
+    uint32_t reserved_pad;      // padding in front of the open reservation
+    uint32_t reserved_len;
+
+    // Producer-side counters
+    uint32_t records;
+    uint32_t payload_bytes;     // bytes committed by callers
+    uint32_t ring_bytes;        // payload + headers + alignment + padding
+    uint32_t full;              // reserves that found no room
+    uint32_t high_water;        // most bytes held at once
+} msg_ring_t;
+
+// size must be a power of two
+bool msg_ring_init(msg_ring_t* ring, void* storage, uint32_t size);
+
+// Room for up to max_len bytes, or NULL when the ring is full. At most one
+// reservation may be open at a time.
+void* msg_ring_reserve(msg_ring_t* ring, size_t max_len);
+
+// Keep the first len (<= max_len) bytes of the open reservation
+void msg_ring_commit(msg_ring_t* ring, void* record, size_t len);
+
+// Any task or ISR, any order; each committed record exactly once
+void msg_ring_release(void* record);
+
+// Bytes currently held by unreclaimed records (producer's view)
+static inline uint32_t msg_ring_used(const msg_ring_t* ring) {
+    return ring->head - ring->tail;
+}
+
+#endif
@@ -0,0 +1,91 @@
+// components/msg_ring/msg_ring.c
+#include "msg_ring.h"
+
+// Header word: payload length in the low 16 bits, flags above
+#define MSG_RING_LEN_MASK   0xFFFFu
+#define MSG_RING_RELEASED   (1u << 16)
+
+static inline atomic_uint* header_at(msg_ring_t* ring, uint32_t pos) {
+    return (atomic_uint*)(ring->storage + pos % ring->size);
+}
+
+static inline uint32_t record_size(uint32_t header) {
+    return MSG_RING_RECORD_SIZE(header & MSG_RING_LEN_MASK);
+}
+
+bool msg_ring_init(msg_ring_t* ring, void* storage, uint32_t size) {
+    if (storage == NULL || ((uintptr_t)storage & 3) != 0 || size < 2 * MSG_RING_HEADER ||
+        (size & (size - 1)) != 0) {
+        return false;
+    }
+
+    *ring = (msg_ring_t){ .storage = (uint8_t*)storage, .size = size };
+    return true;
+}
+
+// Advance the tail over the records consumers have released, oldest first
+static void msg_ring_reclaim(msg_ring_t* ring) {
+    while (ring->tail != ring->head) {
+        uint32_t header = atomic_load_explicit(header_at(ring, ring->tail), memory_order_acquire);
+        if (!(header & MSG_RING_RELEASED)) {
+            break;
+        }
+        ring->tail += record_size(header);
+    }
+}
+
+void* msg_ring_reserve(msg_ring_t* ring, size_t max_len) {
+    uint32_t need = MSG_RING_RECORD_SIZE(max_len);
+    uint32_t offset = ring->head % ring->size;
+    uint32_t pad = offset + need > ring->size ? ring->size - offset : 0;
+
+    if (max_len > MSG_RING_LEN_MASK || need > ring->size) {
+        ring->full++;
+        return NULL;
+    }
+
+    msg_ring_reclaim(ring);
+    if (msg_ring_used(ring) + pad + need > ring->size) {
+        ring->full++;
+        return NULL;
+    }
+
+    if (pad > 0) {
+        // Skip the end of the ring; released from the start so it is
+        // reclaimed as soon as everything before it is
+        atomic_store_explicit(header_at(ring, ring->head),
+                              (pad - MSG_RING_HEADER) | MSG_RING_RELEASED, memory_order_relaxed);
+    }
+    ring->reserved_pad = pad;
+    ring->reserved_len = (uint32_t)max_len;
+
+    uint32_t start = ring->head + pad;
+    atomic_store_explicit(header_at(ring, start), 0, memory_order_relaxed);
+    return ring->storage + start % ring->size + MSG_RING_HEADER;
+}
+
+void msg_ring_commit(msg_ring_t* ring, void* record, size_t len) {
+    atomic_uint* header = (atomic_uint*)((uint8_t*)record - MSG_RING_HEADER);
+    uint32_t pad = ring->reserved_pad;
+
+    if (len > ring->reserved_len) {
+        len = ring->reserved_len;
+    }
+    atomic_store_explicit(header, (uint32_t)len, memory_order_relaxed);
+    ring->head += pad + MSG_RING_RECORD_SIZE(len);
+
+    ring->records++;
+    ring->payload_bytes += len;
+    ring->ring_bytes += pad + MSG_RING_RECORD_SIZE(len);
+    if (msg_ring_used(ring) > ring->high_water) {
+        ring->high_water = msg_ring_used(ring);
+    }
+}
+
+void msg_ring_release(void* record) {
+    atomic_uint* header = (atomic_uint*)((uint8_t*)record - MSG_RING_HEADER);
+
+    // Release ordering: the consumer is done with the bytes before the
+    // producer can see the record as free
+    atomic_fetch_or_explicit(header, MSG_RING_RELEASED, memory_order_release);
+}
@@ -0,0 +1,70 @@
+// components/resource_pool/include/resource_pool.h
+#ifndef RESOURCE_POOL_H
+#define RESOURCE_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Pool of up to RESOURCE_POOL_MAX numbered resources tracked by a bitmap.
+//
+// Acquire claims a specific free index with one compare-and-swap on the
+// word that holds it (find first zero, set it), so the count and the slot
+// can never disagree the way a counting semaphore and a separate scan can.
+// Release clears the bit with one atomic AND.
+//
+// Tasks block only when every bit is set. They wait in FIFO order on their
+// task notification. A release wakes the oldest waiter, and a waiter that
+// loses the freed slot to a newcomer goes back to the front of the line.
+// The lock that orders the waiters is taken only on that slow path.
+// Callers must tolerate spurious notifications on index 0.
+//
+// Wait and hold times per task: resource_pool_metrics.h.
+
+#define RESOURCE_POOL_MAX       512
+#define RESOURCE_POOL_WORDS     (RESOURCE_POOL_MAX / 32)
+#define RESOURCE_POOL_WAITERS   32
+
+struct resource_pool_metrics;
+
+typedef struct {
+    uint32_t capacity;
+    uint32_t words;             // bitmap words in use
+    atomic_uint used[RESOURCE_POOL_WORDS];      // 1 = taken; bits past capacity stay set
+    atomic_uint hint;           // word to scan first: the last one released into
+
+    // Blocked acquirers, oldest at head (guarded by lock)
+    portMUX_TYPE lock;
+    TaskHandle_t waiter[RESOURCE_POOL_WAITERS];
+    uint32_t waiter_head;
+    uint32_t waiter_count;
+    atomic_uint waiting;        // == waiter_count, readable without the lock
+
+    // Counters
+    atomic_uint acquired;
+    atomic_uint cas_retries;    // lost a claim race and scanned again
+    atomic_uint sleeps;
+    atomic_uint timeouts;
+
+    struct resource_pool_metrics* metrics;      // NULL = not measured
+} resource_pool_t;
+
+bool resource_pool_init(resource_pool_t* pool, uint32_t capacity);
+
+// Index of the claimed resource, or -1 when none is free
+int resource_pool_try_acquire(resource_pool_t* pool);
+
+// Blocks up to wait ticks while the pool is empty; -1 on timeout
+int resource_pool_acquire(resource_pool_t* pool, TickType_t wait);
+
+void resource_pool_release(resource_pool_t* pool, int index);
+
+uint32_t resource_pool_in_use(const resource_pool_t* pool);
+
+static inline bool resource_pool_is_taken(const resource_pool_t* pool, int index) {
+    return (atomic_load_explicit(&pool->used[index / 32], memory_order_relaxed) >> (index % 32)) & 1;
+}
+
+#endif
@@ -0,0 +1,93 @@
+// components/resource_pool/include/resource_pool_metrics.h
+#ifndef RESOURCE_POOL_METRICS_H
+#define RESOURCE_POOL_METRICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "resource_pool.h"
+
+// Per-task timing for a resource pool, in microseconds:
+//   wait      resource_pool_acquire() entry → resource claimed
+//   hold      claimed → resource_pool_release(), charged to the acquirer
+//   timeouts  acquires that returned -1 (wait == 0 on an empty pool too)
+//
+// Attach storage with resource_pool_attach_metrics() after init; a pool without
+// it pays one pointer test per call. resource_pool_try_acquire() is not
+// measured. Each acquire and release takes the metrics lock briefly.
+//
+// A snapshot covers the window since the last reset (keep it under the
+// 71 minutes a 32-bit µs clock spans) and derives:
+//   utilisation      busy resource-time / (capacity × window), in-flight
+//                    holds included up to the snapshot
+//   mean queue       Little's law, Lq = λ·Wq = total queued time / window,
+//                    timed-out waits included
+//   offered load     λ × mean hold, in resources (Erlangs): what the
+//                    callers would keep busy if none timed out
+
+#define RESOURCE_POOL_CLIENTS       12      // per-task rows; the last one collects the rest
+#define RESOURCE_POOL_HIST_BUCKETS  24      // bucket i: < 2^i µs, last one open-ended
+#define RESOURCE_POOL_NAME_LEN      16
+
+typedef struct {
+    TaskHandle_t task;
+    char name[RESOURCE_POOL_NAME_LEN];
+    uint32_t requests;
+    uint32_t acquired;
+    uint32_t timeouts;
+    uint32_t released;
+    uint64_t wait_sum_us;       // acquired requests only
+    uint64_t queued_sum_us;     // every request, for Little's law
+    uint64_t hold_sum_us;
+    uint32_t wait_max_us;
+    uint32_t hold_max_us;
+    uint32_t wait_hist[RESOURCE_POOL_HIST_BUCKETS];
+    uint32_t hold_hist[RESOURCE_POOL_HIST_BUCKETS];
+} resource_pool_client_t;
+
+typedef struct resource_pool_metrics {
+    portMUX_TYPE lock;
+    int64_t window_start_us;
+    uint64_t busy_us;           // completed holds, clipped to the window
+    uint32_t clients;
+    resource_pool_client_t client[RESOURCE_POOL_CLIENTS];
+    uint32_t taken_us[RESOURCE_POOL_MAX];
+    uint8_t holder[RESOURCE_POOL_MAX];      // client row, or 0xFF when free
+} resource_pool_metrics_t;
+
+typedef struct {
+    uint32_t capacity;
+    uint32_t in_use;
+    uint32_t window_us;
+    uint32_t clients;
+    resource_pool_client_t client[RESOURCE_POOL_CLIENTS];
+
+    // Sums over every client
+    resource_pool_client_t total;
+
+    float utilisation;          // 0..1
+    float arrival_rate;         // requests per second
+    float mean_queue;           // tasks waiting, on average
+    float offered_load;         // resources
+    float timeout_rate;         // 0..1
+} resource_pool_report_t;
+
+void resource_pool_attach_metrics(resource_pool_t* pool, resource_pool_metrics_t* metrics);
+
+// Copy the counters and derive the queueing figures; `reset` starts a
+// new window
+void resource_pool_metrics_snapshot(resource_pool_t* pool, resource_pool_report_t* out, bool reset);
+
+// Upper bound of the bucket holding the pct-th percentile of count
+// samples, capped at max_us; 0 if empty
+uint32_t resource_pool_percentile_us(const uint32_t* hist, uint32_t count,
+                                     uint32_t max_us, uint32_t pct);
+
+// Per-task wait/hold percentiles and the pool-wide line
+void resource_pool_report_log(const resource_pool_report_t* report, const char* tag);
+
+// Hooks called by resource_pool.c
+void resource_pool_metrics_on_acquire(resource_pool_metrics_t* m, int index,
+                                      uint32_t wait_us, uint32_t now_us);
+void resource_pool_metrics_on_release(resource_pool_metrics_t* m, int index, uint32_t now_us);
+
+#endif
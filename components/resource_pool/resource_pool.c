@@ -0,0 +1,196 @@
+// components/resource_pool/resource_pool.c
+#include <string.h>
+#include "esp_timer.h"
+#include "resource_pool.h"
+#include "resource_pool_metrics.h"
+
+bool resource_pool_init(resource_pool_t* pool, uint32_t capacity) {
+    if (capacity == 0 || capacity > RESOURCE_POOL_MAX) {
+        return false;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->capacity = capacity;
+    pool->words = (capacity + 31) / 32;
+    for (uint32_t w = 0; w < RESOURCE_POOL_WORDS; w++) {
+        uint32_t first = w * 32;
+        // Bits that do not name a resource are permanently taken
+        uint32_t valid = first >= capacity ? 0
+                       : capacity - first >= 32 ? 0xFFFFFFFFu
+                       : (1u << (capacity - first)) - 1;
+        atomic_init(&pool->used[w], ~valid);
+    }
+    portMUX_INITIALIZE(&pool->lock);
+    return true;
+}
+
+// ================ BITMAP ================
+int resource_pool_try_acquire(resource_pool_t* pool) {
+    uint32_t start = atomic_load_explicit(&pool->hint, memory_order_relaxed);
+
+    for (uint32_t n = 0; n < pool->words; n++) {
+        uint32_t w = (start + n) % pool->words;
+        uint32_t used = atomic_load_explicit(&pool->used[w], memory_order_relaxed);
+
+        while (~used != 0) {
+            uint32_t bit = ~used & (used + 1);      // lowest zero
+            if (atomic_compare_exchange_weak_explicit(&pool->used[w], &used, used | bit,
+                                                      memory_order_acquire,
+                                                      memory_order_relaxed)) {
+                atomic_fetch_add_explicit(&pool->acquired, 1, memory_order_relaxed);
+                return (int)(w * 32 + __builtin_ctz(bit));
+            }
+            atomic_fetch_add_explicit(&pool->cas_retries, 1, memory_order_relaxed);
+        }
+    }
+    return -1;
+}
+
+uint32_t resource_pool_in_use(const resource_pool_t* pool) {
+    uint32_t taken = 0;
+
+    for (uint32_t w = 0; w < pool->words; w++) {
+        taken += __builtin_popcount(atomic_load_explicit(&pool->used[w], memory_order_relaxed));
+    }
+    return taken - (pool->words * 32 - pool->capacity);
+}
+
+// ================ WAITERS ================
+// Caller holds the lock
+static void waiter_push(resource_pool_t* pool, TaskHandle_t task, bool front) {
+    if (front) {
+        pool->waiter_head = (pool->waiter_head + RESOURCE_POOL_WAITERS - 1) % RESOURCE_POOL_WAITERS;
+        pool->waiter[pool->waiter_head] = task;
+    } else {
+        pool->waiter[(pool->waiter_head + pool->waiter_count) % RESOURCE_POOL_WAITERS] = task;
+    }
+    pool->waiter_count++;
+    atomic_store_explicit(&pool->waiting, pool->waiter_count, memory_order_relaxed);
+}
+
+// Caller holds the lock; false if task was already taken off by a release
+static bool waiter_remove(resource_pool_t* pool, TaskHandle_t task) {
+    for (uint32_t i = 0; i < pool->waiter_count; i++) {
+        uint32_t at = (pool->waiter_head + i) % RESOURCE_POOL_WAITERS;
+        if (pool->waiter[at] != task) {
+            continue;
+        }
+        for (; i + 1 < pool->waiter_count; i++) {
+            uint32_t next = (pool->waiter_head + i + 1) % RESOURCE_POOL_WAITERS;
+            pool->waiter[(pool->waiter_head + i) % RESOURCE_POOL_WAITERS] = pool->waiter[next];
+        }
+        pool->waiter_count--;
+        atomic_store_explicit(&pool->waiting, pool->waiter_count, memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Notify under the lock: a waiter only returns after waiter_remove() takes it,
+// so the handle cannot belong to a task that has already left and been deleted
+static void wake_oldest(resource_pool_t* pool) {
+    portENTER_CRITICAL(&pool->lock);
+    if (pool->waiter_count > 0) {
+        TaskHandle_t task = pool->waiter[pool->waiter_head];
+        pool->waiter_head = (pool->waiter_head + 1) % RESOURCE_POOL_WAITERS;
+        pool->waiter_count--;
+        atomic_store_explicit(&pool->waiting, pool->waiter_count, memory_order_relaxed);
+        xTaskNotifyGive(task);
+    }
+    portEXIT_CRITICAL(&pool->lock);
+}
+
+void resource_pool_release(resource_pool_t* pool, int index) {
+    if (index < 0 || (uint32_t)index >= pool->capacity) {
+        return;
+    }
+
+    if (pool->metrics != NULL) {
+        resource_pool_metrics_on_release(pool->metrics, index, (uint32_t)esp_timer_get_time());
+    }
+    atomic_fetch_and_explicit(&pool->used[index / 32], ~(1u << (index % 32)),
+                              memory_order_release);
+    atomic_store_explicit(&pool->hint, index / 32, memory_order_relaxed);
+
+    // Pairs with the fence in resource_pool_acquire: either the waiter's
+    // re-check sees the free bit, or we see it queued
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->waiting, memory_order_relaxed) > 0) {
+        wake_oldest(pool);
+    }
+}
+
+static int acquire_blocking(resource_pool_t* pool, TickType_t wait) {
+    int index = resource_pool_try_acquire(pool);
+    if (index >= 0 || wait == 0) {
+        return index;
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TimeOut_t timeout;
+    bool front = false;
+    vTaskSetTimeOutState(&timeout);
+
+    while (1) {
+        portENTER_CRITICAL(&pool->lock);
+        bool queued = pool->waiter_count < RESOURCE_POOL_WAITERS;
+        if (queued) {
+            waiter_push(pool, self, front);
+        }
+        portEXIT_CRITICAL(&pool->lock);
+
+        atomic_thread_fence(memory_order_seq_cst);
+        index = resource_pool_try_acquire(pool);
+
+        if (index < 0) {
+            if (queued) {
+                atomic_fetch_add_explicit(&pool->sleeps, 1, memory_order_relaxed);
+                ulTaskNotifyTake(pdTRUE, wait);
+            } else {
+                vTaskDelay(1);          // more waiters than slots: poll
+            }
+        }
+
+        bool woken = false;
+        if (queued) {
+            portENTER_CRITICAL(&pool->lock);
+            woken = !waiter_remove(pool, self);
+            portEXIT_CRITICAL(&pool->lock);
+        }
+
+        if (index < 0) {
+            index = resource_pool_try_acquire(pool);
+        }
+        if (index >= 0) {
+            // A release picked us but we already hold a resource: a slot may
+            // still be free, so hand the wakeup to the next waiter
+            if (woken && atomic_load_explicit(&pool->waiting, memory_order_relaxed) > 0) {
+                wake_oldest(pool);
+            }
+            return index;
+        }
+
+        if (xTaskCheckForTimeOut(&timeout, &wait) == pdTRUE) {
+            // Same hand-off if a release chose us just as we gave up
+            if (woken) {
+                wake_oldest(pool);
+            }
+            atomic_fetch_add_explicit(&pool->timeouts, 1, memory_order_relaxed);
+            return -1;
+        }
+        // Woken but a newcomer took the slot: wait again at the front
+        front = woken;
+    }
+}
+
+int resource_pool_acquire(resource_pool_t* pool, TickType_t wait) {
+    if (pool->metrics == NULL) {
+        return acquire_blocking(pool, wait);
+    }
+
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    int index = acquire_blocking(pool, wait);
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    resource_pool_metrics_on_acquire(pool->metrics, index, now - start, now);
+    return index;
+}
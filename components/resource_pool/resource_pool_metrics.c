@@ -0,0 +1,200 @@
+// components/resource_pool/resource_pool_metrics.c
+#include <string.h>
+#include <stddef.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "resource_pool_metrics.h"
+
+#define NO_HOLDER   0xFF
+
+static inline uint32_t hist_bucket(uint32_t us) {
+    uint32_t b = us == 0 ? 0 : 32 - __builtin_clz(us);
+    return b < RESOURCE_POOL_HIST_BUCKETS ? b : RESOURCE_POOL_HIST_BUCKETS - 1;
+}
+
+static inline void hist_add(uint32_t* hist, uint64_t* sum, uint32_t* max, uint32_t us) {
+    hist[hist_bucket(us)]++;
+    *sum += us;
+    if (us > *max) {
+        *max = us;
+    }
+}
+
+void resource_pool_attach_metrics(resource_pool_t* pool, resource_pool_metrics_t* metrics) {
+    memset(metrics, 0, sizeof(*metrics));
+    portMUX_INITIALIZE(&metrics->lock);
+    memset(metrics->holder, NO_HOLDER, sizeof(metrics->holder));
+    metrics->window_start_us = esp_timer_get_time();
+    pool->metrics = metrics;
+}
+
+// ================ RECORDING ================
+// Caller holds the lock
+static uint32_t client_row(resource_pool_metrics_t* m, TaskHandle_t task) {
+    for (uint32_t i = 0; i < m->clients; i++) {
+        if (m->client[i].task == task) {
+            return i;
+        }
+    }
+
+    resource_pool_client_t* c;
+    if (m->clients < RESOURCE_POOL_CLIENTS - 1) {
+        c = &m->client[m->clients++];
+        c->task = task;
+        strncpy(c->name, pcTaskGetName(task), RESOURCE_POOL_NAME_LEN - 1);
+        return c - m->client;
+    }
+
+    // Shared last row, task stays NULL so no lookup matches it
+    c = &m->client[RESOURCE_POOL_CLIENTS - 1];
+    if (m->clients < RESOURCE_POOL_CLIENTS) {
+        m->clients = RESOURCE_POOL_CLIENTS;
+        strcpy(c->name, "(others)");
+    }
+    return RESOURCE_POOL_CLIENTS - 1;
+}
+
+void resource_pool_metrics_on_acquire(resource_pool_metrics_t* m, int index,
+                                      uint32_t wait_us, uint32_t now_us) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    portENTER_CRITICAL(&m->lock);
+    uint32_t row = client_row(m, self);
+    resource_pool_client_t* c = &m->client[row];
+    c->requests++;
+    c->queued_sum_us += wait_us;
+    if (index < 0) {
+        c->timeouts++;
+    } else {
+        c->acquired++;
+        hist_add(c->wait_hist, &c->wait_sum_us, &c->wait_max_us, wait_us);
+        m->taken_us[index] = now_us;
+        m->holder[index] = row;
+    }
+    portEXIT_CRITICAL(&m->lock);
+}
+
+void resource_pool_metrics_on_release(resource_pool_metrics_t* m, int index, uint32_t now_us) {
+    portENTER_CRITICAL(&m->lock);
+    uint32_t row = m->holder[index];
+    if (row != NO_HOLDER) {
+        resource_pool_client_t* c = &m->client[row];
+        uint32_t hold = now_us - m->taken_us[index];
+        uint32_t in_window = now_us - (uint32_t)m->window_start_us;
+
+        c->released++;
+        hist_add(c->hold_hist, &c->hold_sum_us, &c->hold_max_us, hold);
+        m->busy_us += hold < in_window ? hold : in_window;
+        m->holder[index] = NO_HOLDER;
+    }
+    portEXIT_CRITICAL(&m->lock);
+}
+
+// ================ REPORTING ================
+static void add_client(resource_pool_client_t* sum, const resource_pool_client_t* c) {
+    sum->requests += c->requests;
+    sum->acquired += c->acquired;
+    sum->timeouts += c->timeouts;
+    sum->released += c->released;
+    sum->wait_sum_us += c->wait_sum_us;
+    sum->queued_sum_us += c->queued_sum_us;
+    sum->hold_sum_us += c->hold_sum_us;
+    if (c->wait_max_us > sum->wait_max_us) sum->wait_max_us = c->wait_max_us;
+    if (c->hold_max_us > sum->hold_max_us) sum->hold_max_us = c->hold_max_us;
+    for (uint32_t i = 0; i < RESOURCE_POOL_HIST_BUCKETS; i++) {
+        sum->wait_hist[i] += c->wait_hist[i];
+        sum->hold_hist[i] += c->hold_hist[i];
+    }
+}
+
+void resource_pool_metrics_snapshot(resource_pool_t* pool, resource_pool_report_t* out, bool reset) {
+    resource_pool_metrics_t* m = pool->metrics;
+    uint32_t now = (uint32_t)esp_timer_get_time();
+
+    memset(out, 0, sizeof(*out));
+    out->capacity = pool->capacity;
+    out->in_use = resource_pool_in_use(pool);
+    if (m == NULL) {
+        return;
+    }
+
+    portENTER_CRITICAL(&m->lock);
+    out->window_us = now - (uint32_t)m->window_start_us;
+    uint64_t busy = m->busy_us;
+    for (uint32_t i = 0; i < pool->capacity; i++) {
+        if (m->holder[i] != NO_HOLDER) {
+            uint32_t held = now - m->taken_us[i];
+            busy += held < out->window_us ? held : out->window_us;
+        }
+    }
+    out->clients = m->clients;
+    memcpy(out->client, m->client, sizeof(out->client));
+
+    if (reset) {
+        // Rows keep their task so holds in flight are still charged to it
+        for (uint32_t i = 0; i < m->clients; i++) {
+            resource_pool_client_t* c = &m->client[i];
+            memset(&c->requests, 0, sizeof(*c) - offsetof(resource_pool_client_t, requests));
+        }
+        m->busy_us = 0;
+        m->window_start_us += out->window_us;
+    }
+    portEXIT_CRITICAL(&m->lock);
+
+    for (uint32_t i = 0; i < out->clients; i++) {
+        add_client(&out->total, &out->client[i]);
+    }
+
+    const resource_pool_client_t* t = &out->total;
+    float window = out->window_us > 0 ? (float)out->window_us : 1.0f;
+    float mean_hold_us = t->released ? (float)t->hold_sum_us / t->released : 0;
+
+    out->utilisation = busy / (out->capacity * window);
+    out->arrival_rate = t->requests * 1e6f / window;
+    out->mean_queue = t->queued_sum_us / window;
+    out->offered_load = t->requests * mean_hold_us / window;
+    out->timeout_rate = t->requests ? (float)t->timeouts / t->requests : 0;
+}
+
+uint32_t resource_pool_percentile_us(const uint32_t* hist, uint32_t count,
+                                     uint32_t max_us, uint32_t pct) {
+    uint64_t target = ((uint64_t)count * pct + 99) / 100;
+    uint64_t seen = 0;
+
+    if (count == 0) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < RESOURCE_POOL_HIST_BUCKETS - 1; i++) {
+        seen += hist[i];
+        if (seen >= target) {
+            uint32_t bound = i == 0 ? 0 : (1u << i) - 1;
+            return bound < max_us ? bound : max_us;
+        }
+    }
+    return max_us;
+}
+
+static void log_row(const char* tag, const char* name, const resource_pool_client_t* c) {
+    ESP_LOGI(tag, "  %-10s %5lu %4lu  %8lu %8lu %8lu %8lu   %7.1f %7.1f",
+             name, c->requests, c->timeouts,
+             resource_pool_percentile_us(c->wait_hist, c->acquired, c->wait_max_us, 50),
+             resource_pool_percentile_us(c->wait_hist, c->acquired, c->wait_max_us, 90),
+             resource_pool_percentile_us(c->wait_hist, c->acquired, c->wait_max_us, 99),
+             c->wait_max_us,
+             resource_pool_percentile_us(c->hold_hist, c->released, c->hold_max_us, 50) / 1000.0f,
+             resource_pool_percentile_us(c->hold_hist, c->released, c->hold_max_us, 99) / 1000.0f);
+}
+
+void resource_pool_report_log(const resource_pool_report_t* report, const char* tag) {
+    ESP_LOGI(tag, "  task         req  t/o  wait p50≤     p90≤     p99≤  max (us)  hold p50≤ p99≤ (ms)");
+    for (uint32_t i = 0; i < report->clients; i++) {
+        log_row(tag, report->client[i].name, &report->client[i]);
+    }
+    log_row(tag, "all", &report->total);
+
+    ESP_LOGI(tag, "  %lu/%lu in use, utilisation %.0f%%, arrivals %.2f/s, mean queue %.2f, "
+             "offered load %.2f, timeouts %.1f%% over %.1f s",
+             report->in_use, report->capacity, report->utilisation * 100, report->arrival_rate,
+             report->mean_queue, report->offered_load, report->timeout_rate * 100,
+             report->window_us / 1e6f);
+}
@@ -0,0 +1,67 @@
+// components/spsc_ring/include/spsc_ring.h
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Single-producer / single-consumer ring of fixed-size items.
+//
+// head is written only by the producer and tail only by the consumer, so
+// send and receive take no critical section. A blocked consumer sleeps on
+// its task notification. The producer notifies only when its item turns
+// the ring from empty to non-empty while the consumer is waiting.
+//
+// Rules: exactly one task or ISR sends, and exactly one task receives. The
+// consumer's notification value (index 0) is shared with anything else that
+// notifies that task, so callers must tolerate spurious wakeups. The ring
+// itself re-checks and sleeps again.
+
+typedef struct {
+    uint8_t* storage;           // capacity * item_size bytes, caller-owned
+    uint32_t item_size;
+    uint32_t mask;              // capacity - 1, capacity is a power of two
+    atomic_uint head;           // items published (free-running)
+    atomic_uint tail;           // items consumed (free-running)
+    atomic_bool consumer_waiting;
+    TaskHandle_t consumer;      // set by the consumer before it waits
+
+    // Producer-side counters
+    uint32_t sent;
+    uint32_t full;              // sends rejected because the ring was full
+    uint32_t notifies;          // empty → non-empty wakeups issued
+    uint32_t high_water;
+    // Consumer-side counters
+    uint32_t received;
+    uint32_t sleeps;
+} spsc_ring_t;
+
+#define SPSC_RING_STORAGE_SIZE(capacity, item_size) ((capacity) * (item_size))
+
+// capacity must be a power of two; storage must hold capacity * item_size bytes
+bool spsc_ring_init(spsc_ring_t* ring, void* storage, uint32_t capacity, uint32_t item_size);
+
+// Non-blocking: false when the ring is full (counted in ring->full)
+bool spsc_ring_send(spsc_ring_t* ring, const void* item);
+bool spsc_ring_send_from_isr(spsc_ring_t* ring, const void* item,
+                             BaseType_t* higher_priority_task_woken);
+
+// Same semantics as xQueueReceive: wait 0 polls, portMAX_DELAY blocks forever
+bool spsc_ring_receive(spsc_ring_t* ring, void* item, TickType_t wait);
+
+// For a consumer that sleeps on its notification for several sources at
+// once: arm before blocking. Returns false if data is already there, in
+// which case the consumer must not sleep. Disarm after waking.
+bool spsc_ring_arm_wait(spsc_ring_t* ring);
+void spsc_ring_disarm_wait(spsc_ring_t* ring);
+
+uint32_t spsc_ring_count(spsc_ring_t* ring);
+
+static inline uint32_t spsc_ring_capacity(const spsc_ring_t* ring) {
+    return ring->mask + 1;
+}
+
+#endif
@@ -0,0 +1,130 @@
+// components/spsc_ring/spsc_ring.c
+#include <string.h>
+#include "esp_attr.h"
+#include "spsc_ring.h"
+
+bool spsc_ring_init(spsc_ring_t* ring, void* storage, uint32_t capacity, uint32_t item_size) {
+    if (storage == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0 || item_size == 0) {
+        return false;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->storage = (uint8_t*)storage;
+    ring->item_size = item_size;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->consumer_waiting, false);
+    return true;
+}
+
+// Publish one item. *notify is set when the consumer must be woken: the
+// ring was empty before this item and the consumer is armed.
+static inline IRAM_ATTR bool spsc_ring_push(spsc_ring_t* ring, const void* item, bool* notify) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned used = head - atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    *notify = false;
+    if (used > ring->mask) {
+        ring->full++;
+        return false;
+    }
+
+    memcpy(ring->storage + (head & ring->mask) * ring->item_size, item, ring->item_size);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    ring->sent++;
+    if (used + 1 > ring->high_water) {
+        ring->high_water = used + 1;
+    }
+
+    // Pairs with the fence in spsc_ring_arm_wait: either the consumer sees
+    // the new head, or we see its waiting flag. The fresh tail tells whether
+    // our item is the only one, i.e. this is the empty → non-empty edge.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&ring->tail, memory_order_relaxed) == head &&
+        atomic_load_explicit(&ring->consumer_waiting, memory_order_acquire)) {
+        ring->notifies++;
+        *notify = true;
+    }
+    return true;
+}
+
+IRAM_ATTR bool spsc_ring_send(spsc_ring_t* ring, const void* item) {
+    bool notify;
+
+    if (!spsc_ring_push(ring, item, &notify)) {
+        return false;
+    }
+    if (notify) {
+        xTaskNotifyGive(ring->consumer);
+    }
+    return true;
+}
+
+IRAM_ATTR bool spsc_ring_send_from_isr(spsc_ring_t* ring, const void* item,
+                                       BaseType_t* higher_priority_task_woken) {
+    bool notify;
+
+    if (!spsc_ring_push(ring, item, &notify)) {
+        return false;
+    }
+    if (notify) {
+        vTaskNotifyGiveFromISR(ring->consumer, higher_priority_task_woken);
+    }
+    return true;
+}
+
+static bool spsc_ring_pop(spsc_ring_t* ring, void* item) {
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    if (tail == atomic_load_explicit(&ring->head, memory_order_acquire)) {
+        return false;
+    }
+    memcpy(item, ring->storage + (tail & ring->mask) * ring->item_size, ring->item_size);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    ring->received++;
+    return true;
+}
+
+bool spsc_ring_arm_wait(spsc_ring_t* ring) {
+    ring->consumer = xTaskGetCurrentTaskHandle();
+    atomic_store_explicit(&ring->consumer_waiting, true, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(&ring->head, memory_order_relaxed) !=
+        atomic_load_explicit(&ring->tail, memory_order_relaxed)) {
+        spsc_ring_disarm_wait(ring);
+        return false;
+    }
+    return true;
+}
+
+void spsc_ring_disarm_wait(spsc_ring_t* ring) {
+    atomic_store_explicit(&ring->consumer_waiting, false, memory_order_relaxed);
+}
+
+bool spsc_ring_receive(spsc_ring_t* ring, void* item, TickType_t wait) {
+    TimeOut_t timeout;
+
+    vTaskSetTimeOutState(&timeout);
+    for (;;) {
+        if (spsc_ring_pop(ring, item)) {
+            return true;
+        }
+        // Updates wait to the time left; true once it has run out
+        if (xTaskCheckForTimeOut(&timeout, &wait) == pdTRUE) {
+            return false;
+        }
+        if (spsc_ring_arm_wait(ring)) {
+            ring->sleeps++;
+            ulTaskNotifyTake(pdTRUE, wait);
+            spsc_ring_disarm_wait(ring);
+        }
+    }
+}
+
+uint32_t spsc_ring_count(spsc_ring_t* ring) {
+    return atomic_load_explicit(&ring->head, memory_order_acquire) -
+           atomic_load_explicit(&ring->tail, memory_order_acquire);
+}
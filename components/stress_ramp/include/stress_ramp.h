@@ -0,0 +1,53 @@
+// components/stress_ramp/include/stress_ramp.h
+#ifndef STRESS_RAMP_H
+#define STRESS_RAMP_H
+
+#include <stdint.h>
+
+// Timer-service stress ramp. Each sweep raises one load dimension step by
+// step while holding the other fixed, until the deadline-miss or
+// command-failure rate crosses its limit:
+//   timers     live auto-reload timers, at STRESS_RAMP_FIXED_CMD_RATE
+//   cmd_rate   paced xTimerChangePeriod/xTimerReset commands per second,
+//              on STRESS_RAMP_FIXED_TIMERS timers
+//
+// Uses only FreeRTOS timer/task APIs and printf, so the same harness runs on
+// the ESP32 and under the Linux (POSIX) FreeRTOS port. Output lines start
+// with "STRESS," and are plain CSV for host-side parsing.
+
+#define STRESS_RAMP_MAX_TIMERS       128
+#define STRESS_RAMP_TIMERS_START     8
+#define STRESS_RAMP_TIMERS_STEP      8
+#define STRESS_RAMP_CMD_RATE_START   50      // timer commands per second
+#define STRESS_RAMP_CMD_RATE_STEP    50
+#define STRESS_RAMP_CMD_RATE_MAX     5000
+#define STRESS_RAMP_FIXED_TIMERS     16      // held while the command rate sweeps
+#define STRESS_RAMP_FIXED_CMD_RATE   100     // held while the timer count sweeps
+#define STRESS_RAMP_MAX_STEPS        40
+#define STRESS_RAMP_STEP_MS          3000
+#define STRESS_RAMP_PERIOD_MIN_MS    20      // periods 20..90 ms in 10 ms steps
+#define STRESS_RAMP_PERIOD_VARIANTS  8
+#define STRESS_RAMP_LATE_TOL_TICKS   2
+#define STRESS_RAMP_MISS_LIMIT_PCT   5.0f
+#define STRESS_RAMP_FAIL_LIMIT_PCT   1.0f
+
+typedef enum {
+    STRESS_RAMP_SWEEP_TIMERS = 0,
+    STRESS_RAMP_SWEEP_CMD_RATE,
+} stress_ramp_sweep_t;
+
+typedef struct {
+    int best_step;              // last step within both limits, -1 if none
+    uint32_t max_timers;
+    uint32_t max_cmd_rate;
+    const char* limited_by;     // "miss", "fail", "alloc", "ramp_max", "max_steps"
+    uint32_t command_failures;  // over every step of the sweep
+} stress_ramp_result_t;
+
+// Run one sweep; blocks for up to STRESS_RAMP_MAX_STEPS steps
+void stress_ramp_sweep(stress_ramp_sweep_t sweep, stress_ramp_result_t* result);
+
+// Both sweeps in turn; either result pointer may be NULL
+void stress_ramp_run(stress_ramp_result_t* by_timers, stress_ramp_result_t* by_cmd_rate);
+
+#endif
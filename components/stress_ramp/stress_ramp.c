@@ -0,0 +1,213 @@
+// components/stress_ramp/stress_ramp.c
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "stress_ramp.h"
+
+// Counters of the running step
+typedef struct {
+    uint32_t callbacks;
+    uint32_t misses;
+    uint32_t max_late_ticks;
+    uint32_t commands;
+    uint32_t command_failures;
+} stress_ramp_stats_t;
+
+static const char* sweep_names[] = { "timers", "cmd_rate" };
+
+static TimerHandle_t ramp_timers[STRESS_RAMP_MAX_TIMERS];
+static stress_ramp_stats_t ramp_stats = {0};
+static portMUX_TYPE ramp_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// xorshift32: reproducible command sequence on both targets
+static uint32_t stress_ramp_rand(void) {
+    static uint32_t state = 0x9E3779B9u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static uint32_t stress_ramp_period_ms(uint32_t variant) {
+    return STRESS_RAMP_PERIOD_MIN_MS + (variant % STRESS_RAMP_PERIOD_VARIANTS) * 10;
+}
+
+// ================ DEADLINE CHECK ================
+// Lateness is measured against the expiry the kernel actually scheduled,
+// so a command only moves the deadline once the service task executes it;
+// time a command spends in the queue is not charged as a miss. Auto-reload
+// timers are re-armed before their callback runs, so the expiry being
+// served is one period before the next one. Resolution is one tick.
+static void stress_ramp_callback(TimerHandle_t timer) {
+    TickType_t due = xTimerGetExpiryTime(timer) - xTimerGetPeriod(timer);
+    uint32_t late = (uint32_t)(xTaskGetTickCount() - due);
+
+    portENTER_CRITICAL(&ramp_lock);
+    ramp_stats.callbacks++;
+    if (late > STRESS_RAMP_LATE_TOL_TICKS) {
+        ramp_stats.misses++;
+    }
+    if (late > ramp_stats.max_late_ticks) {
+        ramp_stats.max_late_ticks = late;
+    }
+    portEXIT_CRITICAL(&ramp_lock);
+}
+
+// ================ LOAD ================
+// Grow the live timer set to `count`; returns the number actually running
+static uint32_t stress_ramp_grow(uint32_t live, uint32_t count) {
+    for (uint32_t i = live; i < count; i++) {
+        TimerHandle_t h = xTimerCreate("Ramp", pdMS_TO_TICKS(stress_ramp_period_ms(i)), pdTRUE,
+                                       (void*)i, stress_ramp_callback);
+        if (h == NULL) {
+            return i;
+        }
+
+        // Setup commands may block; only the paced load below counts failures
+        if (xTimerStart(h, pdMS_TO_TICKS(100)) != pdPASS) {
+            xTimerDelete(h, pdMS_TO_TICKS(100));
+            return i;
+        }
+        ramp_timers[i] = h;
+    }
+    return count;
+}
+
+// One paced command: change period (restarts the timer) or plain reset,
+// issued with zero block time so a full timer queue shows up as a failure
+static void stress_ramp_issue_command(uint32_t live) {
+    uint32_t r = stress_ramp_rand();
+    TimerHandle_t h = ramp_timers[r % live];
+    BaseType_t ok;
+
+    if (r & 0x80000000u) {
+        ok = xTimerChangePeriod(h, pdMS_TO_TICKS(stress_ramp_period_ms(r >> 8)), 0);
+    } else {
+        ok = xTimerReset(h, 0);
+    }
+
+    portENTER_CRITICAL(&ramp_lock);
+    ramp_stats.commands++;
+    if (ok != pdPASS) {
+        ramp_stats.command_failures++;
+    }
+    portEXIT_CRITICAL(&ramp_lock);
+}
+
+// Generate cmd_rate commands/s for duration_ms. The tick is the pacing
+// granularity, so each tick issues its share as a burst (fraction carried over)
+static void stress_ramp_generate(uint32_t live, uint32_t cmd_rate, uint32_t duration_ms) {
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t end = last_wake + pdMS_TO_TICKS(duration_ms);
+    uint32_t credit_milli = 0;   // commands * 1000
+
+    while ((int32_t)(end - xTaskGetTickCount()) > 0) {
+        vTaskDelayUntil(&last_wake, 1);
+        credit_milli += cmd_rate * portTICK_PERIOD_MS;
+        while (credit_milli >= 1000) {
+            credit_milli -= 1000;
+            stress_ramp_issue_command(live);
+        }
+    }
+}
+
+static void stress_ramp_cleanup(uint32_t live) {
+    for (uint32_t i = 0; i < live; i++) {
+        if (ramp_timers[i] != NULL) {
+            xTimerDelete(ramp_timers[i], pdMS_TO_TICKS(100));
+            ramp_timers[i] = NULL;
+        }
+    }
+}
+
+// ================ SWEEPS ================
+void stress_ramp_sweep(stress_ramp_sweep_t sweep, stress_ramp_result_t* result) {
+    const char* name = sweep_names[sweep];
+    bool by_timers = (sweep == STRESS_RAMP_SWEEP_TIMERS);
+    uint32_t live = 0;
+
+    memset(result, 0, sizeof(*result));
+    result->best_step = -1;
+    result->limited_by = "max_steps";
+
+    for (int step = 0; step < STRESS_RAMP_MAX_STEPS; step++) {
+        uint32_t want = by_timers ? STRESS_RAMP_TIMERS_START + step * STRESS_RAMP_TIMERS_STEP
+                                  : STRESS_RAMP_FIXED_TIMERS;
+        uint32_t rate = by_timers ? STRESS_RAMP_FIXED_CMD_RATE
+                                  : STRESS_RAMP_CMD_RATE_START + step * STRESS_RAMP_CMD_RATE_STEP;
+        if (want > STRESS_RAMP_MAX_TIMERS) want = STRESS_RAMP_MAX_TIMERS;
+        if (rate > STRESS_RAMP_CMD_RATE_MAX) rate = STRESS_RAMP_CMD_RATE_MAX;
+
+        live = stress_ramp_grow(live, want);
+        if (live < want) {
+            printf("STRESS,%s,%d,%lu,%lu,0,0,0.00,0,0,0,0.00,alloc_fail\n",
+                   name, step, (unsigned long)live, (unsigned long)rate);
+            result->limited_by = "alloc";
+            break;
+        }
+
+        // Let new timers take their first expiry before measuring
+        vTaskDelay(pdMS_TO_TICKS(STRESS_RAMP_PERIOD_MIN_MS +
+                                 STRESS_RAMP_PERIOD_VARIANTS * 10));
+        portENTER_CRITICAL(&ramp_lock);
+        memset(&ramp_stats, 0, sizeof(ramp_stats));
+        portEXIT_CRITICAL(&ramp_lock);
+
+        stress_ramp_generate(live, rate, STRESS_RAMP_STEP_MS);
+
+        portENTER_CRITICAL(&ramp_lock);
+        stress_ramp_stats_t snap = ramp_stats;
+        portEXIT_CRITICAL(&ramp_lock);
+
+        float miss_pct = snap.callbacks ? (100.0f * snap.misses / snap.callbacks) : 0.0f;
+        float fail_pct = snap.commands ? (100.0f * snap.command_failures / snap.commands) : 0.0f;
+        bool miss_over = miss_pct > STRESS_RAMP_MISS_LIMIT_PCT;
+        bool fail_over = fail_pct > STRESS_RAMP_FAIL_LIMIT_PCT;
+        const char* verdict = miss_over ? "miss_limit" : fail_over ? "fail_limit" : "ok";
+
+        printf("STRESS,%s,%d,%lu,%lu,%lu,%lu,%.2f,%lu,%lu,%lu,%.2f,%s\n",
+               name, step, (unsigned long)live, (unsigned long)rate,
+               (unsigned long)snap.callbacks, (unsigned long)snap.misses, miss_pct,
+               (unsigned long)(snap.max_late_ticks * portTICK_PERIOD_MS * 1000),
+               (unsigned long)snap.commands, (unsigned long)snap.command_failures,
+               fail_pct, verdict);
+        fflush(stdout);
+
+        result->command_failures += snap.command_failures;
+
+        if (miss_over || fail_over) {
+            result->limited_by = miss_over ? "miss" : "fail";
+            break;
+        }
+        result->best_step = step;
+        result->max_timers = live;
+        result->max_cmd_rate = rate;
+
+        if (by_timers ? want == STRESS_RAMP_MAX_TIMERS : rate == STRESS_RAMP_CMD_RATE_MAX) {
+            result->limited_by = "ramp_max";
+            break;
+        }
+    }
+
+    stress_ramp_cleanup(live);
+
+    printf("STRESS_RESULT,sweep=%s,best_step=%d,max_timers=%lu,max_cmd_rate=%lu,limited_by=%s\n",
+           name, result->best_step, (unsigned long)result->max_timers,
+           (unsigned long)result->max_cmd_rate, result->limited_by);
+    fflush(stdout);
+}
+
+void stress_ramp_run(stress_ramp_result_t* by_timers, stress_ramp_result_t* by_cmd_rate) {
+    stress_ramp_result_t scratch;
+
+    printf("STRESS: miss limit %.1f%%, fail limit %.1f%%, %d ms per step\n",
+           STRESS_RAMP_MISS_LIMIT_PCT, STRESS_RAMP_FAIL_LIMIT_PCT, STRESS_RAMP_STEP_MS);
+    printf("STRESS,sweep,step,timers,cmd_rate,callbacks,misses,miss_pct,max_late_us,"
+           "commands,cmd_failures,fail_pct,result\n");
+
+    stress_ramp_sweep(STRESS_RAMP_SWEEP_TIMERS, by_timers ? by_timers : &scratch);
+    stress_ramp_sweep(STRESS_RAMP_SWEEP_CMD_RATE, by_cmd_rate ? by_cmd_rate : &scratch);
+}
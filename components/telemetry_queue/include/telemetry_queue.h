@@ -0,0 +1,96 @@
+// components/telemetry_queue/include/telemetry_queue.h
+#ifndef TELEMETRY_QUEUE_H
+#define TELEMETRY_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+// FreeRTOS queue wrapper that counts instead of logging: occupancy
+// high-water mark, enqueue failures by cause and an enqueue → dequeue
+// latency histogram, all read through telemetry_queue_snapshot().
+//
+// Latency needs a send time inside each item, in microseconds:
+//   TELEMETRY_STAMP_TRAILER   the wrapper appends 4 bytes to every slot
+//   offsetof(item, field)     the item already has a uint32_t µs field,
+//                             which the wrapper fills on send
+
+#define TELEMETRY_STAMP_TRAILER     (-1)
+#define TELEMETRY_QUEUE_MAX_ITEM    192     // item + stamp, copied on the stack
+#define TELEMETRY_LATENCY_BUCKETS   24      // bucket i: < 2^i µs, last one open-ended
+
+typedef enum {
+    TELEMETRY_FAIL_FULL,        // wait == 0 and no space
+    TELEMETRY_FAIL_TIMEOUT,     // blocked for the whole wait
+    TELEMETRY_FAIL_ISR_FULL,    // send from ISR on a full queue
+    TELEMETRY_FAIL_COUNT
+} telemetry_fail_t;
+
+typedef struct {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t failed[TELEMETRY_FAIL_COUNT];
+    uint32_t high_water;
+    uint32_t latency_max_us;
+    uint64_t latency_sum_us;
+    uint32_t latency_hist[TELEMETRY_LATENCY_BUCKETS];
+} telemetry_stats_t;
+
+// The counters alone, for a queue the wrapper does not own (MPMC queue,
+// SPSC ring): its owner records every send and dequeue and gets the same
+// snapshot back
+typedef struct {
+    portMUX_TYPE lock;
+    telemetry_stats_t stats;
+} telemetry_counters_t;
+
+typedef struct {
+    const char* name;
+    QueueHandle_t queue;        // may be added to a queue set
+    uint32_t length;
+    uint32_t item_size;         // as seen by callers, without a trailer
+    int stamp_offset;
+    telemetry_counters_t counters;
+} telemetry_queue_t;
+
+typedef struct {
+    const char* name;
+    uint32_t length;
+    uint32_t waiting;
+    telemetry_stats_t stats;
+} telemetry_snapshot_t;
+
+bool telemetry_queue_init(telemetry_queue_t* q, const char* name, uint32_t length,
+                          size_t item_size, int stamp_offset);
+
+// Same semantics as xQueueSend / xQueueSendFromISR / xQueueReceive
+BaseType_t telemetry_queue_send(telemetry_queue_t* q, const void* item, TickType_t wait);
+BaseType_t telemetry_queue_send_from_isr(telemetry_queue_t* q, const void* item,
+                                         BaseType_t* higher_priority_task_woken);
+BaseType_t telemetry_queue_receive(telemetry_queue_t* q, void* item, TickType_t wait);
+
+// Consistent copy of the counters; `reset` starts a new measurement window
+// (the high-water mark restarts from the current depth)
+void telemetry_queue_snapshot(telemetry_queue_t* q, telemetry_snapshot_t* out, bool reset);
+
+void telemetry_counters_init(telemetry_counters_t* c);
+
+// `waiting` is the depth right after the send
+void telemetry_record_sent(telemetry_counters_t* c, uint32_t waiting);
+void telemetry_record_failed(telemetry_counters_t* c, telemetry_fail_t cause);
+void telemetry_record_received(telemetry_counters_t* c, uint32_t latency_us);
+
+// As telemetry_queue_snapshot(), with the queue's name, length and depth
+// supplied by the owner
+void telemetry_counters_snapshot(telemetry_counters_t* c, const char* name, uint32_t length,
+                                 uint32_t waiting, telemetry_snapshot_t* out, bool reset);
+
+// Upper bound of the bucket holding the pct-th percentile, 0 if empty
+uint32_t telemetry_latency_percentile_us(const telemetry_stats_t* stats, uint32_t pct);
+
+// One-line summary of a snapshot
+void telemetry_snapshot_log(const telemetry_snapshot_t* snap, const char* tag);
+
+#endif
@@ -0,0 +1,188 @@
+// components/telemetry_queue/telemetry_queue.c
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "telemetry_queue.h"
+
+static inline uint32_t slot_size(const telemetry_queue_t* q) {
+    return q->item_size + (q->stamp_offset == TELEMETRY_STAMP_TRAILER ? sizeof(uint32_t) : 0);
+}
+
+static inline uint32_t stamp_pos(const telemetry_queue_t* q) {
+    return q->stamp_offset == TELEMETRY_STAMP_TRAILER ? q->item_size : (uint32_t)q->stamp_offset;
+}
+
+static inline uint32_t latency_bucket(uint32_t us) {
+    uint32_t b = us == 0 ? 0 : 32 - __builtin_clz(us);
+    return b < TELEMETRY_LATENCY_BUCKETS ? b : TELEMETRY_LATENCY_BUCKETS - 1;
+}
+
+bool telemetry_queue_init(telemetry_queue_t* q, const char* name, uint32_t length,
+                          size_t item_size, int stamp_offset) {
+    memset(q, 0, sizeof(*q));
+    q->name = name;
+    q->length = length;
+    q->item_size = item_size;
+    q->stamp_offset = stamp_offset;
+    telemetry_counters_init(&q->counters);
+
+    if (stamp_offset != TELEMETRY_STAMP_TRAILER &&
+        (stamp_offset < 0 || stamp_offset + sizeof(uint32_t) > item_size)) {
+        return false;
+    }
+    if (slot_size(q) > TELEMETRY_QUEUE_MAX_ITEM) {
+        return false;
+    }
+
+    q->queue = xQueueCreate(length, slot_size(q));
+    return q->queue != NULL;
+}
+
+// Copy the item and stamp the send time into the slot image
+static inline void stamp_item(const telemetry_queue_t* q, uint8_t* slot, const void* item) {
+    uint32_t now = (uint32_t)esp_timer_get_time();
+
+    memcpy(slot, item, q->item_size);
+    memcpy(slot + stamp_pos(q), &now, sizeof(now));
+}
+
+// ================ COUNTERS ================
+void telemetry_counters_init(telemetry_counters_t* c) {
+    memset(c, 0, sizeof(*c));
+    portMUX_INITIALIZE(&c->lock);
+}
+
+// Caller holds the lock
+static inline void stats_sent(telemetry_stats_t* s, uint32_t waiting) {
+    s->sent++;
+    if (waiting > s->high_water) {
+        s->high_water = waiting;
+    }
+}
+
+void telemetry_record_sent(telemetry_counters_t* c, uint32_t waiting) {
+    portENTER_CRITICAL(&c->lock);
+    stats_sent(&c->stats, waiting);
+    portEXIT_CRITICAL(&c->lock);
+}
+
+void telemetry_record_failed(telemetry_counters_t* c, telemetry_fail_t cause) {
+    portENTER_CRITICAL(&c->lock);
+    c->stats.failed[cause]++;
+    portEXIT_CRITICAL(&c->lock);
+}
+
+void telemetry_record_received(telemetry_counters_t* c, uint32_t latency_us) {
+    portENTER_CRITICAL(&c->lock);
+    c->stats.received++;
+    c->stats.latency_sum_us += latency_us;
+    if (latency_us > c->stats.latency_max_us) {
+        c->stats.latency_max_us = latency_us;
+    }
+    c->stats.latency_hist[latency_bucket(latency_us)]++;
+    portEXIT_CRITICAL(&c->lock);
+}
+
+void telemetry_counters_snapshot(telemetry_counters_t* c, const char* name, uint32_t length,
+                                 uint32_t waiting, telemetry_snapshot_t* out, bool reset) {
+    out->name = name;
+    out->length = length;
+    out->waiting = waiting;
+
+    portENTER_CRITICAL(&c->lock);
+    out->stats = c->stats;
+    if (reset) {
+        memset(&c->stats, 0, sizeof(c->stats));
+        c->stats.high_water = waiting;
+    }
+    portEXIT_CRITICAL(&c->lock);
+}
+
+// ================ QUEUE WRAPPER ================
+BaseType_t telemetry_queue_send(telemetry_queue_t* q, const void* item, TickType_t wait) {
+    uint8_t slot[TELEMETRY_QUEUE_MAX_ITEM];
+
+    stamp_item(q, slot, item);
+    if (xQueueSend(q->queue, slot, wait) != pdPASS) {
+        telemetry_record_failed(&q->counters,
+                                wait == 0 ? TELEMETRY_FAIL_FULL : TELEMETRY_FAIL_TIMEOUT);
+        return pdFAIL;
+    }
+
+    telemetry_record_sent(&q->counters, uxQueueMessagesWaiting(q->queue));
+    return pdPASS;
+}
+
+BaseType_t IRAM_ATTR telemetry_queue_send_from_isr(telemetry_queue_t* q, const void* item,
+                                                   BaseType_t* higher_priority_task_woken) {
+    uint8_t slot[TELEMETRY_QUEUE_MAX_ITEM];
+
+    stamp_item(q, slot, item);
+    if (xQueueSendFromISR(q->queue, slot, higher_priority_task_woken) != pdPASS) {
+        portENTER_CRITICAL_ISR(&q->counters.lock);
+        q->counters.stats.failed[TELEMETRY_FAIL_ISR_FULL]++;
+        portEXIT_CRITICAL_ISR(&q->counters.lock);
+        return pdFAIL;
+    }
+
+    UBaseType_t waiting = uxQueueMessagesWaitingFromISR(q->queue);
+    portENTER_CRITICAL_ISR(&q->counters.lock);
+    stats_sent(&q->counters.stats, waiting);
+    portEXIT_CRITICAL_ISR(&q->counters.lock);
+    return pdPASS;
+}
+
+BaseType_t telemetry_queue_receive(telemetry_queue_t* q, void* item, TickType_t wait) {
+    uint8_t slot[TELEMETRY_QUEUE_MAX_ITEM];
+    uint32_t sent_us;
+
+    if (xQueueReceive(q->queue, slot, wait) != pdPASS) {
+        return pdFAIL;
+    }
+    uint32_t latency = (uint32_t)esp_timer_get_time();
+    memcpy(&sent_us, slot + stamp_pos(q), sizeof(sent_us));
+    latency -= sent_us;
+    memcpy(item, slot, q->item_size);
+
+    telemetry_record_received(&q->counters, latency);
+    return pdPASS;
+}
+
+void telemetry_queue_snapshot(telemetry_queue_t* q, telemetry_snapshot_t* out, bool reset) {
+    telemetry_counters_snapshot(&q->counters, q->name, q->length,
+                                uxQueueMessagesWaiting(q->queue), out, reset);
+}
+
+uint32_t telemetry_latency_percentile_us(const telemetry_stats_t* stats, uint32_t pct) {
+    uint64_t target = ((uint64_t)stats->received * pct + 99) / 100;
+    uint64_t seen = 0;
+
+    if (stats->received == 0) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < TELEMETRY_LATENCY_BUCKETS - 1; i++) {
+        seen += stats->latency_hist[i];
+        if (seen >= target) {
+            return i == 0 ? 0 : (1u << i) - 1;
+        }
+    }
+    return stats->latency_max_us;
+}
+
+void telemetry_snapshot_log(const telemetry_snapshot_t* snap, const char* tag) {
+    const telemetry_stats_t* s = &snap->stats;
+    uint32_t avg_us = s->received ? (uint32_t)(s->latency_sum_us / s->received) : 0;
+
+    ESP_LOGI(tag, "  %-8s %lu/%lu hwm=%lu  in=%lu out=%lu  fail full/timeout/isr=%lu/%lu/%lu",
+             snap->name, snap->waiting, snap->length, s->high_water, s->sent, s->received,
+             s->failed[TELEMETRY_FAIL_FULL], s->failed[TELEMETRY_FAIL_TIMEOUT],
+             s->failed[TELEMETRY_FAIL_ISR_FULL]);
+    if (s->received > 0) {
+        ESP_LOGI(tag, "           latency avg=%.2f p50≤%.2f p99≤%.2f max=%.2f ms",
+                 avg_us / 1000.0f,
+                 telemetry_latency_percentile_us(s, 50) / 1000.0f,
+                 telemetry_latency_percentile_us(s, 99) / 1000.0f,
+                 s->latency_max_us / 1000.0f);
+    }
+}
@@ -0,0 +1,28 @@
+// components/timer_accuracy/include/timer_accuracy.h
+#ifndef TIMER_ACCURACY_H
+#define TIMER_ACCURACY_H
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+// Interval error of an auto-reload timer versus its programmed period.
+// Call timer_accuracy_update() first thing in the timer's callback; the
+// first call only records the start time.
+
+typedef struct {
+    int64_t last_us;
+    uint32_t samples;
+    uint64_t total_error_us;
+    uint32_t max_error_us;
+} timer_accuracy_t;
+
+void timer_accuracy_update(timer_accuracy_t* acc, TimerHandle_t timer);
+
+// Mean absolute interval error in milliseconds, 0 without samples
+float timer_accuracy_avg_ms(const timer_accuracy_t* acc);
+
+// One ESP_LOGI line: average and worst interval error
+void timer_accuracy_log(const char* tag, const char* name, const timer_accuracy_t* acc);
+
+#endif
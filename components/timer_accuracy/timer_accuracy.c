@@ -0,0 +1,30 @@
+// components/timer_accuracy/timer_accuracy.c
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "timer_accuracy.h"
+
+void timer_accuracy_update(timer_accuracy_t* acc, TimerHandle_t timer) {
+    int64_t now = esp_timer_get_time();
+
+    if (acc->last_us > 0) {
+        int64_t expected = (int64_t)pdTICKS_TO_MS(xTimerGetPeriod(timer)) * 1000;
+        int64_t error = (now - acc->last_us) - expected;
+        uint32_t abs_error = (uint32_t)(error < 0 ? -error : error);
+
+        acc->samples++;
+        acc->total_error_us += abs_error;
+        if (abs_error > acc->max_error_us) {
+            acc->max_error_us = abs_error;
+        }
+    }
+    acc->last_us = now;
+}
+
+float timer_accuracy_avg_ms(const timer_accuracy_t* acc) {
+    return acc->samples ? (float)acc->total_error_us / acc->samples / 1000.0f : 0.0f;
+}
+
+void timer_accuracy_log(const char* tag, const char* name, const timer_accuracy_t* acc) {
+    ESP_LOGI(tag, "  %-10s interval error: avg=%.2fms max=%.2fms (%lu samples)", name,
+             timer_accuracy_avg_ms(acc), acc->max_error_us / 1000.0f, acc->samples);
+}
@@ -0,0 +1,56 @@
+// components/timer_cmd/include/timer_cmd.h
+#ifndef TIMER_CMD_H
+#define TIMER_CMD_H
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+// Instrumented timer commands. The kernel's timer command queue is private,
+// so commands are sent through the timer_cmd_* wrappers, which count sends
+// and failures per command type. Next to the commands at most one probe
+// (xTimerPendFunctionCall) travels the same FIFO; when the service task runs
+// it, everything sent before it has executed and its age is the
+// enqueue-to-execution latency. in_flight is thus an upper bound on queue
+// occupancy - the safe side for sizing CONFIG_FREERTOS_TIMER_QUEUE_LENGTH.
+
+typedef enum {
+    TIMER_CMD_START = 0,
+    TIMER_CMD_STOP,
+    TIMER_CMD_RESET,
+    TIMER_CMD_CHANGE_PERIOD,
+    TIMER_CMD_DELETE,
+    TIMER_CMD_PROBE,
+    TIMER_CMD_TYPES
+} timer_cmd_type_t;
+
+typedef struct {
+    uint32_t sent[TIMER_CMD_TYPES];
+    uint32_t failed[TIMER_CMD_TYPES];
+    uint32_t in_flight;             // upper bound on current queue occupancy
+    uint32_t occupancy_hwm;
+    uint32_t latency_samples;
+    uint32_t latency_avg_us;
+    uint32_t latency_max_us;
+    uint32_t latency_last_us;
+} timer_cmd_snapshot_t;
+
+// Same semantics as xTimerStart / xTimerStop / ...
+BaseType_t timer_cmd_start(TimerHandle_t timer, TickType_t wait);
+BaseType_t timer_cmd_stop(TimerHandle_t timer, TickType_t wait);
+BaseType_t timer_cmd_reset(TimerHandle_t timer, TickType_t wait);
+BaseType_t timer_cmd_change_period(TimerHandle_t timer, TickType_t period, TickType_t wait);
+BaseType_t timer_cmd_delete(TimerHandle_t timer, TickType_t wait);
+
+// Consistent copy of the counters
+void timer_cmd_get_snapshot(timer_cmd_snapshot_t* out);
+
+uint32_t timer_cmd_in_flight(void);
+
+// Failed commands, not counting probes
+uint32_t timer_cmd_failures(const timer_cmd_snapshot_t* snap);
+
+// Occupancy, latency and per-type counts
+void timer_cmd_print_snapshot(const char* tag);
+
+#endif
@@ -0,0 +1,157 @@
+// components/timer_cmd/timer_cmd.c
+#include <stdbool.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "timer_cmd.h"
+
+static const char* timer_cmd_names[TIMER_CMD_TYPES] = {
+    "start", "stop", "reset", "change_period", "delete", "probe"
+};
+
+static portMUX_TYPE timer_cmd_lock = portMUX_INITIALIZER_UNLOCKED;
+static timer_cmd_snapshot_t timer_cmd_stats = {0};
+static uint64_t timer_cmd_latency_total_us = 0;
+static uint32_t timer_cmd_seq = 0;              // commands sent through wrappers
+static uint32_t timer_cmd_confirmed = 0;        // commands known to be executed
+static bool timer_cmd_probe_pending = false;
+
+// ================ PROBE ================
+// Runs in the timer service task: every command sent before it has executed
+static void timer_cmd_probe(void* seq, uint32_t enqueue_us) {
+    uint32_t latency_us = (uint32_t)esp_timer_get_time() - enqueue_us;
+
+    portENTER_CRITICAL(&timer_cmd_lock);
+    timer_cmd_confirmed = (uint32_t)(uintptr_t)seq;
+    timer_cmd_probe_pending = false;
+    timer_cmd_stats.in_flight = timer_cmd_seq - timer_cmd_confirmed;
+
+    timer_cmd_stats.latency_samples++;
+    timer_cmd_stats.latency_last_us = latency_us;
+    timer_cmd_latency_total_us += latency_us;
+    if (latency_us > timer_cmd_stats.latency_max_us) {
+        timer_cmd_stats.latency_max_us = latency_us;
+    }
+    portEXIT_CRITICAL(&timer_cmd_lock);
+}
+
+static void timer_cmd_account(timer_cmd_type_t type, BaseType_t result) {
+    bool send_probe = false;
+    uint32_t seq = 0;
+
+    portENTER_CRITICAL(&timer_cmd_lock);
+    if (result != pdPASS) {
+        timer_cmd_stats.failed[type]++;
+    } else {
+        timer_cmd_stats.sent[type]++;
+        timer_cmd_seq++;
+        timer_cmd_stats.in_flight = timer_cmd_seq - timer_cmd_confirmed +
+                                    (timer_cmd_probe_pending ? 1 : 0);
+        if (timer_cmd_stats.in_flight > timer_cmd_stats.occupancy_hwm) {
+            timer_cmd_stats.occupancy_hwm = timer_cmd_stats.in_flight;
+        }
+        if (!timer_cmd_probe_pending) {
+            timer_cmd_probe_pending = true;
+            send_probe = true;
+            seq = timer_cmd_seq;
+        }
+    }
+    portEXIT_CRITICAL(&timer_cmd_lock);
+
+    if (!send_probe) {
+        return;
+    }
+
+    // Never block on the probe; if the queue is full just skip this round
+    BaseType_t probed = xTimerPendFunctionCall(timer_cmd_probe, (void*)(uintptr_t)seq,
+                                               (uint32_t)esp_timer_get_time(), 0);
+
+    portENTER_CRITICAL(&timer_cmd_lock);
+    if (probed == pdPASS) {
+        timer_cmd_stats.sent[TIMER_CMD_PROBE]++;
+    } else {
+        timer_cmd_stats.failed[TIMER_CMD_PROBE]++;
+        timer_cmd_probe_pending = false;
+    }
+    portEXIT_CRITICAL(&timer_cmd_lock);
+}
+
+// ================ COMMANDS ================
+BaseType_t timer_cmd_start(TimerHandle_t timer, TickType_t wait) {
+    BaseType_t result = xTimerStart(timer, wait);
+    timer_cmd_account(TIMER_CMD_START, result);
+    return result;
+}
+
+BaseType_t timer_cmd_stop(TimerHandle_t timer, TickType_t wait) {
+    BaseType_t result = xTimerStop(timer, wait);
+    timer_cmd_account(TIMER_CMD_STOP, result);
+    return result;
+}
+
+BaseType_t timer_cmd_reset(TimerHandle_t timer, TickType_t wait) {
+    BaseType_t result = xTimerReset(timer, wait);
+    timer_cmd_account(TIMER_CMD_RESET, result);
+    return result;
+}
+
+BaseType_t timer_cmd_change_period(TimerHandle_t timer, TickType_t period, TickType_t wait) {
+    BaseType_t result = xTimerChangePeriod(timer, period, wait);
+    timer_cmd_account(TIMER_CMD_CHANGE_PERIOD, result);
+    return result;
+}
+
+BaseType_t timer_cmd_delete(TimerHandle_t timer, TickType_t wait) {
+    BaseType_t result = xTimerDelete(timer, wait);
+    timer_cmd_account(TIMER_CMD_DELETE, result);
+    return result;
+}
+
+// ================ SNAPSHOT ================
+void timer_cmd_get_snapshot(timer_cmd_snapshot_t* out) {
+    portENTER_CRITICAL(&timer_cmd_lock);
+    *out = timer_cmd_stats;
+    out->latency_avg_us = timer_cmd_stats.latency_samples ?
+        (uint32_t)(timer_cmd_latency_total_us / timer_cmd_stats.latency_samples) : 0;
+    portEXIT_CRITICAL(&timer_cmd_lock);
+}
+
+uint32_t timer_cmd_in_flight(void) {
+    portENTER_CRITICAL(&timer_cmd_lock);
+    uint32_t in_flight = timer_cmd_stats.in_flight;
+    portEXIT_CRITICAL(&timer_cmd_lock);
+    return in_flight;
+}
+
+uint32_t timer_cmd_failures(const timer_cmd_snapshot_t* snap) {
+    uint32_t failures = 0;
+
+    for (int i = 0; i < TIMER_CMD_PROBE; i++) {
+        failures += snap->failed[i];
+    }
+    return failures;
+}
+
+void timer_cmd_print_snapshot(const char* tag) {
+    timer_cmd_snapshot_t snap;
+    timer_cmd_get_snapshot(&snap);
+
+    ESP_LOGI(tag, "📨 Timer Command Queue:");
+    ESP_LOGI(tag, "  Occupancy: now<=%lu, high-water<=%lu (length %d)",
+             snap.in_flight, snap.occupancy_hwm,
+#ifdef CONFIG_FREERTOS_TIMER_QUEUE_LENGTH
+             (int)CONFIG_FREERTOS_TIMER_QUEUE_LENGTH
+#else
+             -1
+#endif
+    );
+    ESP_LOGI(tag, "  Latency: Avg=%luμs, Max=%luμs, Last=%luμs (%lu samples)",
+             snap.latency_avg_us, snap.latency_max_us, snap.latency_last_us,
+             snap.latency_samples);
+    for (int i = 0; i < TIMER_CMD_TYPES; i++) {
+        if (snap.sent[i] || snap.failed[i]) {
+            ESP_LOGI(tag, "  %-13s sent=%lu fail=%lu", timer_cmd_names[i],
+                     snap.sent[i], snap.failed[i]);
+        }
+    }
+}